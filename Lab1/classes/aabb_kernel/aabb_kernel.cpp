@@ -0,0 +1,395 @@
+/**
+ * @file aabb_kernel.cpp
+ * @brief AABBKernel class implementation file.
+ * @version 1.0.0 (2026-10-17)
+ * @date 2026-10-17
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#include "aabb_kernel.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "glm/glm.hpp"
+
+#if defined(__x86_64__)
+#define BGQ_OPENGL_AABB_X86 1
+#include <immintrin.h>
+#elif defined(__ARM_NEON)
+#define BGQ_OPENGL_AABB_NEON 1
+#include <arm_neon.h>
+#endif
+
+#include "structs/bounding_box/bounding_box.h"
+#include "structs/vertex/vertex.h"
+
+namespace bgq_opengl {
+
+	// The SIMD kernels load four floats starting at the position, so the normal.x
+	// that follows it is read too and then ignored. These make sure that read stays
+	// inside the vertex.
+	static_assert(offsetof(Vertex, position) == 0, "The position must be the first member of Vertex.");
+	static_assert(sizeof(Vertex) >= 4 * sizeof(float), "Vertex must hold at least four floats.");
+
+	namespace {
+
+		/**
+		 * @brief Computes a bounding box with the loop the kernels replaced.
+		 *
+		 * Kept only as the baseline of the benchmark.
+		 */
+		BoundingBox computeBranchy(const Vertex *vertices, size_t count) {
+
+			BoundingBox bb;
+			bb.min = vertices[0].position;
+			bb.max = vertices[0].position;
+
+			for (size_t i = 1; i < count; i++) {
+
+				if (bb.min.x > vertices[i].position.x)
+					bb.min.x = vertices[i].position.x;
+
+				if (bb.min.y > vertices[i].position.y)
+					bb.min.y = vertices[i].position.y;
+
+				if (bb.min.z > vertices[i].position.z)
+					bb.min.z = vertices[i].position.z;
+
+				if (bb.max.x < vertices[i].position.x)
+					bb.max.x = vertices[i].position.x;
+
+				if (bb.max.y < vertices[i].position.y)
+					bb.max.y = vertices[i].position.y;
+
+				if (bb.max.z < vertices[i].position.z)
+					bb.max.z = vertices[i].position.z;
+
+			}
+
+			return bb;
+
+		}
+
+		/**
+		 * @brief Builds the box returned for empty arrays.
+		 */
+		BoundingBox emptyBox() {
+
+			BoundingBox bb;
+			bb.min = glm::vec3(0.0f, 0.0f, 0.0f);
+			bb.max = glm::vec3(0.0f, 0.0f, 0.0f);
+
+			return bb;
+
+		}
+
+		/**
+		 * @brief Builds a box from the first three lanes stored from two SIMD registers.
+		 */
+		BoundingBox boxFromLanes(const float *min_lanes, const float *max_lanes) {
+
+			BoundingBox bb;
+			bb.min = glm::vec3(min_lanes[0], min_lanes[1], min_lanes[2]);
+			bb.max = glm::vec3(max_lanes[0], max_lanes[1], max_lanes[2]);
+
+			return bb;
+
+		}
+
+#if defined(BGQ_OPENGL_AABB_X86)
+
+		/**
+		 * @brief SSE kernel. One vertex per register, four accumulators.
+		 */
+		BoundingBox computeSSE(const Vertex *vertices, size_t count) {
+
+			const float *first = &vertices[0].position.x;
+			__m128 min0 = _mm_loadu_ps(first), max0 = min0;
+			__m128 min1 = min0, max1 = min0, min2 = min0, max2 = min0, min3 = min0, max3 = min0;
+
+			// Four independent chains so the min/max latency is hidden.
+			size_t i = 1;
+			for (; i + 4 <= count; i += 4) {
+
+				__m128 a = _mm_loadu_ps(&vertices[i].position.x);
+				__m128 b = _mm_loadu_ps(&vertices[i + 1].position.x);
+				__m128 c = _mm_loadu_ps(&vertices[i + 2].position.x);
+				__m128 d = _mm_loadu_ps(&vertices[i + 3].position.x);
+
+				min0 = _mm_min_ps(min0, a); max0 = _mm_max_ps(max0, a);
+				min1 = _mm_min_ps(min1, b); max1 = _mm_max_ps(max1, b);
+				min2 = _mm_min_ps(min2, c); max2 = _mm_max_ps(max2, c);
+				min3 = _mm_min_ps(min3, d); max3 = _mm_max_ps(max3, d);
+
+			}
+
+			// The remaining vertices.
+			for (; i < count; i++) {
+
+				__m128 a = _mm_loadu_ps(&vertices[i].position.x);
+				min0 = _mm_min_ps(min0, a); max0 = _mm_max_ps(max0, a);
+
+			}
+
+			// Join the accumulators.
+			min0 = _mm_min_ps(_mm_min_ps(min0, min1), _mm_min_ps(min2, min3));
+			max0 = _mm_max_ps(_mm_max_ps(max0, max1), _mm_max_ps(max2, max3));
+
+			float min_lanes[4], max_lanes[4];
+			_mm_storeu_ps(min_lanes, min0);
+			_mm_storeu_ps(max_lanes, max0);
+
+			return boxFromLanes(min_lanes, max_lanes);
+
+		}
+
+		/**
+		 * @brief AVX2 kernel. Two vertices per register, two accumulators.
+		 */
+		__attribute__((target("avx2")))
+		BoundingBox computeAVX2(const Vertex *vertices, size_t count) {
+
+			__m128 first = _mm_loadu_ps(&vertices[0].position.x);
+			__m256 min0 = _mm256_set_m128(first, first), max0 = min0;
+			__m256 min1 = min0, max1 = min0;
+
+			// Pack two vertices in each register.
+			size_t i = 1;
+			for (; i + 4 <= count; i += 4) {
+
+				__m256 a = _mm256_set_m128(_mm_loadu_ps(&vertices[i + 1].position.x), _mm_loadu_ps(&vertices[i].position.x));
+				__m256 b = _mm256_set_m128(_mm_loadu_ps(&vertices[i + 3].position.x), _mm_loadu_ps(&vertices[i + 2].position.x));
+
+				min0 = _mm256_min_ps(min0, a); max0 = _mm256_max_ps(max0, a);
+				min1 = _mm256_min_ps(min1, b); max1 = _mm256_max_ps(max1, b);
+
+			}
+
+			// Join the accumulators and fold the two halves.
+			min0 = _mm256_min_ps(min0, min1);
+			max0 = _mm256_max_ps(max0, max1);
+			__m128 min_half = _mm_min_ps(_mm256_castps256_ps128(min0), _mm256_extractf128_ps(min0, 1));
+			__m128 max_half = _mm_max_ps(_mm256_castps256_ps128(max0), _mm256_extractf128_ps(max0, 1));
+
+			// The remaining vertices.
+			for (; i < count; i++) {
+
+				__m128 a = _mm_loadu_ps(&vertices[i].position.x);
+				min_half = _mm_min_ps(min_half, a); max_half = _mm_max_ps(max_half, a);
+
+			}
+
+			float min_lanes[4], max_lanes[4];
+			_mm_storeu_ps(min_lanes, min_half);
+			_mm_storeu_ps(max_lanes, max_half);
+
+			return boxFromLanes(min_lanes, max_lanes);
+
+		}
+
+#elif defined(BGQ_OPENGL_AABB_NEON)
+
+		/**
+		 * @brief NEON kernel. One vertex per register, four accumulators.
+		 */
+		BoundingBox computeNEON(const Vertex *vertices, size_t count) {
+
+			float32x4_t min0 = vld1q_f32(&vertices[0].position.x), max0 = min0;
+			float32x4_t min1 = min0, max1 = min0, min2 = min0, max2 = min0, min3 = min0, max3 = min0;
+
+			// Four independent chains so the min/max latency is hidden.
+			size_t i = 1;
+			for (; i + 4 <= count; i += 4) {
+
+				float32x4_t a = vld1q_f32(&vertices[i].position.x);
+				float32x4_t b = vld1q_f32(&vertices[i + 1].position.x);
+				float32x4_t c = vld1q_f32(&vertices[i + 2].position.x);
+				float32x4_t d = vld1q_f32(&vertices[i + 3].position.x);
+
+				min0 = vminq_f32(min0, a); max0 = vmaxq_f32(max0, a);
+				min1 = vminq_f32(min1, b); max1 = vmaxq_f32(max1, b);
+				min2 = vminq_f32(min2, c); max2 = vmaxq_f32(max2, c);
+				min3 = vminq_f32(min3, d); max3 = vmaxq_f32(max3, d);
+
+			}
+
+			// The remaining vertices.
+			for (; i < count; i++) {
+
+				float32x4_t a = vld1q_f32(&vertices[i].position.x);
+				min0 = vminq_f32(min0, a); max0 = vmaxq_f32(max0, a);
+
+			}
+
+			// Join the accumulators.
+			min0 = vminq_f32(vminq_f32(min0, min1), vminq_f32(min2, min3));
+			max0 = vmaxq_f32(vmaxq_f32(max0, max1), vmaxq_f32(max2, max3));
+
+			float min_lanes[4], max_lanes[4];
+			vst1q_f32(min_lanes, min0);
+			vst1q_f32(max_lanes, max0);
+
+			return boxFromLanes(min_lanes, max_lanes);
+
+		}
+
+#endif
+
+	}  // namespace
+
+	void AABBKernel::benchmark() {
+
+		const size_t sizes[] = {10000, 100000, 1000000, 10000000};
+
+		// The same random positions every run, so runs can be compared.
+		std::vector<Vertex> vertices(sizes[3]);
+		std::mt19937 random(1234);
+		std::uniform_real_distribution<float> coordinate(-100.0f, 100.0f);
+		for (Vertex &vertex : vertices)
+			vertex.position = glm::vec3(coordinate(random), coordinate(random), coordinate(random));
+
+		std::cout << "AABB kernel: " << AABBKernel::getKernelName() << std::endl;
+		std::cout << std::setw(10) << "vertices" << std::setw(14) << "branchy (us)" << std::setw(14) << "kernel (us)" << std::setw(10) << "speedup" << "  match" << std::endl;
+
+		for (size_t count : sizes) {
+
+			// Repeat the small sizes so each one runs for about as long.
+			int repetitions = (int) std::max<size_t>(1, sizes[3] / count);
+
+			// Called through a volatile pointer, so no call is inlined or skipped.
+			auto time = [&](KernelFunction function, BoundingBox *box) {
+
+				KernelFunction volatile kernel = function;
+				*box = kernel(vertices.data(), count);
+
+				auto start = std::chrono::steady_clock::now();
+				for (int i = 0; i < repetitions; i++)
+					*box = kernel(vertices.data(), count);
+				auto end = std::chrono::steady_clock::now();
+
+				return std::chrono::duration<double, std::micro>(end - start).count() / repetitions;
+
+			};
+
+			BoundingBox expected;
+			BoundingBox box;
+			double branchy_time = time(computeBranchy, &expected);
+			double kernel_time = time(AABBKernel::compute, &box);
+			bool match = box.min == expected.min && box.max == expected.max;
+
+			std::cout << std::fixed << std::setprecision(1);
+			std::cout << std::setw(10) << count << std::setw(14) << branchy_time << std::setw(14) << kernel_time
+				<< std::setw(9) << branchy_time / kernel_time << "x" << (match ? "  yes" : "  NO") << std::endl;
+			std::cout << std::defaultfloat;
+
+		}
+
+	}
+
+	BoundingBox AABBKernel::compute(const Vertex *vertices, size_t count) {
+
+		// Resolve the kernel only once.
+		static const char *name = nullptr;
+		static const KernelFunction kernel = selectKernel(&name);
+
+		if (count == 0)
+			return emptyBox();
+
+		return kernel(vertices, count);
+
+	}
+
+	BoundingBox AABBKernel::compute(const std::vector<Vertex> &vertices) {
+
+		return compute(vertices.data(), vertices.size());
+
+	}
+
+	BoundingBox AABBKernel::computeScalar(const Vertex *vertices, size_t count) {
+
+		if (count == 0)
+			return emptyBox();
+
+		// Init the bounding box with the first vertex.
+		glm::vec3 min = vertices[0].position;
+		glm::vec3 max = vertices[0].position;
+
+		// Loop through the vertices and get the min and max values.
+		for (size_t i = 1; i < count; i++) {
+
+			min = glm::min(min, vertices[i].position);
+			max = glm::max(max, vertices[i].position);
+
+		}
+
+		BoundingBox bb;
+		bb.min = min;
+		bb.max = max;
+
+		return bb;
+
+	}
+
+	const char* AABBKernel::getKernelName() {
+
+		const char *name = "Scalar";
+		selectKernel(&name);
+
+		return name;
+
+	}
+
+	BoundingBox AABBKernel::merge(const BoundingBox &a, const BoundingBox &b) {
+
+		BoundingBox bb;
+		bb.min = glm::min(a.min, b.min);
+		bb.max = glm::max(a.max, b.max);
+
+		return bb;
+
+	}
+
+	AABBKernel::KernelFunction AABBKernel::selectKernel(const char **name) {
+
+#if defined(BGQ_OPENGL_AABB_X86)
+
+		// SSE2 is always there on x86-64, AVX2 has to be asked for.
+		if (__builtin_cpu_supports("avx2")) {
+
+			*name = "AVX2";
+			return computeAVX2;
+
+		}
+
+		*name = "SSE";
+		return computeSSE;
+
+#elif defined(BGQ_OPENGL_AABB_NEON)
+
+		// NEON is always there on arm64.
+		*name = "NEON";
+		return computeNEON;
+
+#else
+
+		*name = "Scalar";
+		return computeScalar;
+
+#endif
+
+	}
+
+}  // namespace bgq_opengl
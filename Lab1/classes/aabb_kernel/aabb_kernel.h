@@ -0,0 +1,130 @@
+/**
+ * @file aabb_kernel.h
+ * @brief AABBKernel class header file.
+ * @version 1.0.0 (2026-10-17)
+ * @date 2026-10-17
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#ifndef BGQ_OPENGL_CLASSES_AABB_KERNEL_H_
+#define BGQ_OPENGL_CLASSES_AABB_KERNEL_H_
+
+#include <cstddef>
+#include <vector>
+
+#include "structs/bounding_box/bounding_box.h"
+#include "structs/vertex/vertex.h"
+
+namespace bgq_opengl {
+
+	/**
+	 * @brief Implements the bounding box reduction kernels.
+	 *
+	 * Implements a min/max reduction over the positions of an array of vertices.
+	 * The best implementation available on the running CPU (AVX2, SSE, NEON or
+	 * plain scalar code) is chosen the first time it is used.
+	 *
+	 * @author Borja García Quiroga <garcaqub@tcd.ie>
+	 */
+	class AABBKernel {
+
+		public:
+
+			/**
+			 * @brief Runs the benchmark of the kernels.
+			 *
+			 * Times the kernel in use against the branchy scalar loop it replaced
+			 * on 10k, 100k, 1M and 10M random vertices, checks they get the same
+			 * box and prints a table with the time per call.
+			 */
+			static void benchmark();
+
+			/**
+			 * @brief Computes the bounding box of some vertices.
+			 *
+			 * Computes the bounding box of the vertex positions using the fastest
+			 * kernel available.
+			 *
+			 * @param vertices The vertices.
+			 * @param count The number of vertices.
+			 *
+			 * @returns The bounding box. Zero sized if there are no vertices.
+			 */
+			static BoundingBox compute(const Vertex *vertices, size_t count);
+
+			/**
+			 * @brief Computes the bounding box of some vertices.
+			 *
+			 * Computes the bounding box of the vertex positions using the fastest
+			 * kernel available.
+			 *
+			 * @param vertices The vertices.
+			 *
+			 * @returns The bounding box. Zero sized if there are no vertices.
+			 */
+			static BoundingBox compute(const std::vector<Vertex> &vertices);
+
+			/**
+			 * @brief Computes the bounding box of some vertices without SIMD.
+			 *
+			 * Computes the bounding box of the vertex positions with the scalar
+			 * kernel. Used as a fallback and as a reference.
+			 *
+			 * @param vertices The vertices.
+			 * @param count The number of vertices.
+			 *
+			 * @returns The bounding box. Zero sized if there are no vertices.
+			 */
+			static BoundingBox computeScalar(const Vertex *vertices, size_t count);
+
+			/**
+			 * @brief Gets the name of the kernel in use.
+			 *
+			 * Gets the name of the kernel that compute() dispatches to.
+			 *
+			 * @returns The name of the kernel.
+			 */
+			static const char* getKernelName();
+
+			/**
+			 * @brief Merges two bounding boxes.
+			 *
+			 * Gets the smallest box that contains both boxes.
+			 *
+			 * @param a The first box.
+			 * @param b The second box.
+			 *
+			 * @returns The merged box.
+			 */
+			static BoundingBox merge(const BoundingBox &a, const BoundingBox &b);
+
+		private:
+
+			/**
+			 * @brief Signature shared by all the kernels.
+			 */
+			typedef BoundingBox (*KernelFunction)(const Vertex *vertices, size_t count);
+
+			/**
+			 * @brief Picks the kernel for this CPU.
+			 *
+			 * Picks the kernel for this CPU. It only checks the CPU once.
+			 *
+			 * @param name Outputs the name of the kernel.
+			 *
+			 * @returns The kernel.
+			 */
+			static KernelFunction selectKernel(const char **name);
+
+	};
+
+}  // namespace bgq_opengl
+
+#endif  //!BGQ_OPENGL_CLASSES_AABB_KERNEL_H_
@@ -0,0 +1,162 @@
+/**
+ * @file async_loader.cpp
+ * @brief AsyncLoader class implementation file.
+ * @version 1.0.0 (2026-10-17)
+ * @date 2026-10-17
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#include "async_loader.h"
+
+#include <chrono>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+namespace bgq_opengl {
+
+	AsyncLoader::AsyncLoader(unsigned int workers) {
+
+		// Leave a core for the render thread.
+		if (workers == 0) {
+
+			unsigned int cores = std::thread::hardware_concurrency();
+			workers = cores > 1 ? cores - 1 : 1;
+
+		}
+
+		for (unsigned int i = 0; i < workers; i++)
+			this->workers.emplace_back(&AsyncLoader::work, this);
+
+	}
+
+	AsyncLoader::~AsyncLoader() {
+
+		this->stop();
+
+	}
+
+	size_t AsyncLoader::getPendingCount() const {
+
+		std::lock_guard<std::mutex> lock(this->mutex);
+		return this->jobs.size() + this->running + this->uploads.size();
+
+	}
+
+	size_t AsyncLoader::processUploads(double budget_ms) {
+
+		auto start = std::chrono::steady_clock::now();
+		size_t count = 0;
+
+		while (true) {
+
+			// Take the next upload, if any.
+			std::function<void()> upload;
+			{
+
+				std::lock_guard<std::mutex> lock(this->mutex);
+				if (this->uploads.empty())
+					break;
+
+				upload = std::move(this->uploads.front());
+				this->uploads.pop_front();
+
+			}
+
+			// Run it without the lock, as it may queue more.
+			upload();
+			count++;
+
+			// Stop once the budget is spent.
+			std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+			if (elapsed.count() >= budget_ms)
+				break;
+
+		}
+
+		return count;
+
+	}
+
+	void AsyncLoader::run(std::function<void()> work) {
+
+		{
+
+			std::lock_guard<std::mutex> lock(this->mutex);
+			this->jobs.push_back(std::move(work));
+
+		}
+
+		this->condition.notify_one();
+
+	}
+
+	void AsyncLoader::stop() {
+
+		{
+
+			std::lock_guard<std::mutex> lock(this->mutex);
+			if (this->stopping)
+				return;
+
+			this->stopping = true;
+
+		}
+
+		// Wait for the running work.
+		this->condition.notify_all();
+		for (std::thread &worker : this->workers)
+			worker.join();
+
+		this->workers.clear();
+
+		// Drop the rest here, on the render thread.
+		this->jobs.clear();
+		this->uploads.clear();
+
+	}
+
+	void AsyncLoader::upload(std::function<void()> upload) {
+
+		std::lock_guard<std::mutex> lock(this->mutex);
+		this->uploads.push_back(std::move(upload));
+
+	}
+
+	void AsyncLoader::work() {
+
+		std::unique_lock<std::mutex> lock(this->mutex);
+
+		while (true) {
+
+			// Sleep until there is work or the loader stops.
+			this->condition.wait(lock, [this]() { return this->stopping || !this->jobs.empty(); });
+			if (this->stopping)
+				return;
+
+			std::function<void()> job = std::move(this->jobs.front());
+			this->jobs.pop_front();
+			this->running++;
+
+			// Run it without the lock.
+			lock.unlock();
+			job();
+			job = nullptr;
+			lock.lock();
+
+			this->running--;
+
+		}
+
+	}
+
+}  // namespace bgq_opengl
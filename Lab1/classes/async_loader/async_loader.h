@@ -0,0 +1,139 @@
+/**
+ * @file async_loader.h
+ * @brief AsyncLoader class header file.
+ * @version 1.0.0 (2026-10-17)
+ * @date 2026-10-17
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#ifndef BGQ_OPENGL_CLASSES_ASYNC_LOADER_H_
+#define BGQ_OPENGL_CLASSES_ASYNC_LOADER_H_
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace bgq_opengl {
+
+	/**
+	 * @brief Implements a loader running work off the render thread.
+	 *
+	 * Implements a pool of worker threads for the slow part of loading, such as
+	 * parsing models and decoding images, and a queue of uploads that have to
+	 * run on the thread owning the OpenGL context. The render thread runs the
+	 * uploads a few at a time, within a time budget per frame, so the window
+	 * stays responsive while the scene comes in.
+	 *
+	 * Work running on the workers must never own OpenGL objects, as the last
+	 * reference to one would delete it from the wrong thread. It should only
+	 * hold weak references to them and let the uploads lock them.
+	 *
+	 * @author Borja García Quiroga <garcaqub@tcd.ie>
+	 */
+	class AsyncLoader {
+
+		public:
+
+			/**
+			 * @brief Starts the workers.
+			 *
+			 * Starts the worker threads.
+			 *
+			 * @param workers Number of workers. 0 for one per core but one.
+			 */
+			AsyncLoader(unsigned int workers = 0);
+
+			/**
+			 * @brief Stops the workers.
+			 *
+			 * Stops the workers. Work and uploads not started are dropped.
+			 */
+			~AsyncLoader();
+
+			// The workers point to this loader, so it cannot be copied or moved.
+			AsyncLoader(const AsyncLoader&) = delete;
+			AsyncLoader& operator=(const AsyncLoader&) = delete;
+
+			/**
+			 * @brief Get the number of unfinished tasks.
+			 *
+			 * Get the number of queued or running work and queued uploads.
+			 *
+			 * @returns The number of unfinished tasks.
+			 */
+			size_t getPendingCount() const;
+
+			/**
+			 * @brief Runs the uploads that fit in a budget.
+			 *
+			 * Runs queued uploads in order until the budget is spent. At least
+			 * one is run, so loading always progresses. Has to be called from the
+			 * thread owning the OpenGL context, usually once per frame.
+			 *
+			 * @param budget_ms The time budget in milliseconds.
+			 *
+			 * @returns The number of uploads run.
+			 */
+			size_t processUploads(double budget_ms);
+
+			/**
+			 * @brief Runs some work on a worker.
+			 *
+			 * Queues a function to be run on any of the workers.
+			 *
+			 * @param work The function.
+			 */
+			void run(std::function<void()> work);
+
+			/**
+			 * @brief Stops the workers.
+			 *
+			 * Waits for the running work to finish and drops everything else.
+			 * Has to be called while the OpenGL context is alive, as the dropped
+			 * uploads may free OpenGL objects.
+			 */
+			void stop();
+
+			/**
+			 * @brief Queues an upload.
+			 *
+			 * Queues a function to be run on the thread owning the OpenGL
+			 * context by processUploads. Can be called from any thread.
+			 *
+			 * @param upload The function.
+			 */
+			void upload(std::function<void()> upload);
+
+		private:
+
+			/**
+			 * @brief Runs the work of a worker.
+			 *
+			 * Takes work from the queue and runs it until the loader stops.
+			 */
+			void work();
+
+			std::vector<std::thread> workers;				/// The worker threads.
+			std::deque<std::function<void()>> jobs;			/// Work waiting for a worker.
+			std::deque<std::function<void()>> uploads;		/// Uploads waiting for the render thread.
+			mutable std::mutex mutex;						/// Guards the queues and counters.
+			std::condition_variable condition;				/// Wakes the workers up.
+			size_t running = 0;								/// Work being run right now.
+			bool stopping = false;							/// Whether the workers have to stop.
+
+	};
+
+}  // namespace bgq_opengl
+
+#endif  //!BGQ_OPENGL_CLASSES_ASYNC_LOADER_H_
@@ -0,0 +1,238 @@
+/**
+ * @file bvh.cpp
+ * @brief BVH class implementation file.
+ * @version 1.0.0 (2026-10-17)
+ * @date 2026-10-17
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#include "bvh.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "glm/glm.hpp"
+
+#include "classes/aabb_kernel/aabb_kernel.h"
+#include "classes/frustum/frustum.h"
+#include "structs/bounding_box/bounding_box.h"
+#include "structs/cull_stats/cull_stats.h"
+
+namespace bgq_opengl {
+
+	namespace {
+
+		/**
+		 * @brief Gets the surface area of a box.
+		 */
+		float getArea(const BoundingBox &box) {
+
+			glm::vec3 size = box.max - box.min;
+			return 2.0f * (size.x * size.y + size.y * size.z + size.z * size.x);
+
+		}
+
+	}  // namespace
+
+	void BVH::cull(const Frustum &frustum, std::vector<size_t> &visible, CullStats *stats) const {
+
+		CullStats counts;
+
+		if (!this->nodes.empty()) {
+
+			// Walk the tree with a stack, as it is not deep enough to need more.
+			uint32_t stack[64];
+			int top = 0;
+			stack[top++] = 0;
+
+			while (top > 0) {
+
+				const Node &node = this->nodes[stack[--top]];
+				int result = frustum.classify(node.box);
+				counts.tested++;
+
+				if (result == Frustum::outside) {
+
+					counts.culled += node.count;
+
+				} else if (result == Frustum::inside) {
+
+					this->collect(node, visible);
+					counts.drawn += node.count;
+
+				} else if (node.left == 0) {
+
+					// A leaf crossing a plane, so test its items one by one.
+					for (uint32_t i = node.first; i < node.first + node.count; i++) {
+
+						counts.tested++;
+						if (frustum.classify(this->item_boxes[this->items[i]]) == Frustum::outside) {
+
+							counts.culled++;
+
+						} else {
+
+							visible.push_back(this->items[i]);
+							counts.drawn++;
+
+						}
+
+					}
+
+				} else {
+
+					stack[top++] = node.right;
+					stack[top++] = node.left;
+
+				}
+
+			}
+
+		}
+
+		if (stats) {
+
+			stats->tested += counts.tested;
+			stats->culled += counts.culled;
+			stats->drawn += counts.drawn;
+
+		}
+
+	}
+
+	void BVH::update(std::span<const BoundingBox> boxes) {
+
+		this->item_boxes.assign(boxes.begin(), boxes.end());
+
+		if (boxes.size() != this->items.size()) {
+
+			this->build(boxes);
+			return;
+
+		}
+
+		// Moving items make the refitted boxes overlap more and more.
+		this->refit(boxes);
+		if (this->getTotalArea() > this->built_area * BVH::rebuild_ratio)
+			this->build(boxes);
+
+	}
+
+	void BVH::build(std::span<const BoundingBox> boxes) {
+
+		this->nodes.clear();
+		this->items.resize(boxes.size());
+		for (size_t i = 0; i < boxes.size(); i++)
+			this->items[i] = (uint32_t) i;
+
+		if (!boxes.empty()) {
+
+			// A full binary tree has less than twice as many nodes as leaves.
+			this->nodes.reserve(2 * (boxes.size() / BVH::max_leaf_items + 1));
+			this->buildNode(boxes, 0, (uint32_t) boxes.size());
+
+		}
+
+		this->built_area = this->getTotalArea();
+
+	}
+
+	uint32_t BVH::buildNode(std::span<const BoundingBox> boxes, uint32_t first, uint32_t count) {
+
+		uint32_t index = (uint32_t) this->nodes.size();
+		this->nodes.push_back(Node());
+		this->nodes[index].first = first;
+		this->nodes[index].count = count;
+
+		// Get the box of the items and the one of their centres.
+		BoundingBox box = boxes[this->items[first]];
+		glm::vec3 centre = (box.min + box.max) * 0.5f;
+		BoundingBox centres { centre, centre };
+
+		for (uint32_t i = first + 1; i < first + count; i++) {
+
+			const BoundingBox &item_box = boxes[this->items[i]];
+			centre = (item_box.min + item_box.max) * 0.5f;
+
+			box = AABBKernel::merge(box, item_box);
+			centres.min = glm::min(centres.min, centre);
+			centres.max = glm::max(centres.max, centre);
+
+		}
+
+		this->nodes[index].box = box;
+
+		if (count <= BVH::max_leaf_items)
+			return index;
+
+		// Split at the median of the longest axis of the centres.
+		glm::vec3 size = centres.max - centres.min;
+		int axis = size.x > size.y ? (size.x > size.z ? 0 : 2) : (size.y > size.z ? 1 : 2);
+		uint32_t half = count / 2;
+
+		std::nth_element(this->items.begin() + first, this->items.begin() + first + half, this->items.begin() + first + count, [&](uint32_t a, uint32_t b) {
+
+			return boxes[a].min[axis] + boxes[a].max[axis] < boxes[b].min[axis] + boxes[b].max[axis];
+
+		});
+
+		// The vector may grow, so do not hold references to the node.
+		uint32_t left = this->buildNode(boxes, first, half);
+		uint32_t right = this->buildNode(boxes, first + half, count - half);
+		this->nodes[index].left = left;
+		this->nodes[index].right = right;
+
+		return index;
+
+	}
+
+	void BVH::collect(const Node &node, std::vector<size_t> &visible) const {
+
+		visible.insert(visible.end(), this->items.begin() + node.first, this->items.begin() + node.first + node.count);
+
+	}
+
+	float BVH::getTotalArea() const {
+
+		float area = 0.0f;
+		for (const Node &node : this->nodes)
+			area += getArea(node.box);
+
+		return area;
+
+	}
+
+	void BVH::refit(std::span<const BoundingBox> boxes) {
+
+		// Children come after their parents, so go backwards.
+		for (size_t i = this->nodes.size(); i-- > 0;) {
+
+			Node &node = this->nodes[i];
+
+			if (node.left == 0) {
+
+				node.box = boxes[this->items[node.first]];
+				for (uint32_t j = node.first + 1; j < node.first + node.count; j++)
+					node.box = AABBKernel::merge(node.box, boxes[this->items[j]]);
+
+			} else {
+
+				node.box = AABBKernel::merge(this->nodes[node.left].box, this->nodes[node.right].box);
+
+			}
+
+		}
+
+	}
+
+}  // namespace bgq_opengl
@@ -0,0 +1,136 @@
+/**
+ * @file bvh.h
+ * @brief BVH class header file.
+ * @version 1.0.0 (2026-10-17)
+ * @date 2026-10-17
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#ifndef BGQ_OPENGL_CLASSES_BVH_H_
+#define BGQ_OPENGL_CLASSES_BVH_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "classes/frustum/frustum.h"
+#include "structs/bounding_box/bounding_box.h"
+#include "structs/cull_stats/cull_stats.h"
+
+namespace bgq_opengl {
+
+	/**
+	 * @brief Implements a bounding volume hierarchy.
+	 *
+	 * Implements a binary tree of boxes over a list of items, split at the
+	 * median of the longest axis. The items move every frame, so the tree is
+	 * refitted to the new boxes while that keeps it tight, and only built again
+	 * when the number of items changes or the refitted boxes grow too much.
+	 *
+	 * @author Borja García Quiroga <garcaqub@tcd.ie>
+	 */
+	class BVH {
+
+		public:
+
+			/**
+			 * @brief Gets the items inside a frustum.
+			 *
+			 * Walks the tree and outputs the items whose box is not fully outside
+			 * the frustum. The items of a node fully inside it are taken without
+			 * testing them.
+			 *
+			 * @param frustum The frustum.
+			 * @param visible Outputs the indices of the visible items, in no order.
+			 * @param stats Adds the boxes tested and the items culled and kept. Can be null.
+			 */
+			void cull(const Frustum &frustum, std::vector<size_t> &visible, CullStats *stats) const;
+
+			/**
+			 * @brief Updates the tree to the boxes of the items.
+			 *
+			 * Refits the tree to the boxes, or builds it again if the number of
+			 * items changed or refitting made it too loose.
+			 *
+			 * @param boxes The box of each item.
+			 */
+			void update(std::span<const BoundingBox> boxes);
+
+			static constexpr float rebuild_ratio = 2.0f;	/// Growth of the summed node areas over the last build that triggers a new one.
+			static const uint32_t max_leaf_items = 4;		/// Items a leaf holds at most.
+
+		private:
+
+			/**
+			 * @brief A node of the tree.
+			 */
+			struct Node {
+
+				BoundingBox box;		/// Box of everything below.
+				uint32_t first = 0;		/// First item below, in the item list.
+				uint32_t count = 0;		/// Items below.
+				uint32_t left = 0;		/// Left child, 0 for leaves.
+				uint32_t right = 0;		/// Right child, 0 for leaves.
+
+			};
+
+			/**
+			 * @brief Builds the tree from scratch.
+			 *
+			 * @param boxes The box of each item.
+			 */
+			void build(std::span<const BoundingBox> boxes);
+
+			/**
+			 * @brief Builds the node for some items.
+			 *
+			 * Creates the node, splits the items and recurses on both halves.
+			 *
+			 * @param boxes The box of each item.
+			 * @param first First position of the items in the item list.
+			 * @param count Number of items.
+			 *
+			 * @returns The index of the node.
+			 */
+			uint32_t buildNode(std::span<const BoundingBox> boxes, uint32_t first, uint32_t count);
+
+			/**
+			 * @brief Adds the items below a node.
+			 *
+			 * @param node The node.
+			 * @param visible Outputs the indices of the items.
+			 */
+			void collect(const Node &node, std::vector<size_t> &visible) const;
+
+			/**
+			 * @brief Sums the areas of the node boxes.
+			 *
+			 * @returns The summed surface area.
+			 */
+			float getTotalArea() const;
+
+			/**
+			 * @brief Refits the node boxes to the boxes of the items.
+			 *
+			 * @param boxes The box of each item.
+			 */
+			void refit(std::span<const BoundingBox> boxes);
+
+			std::vector<Node> nodes;				/// Nodes, the root first and every child after its parent.
+			std::vector<uint32_t> items;			/// Item indices, the ones below each node in a run.
+			std::vector<BoundingBox> item_boxes;	/// Box of each item from the last update.
+			float built_area = 0.0f;				/// Summed node areas right after the last build.
+
+	};
+
+}  // namespace bgq_opengl
+
+#endif  //!BGQ_OPENGL_CLASSES_BVH_H_
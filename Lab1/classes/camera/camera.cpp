@@ -40,47 +40,57 @@ namespace bgq_opengl {
 	
 	}
 
-	glm::mat4 Camera::getCameraMatrix() {
+	const glm::mat4& Camera::getCameraMatrix() {
 
-        return this->getProjection() * this->getView();
+        this->updateMatrices();
+        return this->view_projection;
 
 	}
 
-	glm::vec3 Camera::getDirection() {
+	const glm::vec3& Camera::getDirection() {
 
-        return glm::normalize(glm::vec3(transforms * glm::vec4(this->direction, 1.0)));
+        this->updateMatrices();
+        return this->cached_direction;
 
 	}
 
-	glm::vec3 Camera::getPosition() {
+	const glm::vec3& Camera::getPosition() {
 
-        return glm::vec3(transforms * glm::vec4(this->position, 1.0));
+        this->updateMatrices();
+        return this->cached_position;
 
 	}
 
-	glm::mat4 Camera::getProjection() {
+	const glm::mat4& Camera::getProjection() {
         
-        // Adds perspective to the scene.
-        float ratio = (float)this->window_width / this->window_height;
-        return glm::perspective(glm::radians(this->fov), ratio, this->near, this->far);
+        this->updateMatrices();
+        return this->projection;
 
 	}
 
-	glm::vec3 Camera::getUp() {
+	const glm::vec3& Camera::getUp() {
 
-		return glm::normalize(glm::vec3(transforms * glm::vec4(this->up, 1.0)));
+        this->updateMatrices();
+        return this->cached_up;
 
 	}
 
-	glm::mat4 Camera::getView() {
-        
-        // Get the position and direction.
-        glm::vec3 position = this->getPosition();
-        glm::vec3 direction = this->getDirection();
-        glm::vec3 up = this->getUp();
+	int Camera::getHeight() const {
+
+		return this->window_height;
+
+	}
+
+	uint64_t Camera::getVersion() const {
+
+		return this->version;
+
+	}
+
+	const glm::mat4& Camera::getView() {
         
-        // Calculate the view matrix.
-        return glm::lookAt(position, position + direction, up);
+        this->updateMatrices();
+        return this->view;
 
 	}
 
@@ -178,6 +188,7 @@ namespace bgq_opengl {
     void Camera::resetTransforms() {
 
         this->transforms = glm::mat4(1.0f);
+        this->invalidateView();
 
     }
 
@@ -191,6 +202,7 @@ namespace bgq_opengl {
         glm::mat4 rotation_matrix = glm::rotate(identity_matrix, radians, glm::vec3(x, y, z));
 
         this->transforms = rotation_matrix * this->transforms;
+        this->invalidateView();
 
     }
 
@@ -201,6 +213,7 @@ namespace bgq_opengl {
 
         // Apply it to the transormations.
         this->transforms = trans_matrix * this->transforms;
+        this->invalidateView();
 
     }
 
@@ -213,7 +226,61 @@ namespace bgq_opengl {
     void Camera::setTransformMat(glm::mat4 transform) {
         
         this->transforms = transform;
+        this->invalidateView();
         
     }
 
+    void Camera::setViewport(int width, int height) {
+
+        this->window_width = width;
+        this->window_height = height;
+        this->invalidateProjection();
+
+    }
+
+    void Camera::invalidateProjection() {
+
+        this->projection_dirty = true;
+        this->version++;
+
+    }
+
+    void Camera::invalidateView() {
+
+        this->view_dirty = true;
+        this->version++;
+
+    }
+
+    void Camera::updateMatrices() {
+
+        if (!this->view_dirty && !this->projection_dirty)
+            return;
+
+        if (this->view_dirty) {
+
+            // Get the position and direction.
+            this->cached_position = glm::vec3(this->transforms * glm::vec4(this->position, 1.0));
+            this->cached_direction = glm::normalize(glm::vec3(this->transforms * glm::vec4(this->direction, 1.0)));
+            this->cached_up = glm::normalize(glm::vec3(this->transforms * glm::vec4(this->up, 1.0)));
+
+            // Calculate the view matrix.
+            this->view = glm::lookAt(this->cached_position, this->cached_position + this->cached_direction, this->cached_up);
+            this->view_dirty = false;
+
+        }
+
+        if (this->projection_dirty) {
+
+            // Adds perspective to the scene.
+            float ratio = (float)this->window_width / this->window_height;
+            this->projection = glm::perspective(glm::radians(this->fov), ratio, this->near, this->far);
+            this->projection_dirty = false;
+
+        }
+
+        this->view_projection = this->projection * this->view;
+
+    }
+
 }  // namespace bgq_opengl
@@ -16,6 +16,8 @@
 #ifndef BGQ_OPENGL_CLASSES_CAMERA_H_
 #define BGQ_OPENGL_CLASSES_CAMERA_H_
 
+#include <cstdint>
+
 #include "glm/glm.hpp"
 
 namespace bgq_opengl {
@@ -25,6 +27,10 @@ namespace bgq_opengl {
 	 * 
 	 * Implements a camera class to handle the POV of OpenGL as well as the interactions
 	 * with the window.
+	 *
+	 * The view and projection matrices are cached and only rebuilt after the
+	 * camera changes. Every change bumps a version number that other caches can
+	 * compare against.
 	 * 
 	 * @author Borja García Quiroga <garcaqub@tcd.ie>
 	 */
@@ -50,44 +56,63 @@ namespace bgq_opengl {
 			/**
 			 * @brief Get the camera matrix.
 			 *
-			 * Get the camera matrix.
+			 * Get the camera matrix (projection * view).
 			 */
-			glm::mat4 getCameraMatrix();
+			const glm::mat4& getCameraMatrix();
 
 			/**
 			 * @brief Get the camera direction.
 			 * 
 			 * Get the camera direction.
 			 */
-			glm::vec3 getDirection();
+			const glm::vec3& getDirection();
+
+			/**
+			 * @brief Get the viewport height.
+			 *
+			 * Get the height of the viewport in pixels.
+			 *
+			 * @returns The height.
+			 */
+			int getHeight() const;
 
 			/**
 			 * @brief Get the camera position.
 			 *
 			 * Get the camera position.
 			 */
-			glm::vec3 getPosition();
+			const glm::vec3& getPosition();
 
 			/**
 			 * @brief Get the projection matrix.
 			 * 
 			 * Get the projection matrix corresponding to this camera.
 			 */
-			glm::mat4 getProjection();
+			const glm::mat4& getProjection();
 
 			/**
 			 * @brief Get the camera up vector.
 			 *
 			 * Get the camera up vector.
 			 */
-			glm::vec3 getUp();
+			const glm::vec3& getUp();
+
+			/**
+			 * @brief Get the version of the matrices.
+			 *
+			 * Get a number that changes every time the view or the projection
+			 * change, so other caches know when to update.
+			 *
+			 * @returns The version.
+			 */
+			uint64_t getVersion() const;
 
 			/**
 			 * @brief Get the view matrix.
 			 * 
 			 * Get the view matrix corresponding to this camera.
 			 */
-			glm::mat4 getView();
+			const glm::mat4& getView();
 
 			/**
 			 * @brief Move tha camera backwards.
@@ -207,8 +232,39 @@ namespace bgq_opengl {
              */
             void setTransformMat(glm::mat4 transform);
 
+			/**
+			 * @brief Set the viewport size.
+			 *
+			 * Set the size of the viewport, which changes the aspect ratio.
+			 *
+			 * @param width The viewport width.
+			 * @param height The viewport height.
+			 */
+			void setViewport(int width, int height);
+
 		private:
 
+			/**
+			 * @brief Marks the projection as outdated.
+			 *
+			 * Marks the projection as outdated and bumps the version.
+			 */
+			void invalidateProjection();
+
+			/**
+			 * @brief Marks the view as outdated.
+			 *
+			 * Marks the view as outdated and bumps the version.
+			 */
+			void invalidateView();
+
+			/**
+			 * @brief Rebuilds the outdated matrices.
+			 *
+			 * Rebuilds the outdated matrices. Does nothing if none are outdated.
+			 */
+			void updateMatrices();
+
 			glm::vec3 direction;		/// Vector indicating where the camera is looking.
 			float far;					/// Maximum clipping limit.
 			float fov;					/// Field of view;
@@ -219,6 +275,16 @@ namespace bgq_opengl {
 			int window_width;			/// Width of the GLUT window.
             glm::mat4 transforms = glm::mat4(1.0f); /// Tranform matrixes that will be passed to the shader.
 
+			glm::vec3 cached_direction;				/// Transformed direction.
+			glm::vec3 cached_position;				/// Transformed position.
+			glm::vec3 cached_up;					/// Transformed up vector.
+			glm::mat4 view;							/// Cached view matrix.
+			glm::mat4 projection;					/// Cached projection matrix.
+			glm::mat4 view_projection;				/// Cached projection * view.
+			bool view_dirty = true;					/// Whether the view has to be rebuilt.
+			bool projection_dirty = true;			/// Whether the projection has to be rebuilt.
+			uint64_t version = 0;					/// Bumped every time the matrices change.
+
 			const float speed = 0.25f;				/// Speed of the camera movement.
 			const float horizontal_rotation = 3.0f;	/// How much it rotates for every step.
 			const float vertical_rotation = 0.1f;	/// How much it rotates for every step.
@@ -15,21 +15,37 @@
 
 #include "cubemap.h"
 
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <functional>
+#include <future>
+#include <iomanip>
 #include <iostream>
+#include <memory>
 #include <string>
+#include <system_error>
 #include <vector>
 #include <cassert>
 
 #include "GL/glew.h"
-#include "stb/stb_image.h"
+
+#include "classes/async_loader/async_loader.h"
+#include "classes/gl_state/gl_state.h"
+#include "classes/gl_texture/gl_texture.h"
+#include "classes/shader/shader.h"
+#include "classes/texture/texture.h"
+#include "classes/texture_cache/texture_cache.h"
+#include "structs/image_payload/image_payload.h"
+#include "structs/texture_options/texture_options.h"
 
 namespace bgq_opengl {
 
-    Cubemap::Cubemap(GLuint id, std::string name, GLuint slot) {
+    double Cubemap::last_load_time = 0.0;
+
+    Cubemap::Cubemap() {
         
-        this->ID = id;
-        this->slot = slot;
-        this->name = name;
+        this->slot = 0;
         
     }
 
@@ -38,72 +54,110 @@ namespace bgq_opengl {
         // The slot has to be a positive number because OpenGL does weird stuff on macOS else.
         if (slot < 1) assert(false);
 
-        // Generate a texture in OpenGL and store the parameters in the attributes.
-        glGenTextures(1, &this->ID);
-        glActiveTexture(GL_TEXTURE0 + slot);
-        glBindTexture(GL_TEXTURE_CUBE_MAP, this->ID);
-        
-        this->name = std::string(name);
+        // Store the parameters in the attributes.
+        this->name = std::string(type);
         this->slot = slot;
         
-        int width, height, channels;
+        // The same faces make the same cubemap, so reuse it if it is already in OpenGL.
+        std::string key = "cubemap";
+        for (const std::string &face : textures_faces)
+            key += "|" + face;
+
+        this->texture = GLTexture::getRegistry().acquire(key, [&]() {
+
+            return Cubemap::load(textures_faces, slot);
+
+        });
         
-        // Loop through the images, load them and pass them to OpenGL.
-        for (unsigned int i = 0; i < textures_faces.size(); i++) {
-            
-            unsigned char *data = stbi_load(textures_faces[i].c_str(), &width, &height, &channels, 0);
-            if (data) {
-                
-                // Get the color model for the image.
-                GLenum color_model = GL_RGBA;
+    }
 
-                if (channels == 4)
-                    color_model = GL_RGBA;
-                else if (channels == 3)
-                    color_model = GL_RGB;
-                else if (channels == 1)
-                    color_model = GL_RED;
-                else
-                    assert(false);
-                
-                glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, 0, GL_RGBA, width, height, 0, color_model, GL_UNSIGNED_BYTE, data);
-                glGenerateMipmap(GL_TEXTURE_CUBE_MAP);
-                stbi_image_free(data);
-                
-            } else {
+    Cubemap::Cubemap(const std::vector<std::string> &textures_faces, const char* type, GLuint slot, AsyncLoader &loader) {
+        
+        // The slot has to be a positive number because OpenGL does weird stuff on macOS else.
+        if (slot < 1) assert(false);
+
+        // Store the parameters in the attributes.
+        this->name = std::string(type);
+        this->slot = slot;
+        
+        // The same faces make the same cubemap, so reuse it if it is already in OpenGL.
+        std::string key = "cubemap";
+        for (const std::string &face : textures_faces)
+            key += "|" + face;
+
+        this->texture = GLTexture::getRegistry().acquire(key, [&]() {
+            
+            // Start with a white pixel per face.
+            std::shared_ptr<GLTexture> texture = std::make_shared<GLTexture>(GL_TEXTURE_CUBE_MAP);
+            ImagePayload placeholder;
+            placeholder.pixels = std::shared_ptr<unsigned char>(new unsigned char[4] {255, 255, 255, 255}, std::default_delete<unsigned char[]>());
+            placeholder.width = 1;
+            placeholder.height = 1;
+            placeholder.channels = 4;
+            Cubemap::upload(*texture, std::vector<ImagePayload>(6, placeholder), slot);
+            
+            // Decode every face on its own worker. The last one to finish
+            // queues a single upload of all six. Only a weak reference leaves
+            // this thread, so it can never delete the texture.
+            std::shared_ptr<PendingFaces> pending = std::make_shared<PendingFaces>();
+            pending->faces.resize(textures_faces.size());
+            pending->left = textures_faces.size();
+            pending->start = std::chrono::steady_clock::now();
+            
+            std::weak_ptr<GLTexture> target = texture;
+            AsyncLoader *async = &loader;
+            
+            for (size_t i = 0; i < textures_faces.size(); i++) {
                 
-                std::cerr << "Cubemap error: cubemap " << textures_faces[i] << " could not be loaded." << std::endl;
-                stbi_image_free(data);
-                exit(1);
+                loader.run([async, target, pending, face = textures_faces[i], i, slot]() {
+                    
+                    // Each worker writes its own slot, so they never race.
+                    pending->faces[i] = Cubemap::decodeFace(face);
+                    if (--pending->left > 0)
+                        return;
+                    
+                    async->upload([target, pending, slot]() {
+                        
+                        if (std::shared_ptr<GLTexture> texture = target.lock()) {
+                            
+                            Cubemap::upload(*texture, pending->faces, slot);
+                            
+                            std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - pending->start;
+                            Cubemap::last_load_time = elapsed.count();
+                            
+                        }
+                        
+                    });
+                    
+                });
                 
             }
             
-        }
+            return texture;
 
-        glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-        glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-        glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-        glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-        glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
-        
-        // Unbinds the OpenGL Texture.
-        glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
+        });
         
     }
 
-    GLuint Cubemap::getID() {
+    GLuint Cubemap::getID() const {
         
-        return this->ID;
+        return this->texture ? this->texture->getID() : 0;
         
     }
 
-    GLuint Cubemap::getSlot() {
+    GLuint Cubemap::getSlot() const {
         
         return this->slot;
         
     }
 
-    std::string Cubemap::getName() {
+    double Cubemap::getLastLoadTime() {
+        
+        return Cubemap::last_load_time;
+        
+    }
+
+    const std::string& Cubemap::getName() const {
         
         return this->name;
         
@@ -112,20 +166,246 @@ namespace bgq_opengl {
     void Cubemap::bind() {
         
         // Activate the texture and bind it.
-        glActiveTexture(GL_TEXTURE0 + this->slot);
-        glBindTexture(GL_TEXTURE_CUBE_MAP, this->ID);
+        GLState::bindTexture(this->slot, GL_TEXTURE_CUBE_MAP, this->getID());
         
     }
 
     void Cubemap::remove() {
         
-        glDeleteTextures(1, &this->ID);
+        // Drop this reference. OpenGL deletes it when the last one is dropped.
+        this->texture.reset();
         
     }
 
     void Cubemap::unbind() {
         
-        glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
+        // Unbind the texture from its slot.
+        GLState::bindTexture(this->slot, GL_TEXTURE_CUBE_MAP, 0);
+        
+    }
+
+    void Cubemap::benchmark(const std::vector<std::string> &directories) {
+        
+        const int repetitions = 3;
+        const char *names[] = {"right.jpg", "left.jpg", "top.jpg", "bottom.jpg", "front.jpg", "back.jpg"};
+        
+        std::cout << std::setw(24) << "faces" << std::setw(7) << "size" << std::setw(13) << "serial (ms)" << std::setw(15) << "parallel (ms)"
+                  << std::setw(16) << "cold load (ms)" << std::setw(16) << "warm load (ms)" << std::endl;
+        
+        for (const std::string &directory : directories) {
+            
+            std::vector<std::string> faces;
+            for (const char *name : names)
+                faces.push_back(directory + "/" + name);
+            
+            // Check the set first, as a missing face would stop the program in the load.
+            std::vector<ImagePayload> decoded = Cubemap::decode(faces);
+            bool complete = true;
+            for (const ImagePayload &face : decoded)
+                complete = complete && face.pixels && face.width == face.height && face.width == decoded[0].width;
+            
+            if (!complete) {
+                
+                std::cerr << "Cubemap error: " << directory << " does not hold six square faces of the same size." << std::endl;
+                continue;
+                
+            }
+            
+            int size = decoded[0].width;
+            decoded.clear();
+            
+            // Average some runs, deleting the texture cache of the faces before each cold one.
+            auto time = [&](bool cold, const std::function<void()> &work) {
+                
+                double total = 0.0;
+                for (int i = 0; i < repetitions; i++) {
+                    
+                    if (cold) {
+                        
+                        std::error_code error;
+                        for (const std::string &face : faces)
+                            std::filesystem::remove(TextureCache::getPath(face.c_str()), error);
+                        
+                    }
+                    
+                    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+                    work();
+                    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+                    total += elapsed.count();
+                    
+                }
+                
+                return total / repetitions;
+                
+            };
+            
+            double serial = time(true, [&]() {
+                
+                for (const std::string &face : faces)
+                    Cubemap::decodeFace(face);
+                
+            });
+            
+            double parallel = time(true, [&]() {
+                
+                Cubemap::decode(faces);
+                
+            });
+            
+            // Wait for the GPU too, so the upload and the mipmaps are counted.
+            auto load = [&]() {
+                
+                Cubemap::load(faces, 1);
+                glFinish();
+                
+            };
+            
+            double cold_load = time(true, load);
+            double warm_load = time(false, load);
+            
+            std::cout << std::fixed << std::setprecision(1);
+            std::cout << std::setw(24) << directory << std::setw(7) << size << std::setw(13) << serial << std::setw(15) << parallel
+                      << std::setw(16) << cold_load << std::setw(16) << warm_load << std::endl;
+            std::cout << std::defaultfloat;
+            
+        }
+        
+    }
+
+    std::vector<ImagePayload> Cubemap::decode(const std::vector<std::string> &textures_faces) {
+        
+        // Decode every face on its own thread.
+        std::vector<std::future<ImagePayload>> decoding;
+        for (const std::string &face : textures_faces)
+            decoding.push_back(std::async(std::launch::async, Cubemap::decodeFace, face));
+        
+        std::vector<ImagePayload> faces;
+        for (std::future<ImagePayload> &face : decoding)
+            faces.push_back(face.get());
+        
+        return faces;
+        
+    }
+
+    ImagePayload Cubemap::decodeFace(const std::string &face) {
+        
+        // Cube map faces are not flipped.
+        TextureOptions options;
+        options.flip = false;
+        
+        return Texture::decode(face.c_str(), options);
+        
+    }
+
+    void Cubemap::upload(GLTexture &texture, const std::vector<ImagePayload> &faces, GLuint slot) {
+        
+        // A cube map is only complete if every face is square and of the same size.
+        for (unsigned int i = 0; i < faces.size(); i++) {
+            
+            const ImagePayload &face = faces[i];
+            if (!face.pixels) {
+                
+                std::cerr << "Cubemap error: face " << i << " of a cubemap could not be loaded." << std::endl;
+                exit(1);
+                
+            }
+            
+            if (face.width != face.height || face.width != faces[0].width) {
+                
+                std::cerr << "Cubemap error: face " << i << " of a cubemap is " << face.width << "x" << face.height
+                          << " but every face has to be " << faces[0].width << "x" << faces[0].width << "." << std::endl;
+                exit(1);
+                
+            }
+            
+        }
+        
+        // Only use the mipmaps of the faces if all of them have every level.
+        bool prebuilt = true;
+        for (const ImagePayload &face : faces)
+            prebuilt = prebuilt && face.mipmaps.size() + 1 == TextureCache::getLevelCount(face.width, face.height);
+        
+        GLState::bindTexture(slot, GL_TEXTURE_CUBE_MAP, texture.getID());
+        
+        // Store them as sRGB if the framebuffer encodes to it, so they are read linear.
+        GLint internal_format = Shader::getSRGBFramebuffer() ? GL_SRGB8_ALPHA8 : GL_RGBA;
+        
+        // Loop through the images and pass them to OpenGL.
+        for (unsigned int i = 0; i < faces.size(); i++) {
+            
+            const ImagePayload &face = faces[i];
+            
+            // Get the color model for the image.
+            GLenum color_model = GL_RGBA;
+
+            if (face.channels == 4)
+                color_model = GL_RGBA;
+            else if (face.channels == 3)
+                color_model = GL_RGB;
+            else if (face.channels == 1)
+                color_model = GL_RED;
+            else
+                assert(false);
+            
+            glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, 0, internal_format, face.width, face.height, 0, color_model, GL_UNSIGNED_BYTE, face.pixels.get());
+            texture.setSize(face.width, face.height, face.channels);
+            
+            // Upload the mipmaps too if they were built already.
+            if (prebuilt) {
+                
+                int size = face.width;
+                for (size_t level = 0; level < face.mipmaps.size(); level++) {
+                    
+                    size = std::max(1, size / 2);
+                    glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, (GLint) level + 1, internal_format, size, size, 0, color_model, GL_UNSIGNED_BYTE, face.mipmaps[level].get());
+                    
+                }
+                
+            }
+            
+        }
+        
+        // Build the mipmaps once, now that the cube map is complete.
+        if (!prebuilt)
+            glGenerateMipmap(GL_TEXTURE_CUBE_MAP);
+
+        glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+        glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
+        
+        // Unbinds the OpenGL Texture.
+        GLState::bindTexture(slot, GL_TEXTURE_CUBE_MAP, 0);
+        
+    }
+
+    std::shared_ptr<GLTexture> Cubemap::load(const std::vector<std::string> &textures_faces, GLuint slot) {
+        
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        
+        // Generate a texture in OpenGL and fill it.
+        std::shared_ptr<GLTexture> texture = std::make_shared<GLTexture>(GL_TEXTURE_CUBE_MAP);
+        std::vector<ImagePayload> faces = Cubemap::decode(textures_faces);
+        
+        // Name the file that failed, as the upload only knows its face.
+        for (size_t i = 0; i < faces.size(); i++) {
+            
+            if (!faces[i].pixels) {
+                
+                std::cerr << "Cubemap error: cubemap " << textures_faces[i] << " could not be loaded." << std::endl;
+                exit(1);
+                
+            }
+            
+        }
+        
+        Cubemap::upload(*texture, faces, slot);
+        
+        std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+        Cubemap::last_load_time = elapsed.count();
+        
+        return texture;
         
     }
 
@@ -18,11 +18,18 @@
 #ifndef BGQ_OPENGL_CLASSES_CUBEMAP_H_
 #define BGQ_OPENGL_CLASSES_CUBEMAP_H_
 
+#include <atomic>
+#include <chrono>
+#include <memory>
 #include <string>
 #include <vector>
 
 #include "GL/glew.h"
 
+#include "classes/async_loader/async_loader.h"
+#include "classes/gl_texture/gl_texture.h"
+#include "structs/image_payload/image_payload.h"
+
 namespace bgq_opengl {
 
     /**
@@ -37,15 +44,11 @@ namespace bgq_opengl {
         public:
         
             /**
-             * @brief Copies a cubemap from another.
-             *
-             * Copies a cubemap from another.
+             * @brief Constructs an empty cubemap.
              *
-             * @param id The cubemap to be copied.
-             * @param name The name of this texture.
-             * @param slot The slot for this texture.
+             * Constructs a cubemap with no texture, which binds 0.
              */
-            Cubemap(GLuint id, std::string name, GLuint slot);
+            Cubemap();
 
             /**
              * @brief Constructs a skybox instance.
@@ -58,6 +61,20 @@ namespace bgq_opengl {
              */
             Cubemap(const std::vector<std::string> &textures_faces, const char* type, GLuint slot);
 
+            /**
+             * @brief Constructs a cubemap in the background.
+             *
+             * Constructs a cubemap with a white pixel per face and decodes each
+             * face on its own worker of the loader. They replace the pixels on a
+             * single upload once all six are decoded.
+             *
+             * @param textures_faces A vector containing the skybox faces in the right, left, top, bottom, back, and front order.
+             * @param type Texture type.
+             * @param slot Texture slot.
+             * @param loader The loader decoding and uploading the faces.
+             */
+            Cubemap(const std::vector<std::string> &textures_faces, const char* type, GLuint slot, AsyncLoader &loader);
+
             /**
              * @brief Get the ID of the texture.
              *
@@ -65,7 +82,7 @@ namespace bgq_opengl {
              *
              * @returns The ID of the texture.
              */
-            GLuint getID();
+            GLuint getID() const;
 
             /**
              * @brief Get the slot of the texture.
@@ -74,16 +91,26 @@ namespace bgq_opengl {
              *
              * @returns The slot of the texture.
              */
-            GLuint getSlot();
+            GLuint getSlot() const;
+
+            /**
+             * @brief Get the load time of the last cubemap.
+             *
+             * Get the time from asking for the last cubemap loaded to it being
+             * in OpenGL, including decoding the faces and building the mipmaps.
+             *
+             * @returns The load time in milliseconds, or 0 if none was loaded.
+             */
+            static double getLastLoadTime();
 
             /**
              * @brief Gets the texture name.
              *
              * Gets the texture name as a char array.
              *
-             * @returns A char string containing the name name of the texture.
+             * @returns A read-only reference to the name of the texture.
              */
-            std::string getName();
+            const std::string& getName() const;
 
             /**
              * @brief Binds the texture.
@@ -95,7 +122,8 @@ namespace bgq_opengl {
             /**
              * @brief Removes the texture from OpenGL.
              *
-             *  Removes the texture from OpenGL.
+             * Drops this reference to the texture. It is removed from OpenGL once
+             * no other cubemap uses it.
              */
             void remove();
 
@@ -106,11 +134,85 @@ namespace bgq_opengl {
              */
             void unbind();
 
+            /**
+             * @brief Runs the benchmark of the cubemap loads.
+             *
+             * Times each face set in three ways: decoding the faces one after the
+             * other, decoding them in parallel, and the whole load into OpenGL.
+             * Each is timed cold, with the texture cache files of the faces
+             * deleted first. The whole load is also timed warm, reading them.
+             * Prints a table with the average of a few runs. It needs a context.
+             *
+             * @param directories The folders with the six faces, named right.jpg, left.jpg, top.jpg, bottom.jpg, front.jpg and back.jpg.
+             */
+            static void benchmark(const std::vector<std::string> &directories);
+
+            /**
+             * @brief Decodes the faces.
+             *
+             * Reads the face images into memory, each on its own thread. It does
+             * not touch OpenGL, so it can run on any thread.
+             *
+             * @param textures_faces The face images.
+             *
+             * @returns The decoded faces.
+             */
+            static std::vector<ImagePayload> decode(const std::vector<std::string> &textures_faces);
+
+            /**
+             * @brief Uploads the decoded faces.
+             *
+             * Uploads the decoded faces to a cube map texture with their mipmaps,
+             * or builds them once all the faces are in if they do not have them.
+             * The faces have to be square and of the same size.
+             *
+             * @param texture The texture to fill.
+             * @param faces The decoded faces.
+             * @param slot Texture slot used while uploading.
+             */
+            static void upload(GLTexture &texture, const std::vector<ImagePayload> &faces, GLuint slot);
+
         private:
 
-            GLuint ID;                      /// Texture OpenGL ID.
-            GLuint slot;                    /// Stores the texture slot number.
-            std::string name;               /// Texture name.
+            /**
+             * @brief Faces being decoded in the background.
+             */
+            struct PendingFaces {
+
+                std::vector<ImagePayload> faces;                    /// Decoded faces, one slot per worker.
+                std::atomic<size_t> left;                           /// Faces still being decoded.
+                std::chrono::steady_clock::time_point start;        /// When the cubemap was asked for.
+
+            };
+
+            /**
+             * @brief Decodes a face.
+             *
+             * Reads a face image into memory, unflipped.
+             *
+             * @param face The face image.
+             *
+             * @returns The decoded face.
+             */
+            static ImagePayload decodeFace(const std::string &face);
+
+            /**
+             * @brief Loads the faces into OpenGL.
+             *
+             * Reads the six face images and uploads them as a cube map texture.
+             *
+             * @param textures_faces The face images.
+             * @param slot Texture slot used while uploading.
+             *
+             * @returns The new texture.
+             */
+            static std::shared_ptr<GLTexture> load(const std::vector<std::string> &textures_faces, GLuint slot);
+
+            std::shared_ptr<GLTexture> texture; /// The texture in OpenGL, shared.
+            GLuint slot;                        /// Stores the texture slot number.
+            std::string name;                   /// Texture name.
+
+            static double last_load_time;       /// Load time of the last cubemap, in milliseconds.
 
     };
 
@@ -15,24 +15,77 @@
 
 #include "ebo.h"
 
+#include <utility>
+#include <span>
 #include <vector>
 
 #include "GL/glew.h"
 
 namespace bgq_opengl {
 
+	EBO::EBO() {}
+
 	// Constructor that generates a Elements Buffer Object and links it to indices
-	EBO::EBO(const std::vector<GLuint> &indices) {
+	EBO::EBO(std::span<const GLuint> indices) {
 		
 		// Generate the buffer.
 		glGenBuffers(1, &this->ID);
 		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, this->ID);
 
 		// Link the indices.
-		glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(GLuint), indices.data(), GL_STATIC_DRAW);
+		glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size_bytes(), indices.data(), GL_STATIC_DRAW);
 	
 	}
 
+	EBO::EBO(std::span<const GLushort> indices) {
+
+		// Generate the buffer.
+		glGenBuffers(1, &this->ID);
+		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, this->ID);
+
+		// Link the indices.
+		glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size_bytes(), indices.data(), GL_STATIC_DRAW);
+
+	}
+
+	EBO::EBO(const void *data, GLsizeiptr size, GLenum usage) {
+
+		// Generate the buffer.
+		glGenBuffers(1, &this->ID);
+		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, this->ID);
+
+		// Copy the data.
+		glBufferData(GL_ELEMENT_ARRAY_BUFFER, size, data, usage);
+
+	}
+
+	EBO::EBO(EBO &&other) noexcept {
+
+		*this = std::move(other);
+
+	}
+
+	EBO::~EBO() {
+
+		this->remove();
+
+	}
+
+	EBO& EBO::operator=(EBO &&other) noexcept {
+
+		if (this != &other) {
+
+			// Free ours and take theirs.
+			this->remove();
+			this->ID = other.ID;
+			other.ID = 0;
+
+		}
+
+		return *this;
+
+	}
+
 	void EBO::bind() {
 
 		// Binds the EBO.
@@ -40,9 +93,20 @@ namespace bgq_opengl {
 	
 	}
 
+	GLuint EBO::getID() const {
+
+		return this->ID;
+
+	}
+
 	void EBO::remove() {
 
+		// Delete the buffer in OpenGL, only once.
+		if (this->ID == 0)
+			return;
+
 		glDeleteBuffers(1, &this->ID);
+		this->ID = 0;
 
 	}
 
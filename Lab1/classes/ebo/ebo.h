@@ -16,6 +16,7 @@
 #ifndef BGQ_OPENGL_CLASS_EBO_H_
 #define BGQ_OPENGL_CLASS_EBO_H_
 
+#include <span>
 #include <vector>
 
 #include "GL/glew.h"
@@ -34,6 +35,13 @@ namespace bgq_opengl {
 		
 		public:
 			
+			/**
+			 * @brief Constructs an empty Elements Buffer Object.
+			 *
+			 * Constructs a Elements Buffer Object with no buffer in OpenGL.
+			 */
+			EBO();
+
 			/**
 			 * @brief Constructs a Elements Buffer Object.
 			 *
@@ -41,7 +49,61 @@ namespace bgq_opengl {
 			 *
 			 * @param indices Indices that will be linked.
 			 */
-			EBO(const std::vector<GLuint> &indices);
+			EBO(std::span<const GLuint> indices);
+
+			/**
+			 * @brief Constructs a Elements Buffer Object of short indices.
+			 *
+			 * Constructs a Elements Buffer Object and links its 16 bit indices,
+			 * for meshes with fewer than 65536 vertices.
+			 *
+			 * @param indices Indices that will be linked.
+			 */
+			EBO(std::span<const GLushort> indices);
+
+			/**
+			 * @brief Constructs a Elements Buffer Object from raw data.
+			 *
+			 * Constructs a Elements Buffer Object of any size. It binds to the
+			 * bound VAO, so no VAO should be bound.
+			 *
+			 * @param data Pointer to the data, or null to leave it uninitialized.
+			 * @param size Size of the data in bytes.
+			 * @param usage OpenGL usage hint (GL_STATIC_DRAW, GL_DYNAMIC_DRAW...).
+			 */
+			EBO(const void *data, GLsizeiptr size, GLenum usage);
+
+			/**
+			 * @brief Moves a Elements Buffer Object.
+			 *
+			 * Takes the OpenGL object of another EBO, which is left empty.
+			 *
+			 * @param other The EBO to move from.
+			 */
+			EBO(EBO &&other) noexcept;
+
+			/**
+			 * @brief Destroys the Elements Buffer Object.
+			 *
+			 * Deletes the OpenGL object, if it still has one.
+			 */
+			~EBO();
+
+			// Copies would delete the same OpenGL object twice.
+			EBO(const EBO&) = delete;
+			EBO& operator=(const EBO&) = delete;
+
+			/**
+			 * @brief Moves a Elements Buffer Object.
+			 *
+			 * Deletes the OpenGL object of this EBO and takes the one of another,
+			 * which is left empty.
+			 *
+			 * @param other The EBO to move from.
+			 *
+			 * @returns This EBO.
+			 */
+			EBO& operator=(EBO &&other) noexcept;
 
 			/**
 			 * @brief Binds the EBO.
@@ -50,6 +112,13 @@ namespace bgq_opengl {
 			 */
 			void bind();
 
+			/**
+			 * @brief Get the ID of the EBO.
+			 *
+			 * @returns The OpenGL ID, 0 if it is empty.
+			 */
+			GLuint getID() const;
+
 			/**
 			 * @brief Removes the EBO.
 			 *
@@ -66,7 +135,7 @@ namespace bgq_opengl {
 
 		private:
 
-			GLuint ID; // GL ID of the EBO.
+			GLuint ID = 0; // GL ID of the EBO.
 
 	};
 
@@ -0,0 +1,156 @@
+/**
+ * @file fbo.cpp
+ * @brief FBO class implementation file.
+ * @version 1.0.0 (2026-10-17)
+ * @date 2026-10-17
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#include "fbo.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <iostream>
+#include <utility>
+#include <vector>
+
+#include "GL/glew.h"
+
+namespace bgq_opengl {
+
+	FBO::FBO() {}
+
+	FBO::FBO(GLsizei width, GLsizei height) {
+
+		this->width = width;
+		this->height = height;
+
+		// Create the renderbuffers. They are never sampled, so no textures are
+		// needed. The color is stored as sRGB, like a window would.
+		glGenRenderbuffers(1, &this->color_buffer);
+		glBindRenderbuffer(GL_RENDERBUFFER, this->color_buffer);
+		glRenderbufferStorage(GL_RENDERBUFFER, GL_SRGB8_ALPHA8, width, height);
+
+		glGenRenderbuffers(1, &this->depth_buffer);
+		glBindRenderbuffer(GL_RENDERBUFFER, this->depth_buffer);
+		glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, width, height);
+		glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+		// Attach them to the framebuffer.
+		glGenFramebuffers(1, &this->ID);
+		glBindFramebuffer(GL_FRAMEBUFFER, this->ID);
+		glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, this->color_buffer);
+		glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, this->depth_buffer);
+
+		// Check it can be drawn to.
+		GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+		glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+		if (status != GL_FRAMEBUFFER_COMPLETE) {
+
+			std::cerr << "The framebuffer of " << width << "x" << height << " is not complete: " << status << std::endl;
+			exit(1);
+
+		}
+
+	}
+
+	FBO::FBO(FBO &&other) noexcept {
+
+		*this = std::move(other);
+
+	}
+
+	FBO::~FBO() {
+
+		this->remove();
+
+	}
+
+	FBO& FBO::operator=(FBO &&other) noexcept {
+
+		if (this != &other) {
+
+			// Free ours and take theirs.
+			this->remove();
+			this->ID = other.ID;
+			this->color_buffer = other.color_buffer;
+			this->depth_buffer = other.depth_buffer;
+			this->width = other.width;
+			this->height = other.height;
+			other.ID = 0;
+			other.color_buffer = 0;
+			other.depth_buffer = 0;
+
+		}
+
+		return *this;
+
+	}
+
+	void FBO::bind() {
+
+		glBindFramebuffer(GL_FRAMEBUFFER, this->ID);
+		glViewport(0, 0, this->width, this->height);
+
+	}
+
+	GLsizei FBO::getHeight() const {
+
+		return this->height;
+
+	}
+
+	GLsizei FBO::getWidth() const {
+
+		return this->width;
+
+	}
+
+	void FBO::readPixels(std::vector<unsigned char> &pixels) {
+
+		size_t row_size = (size_t) this->width * 3;
+		pixels.resize(row_size * this->height);
+
+		// Rows of RGB are not a multiple of 4 bytes for every width.
+		glBindFramebuffer(GL_READ_FRAMEBUFFER, this->ID);
+		glPixelStorei(GL_PACK_ALIGNMENT, 1);
+		glReadPixels(0, 0, this->width, this->height, GL_RGB, GL_UNSIGNED_BYTE, pixels.data());
+		glPixelStorei(GL_PACK_ALIGNMENT, 4);
+		glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
+
+		// OpenGL gives the bottom row first, so flip them.
+		for (GLsizei row = 0; row < this->height / 2; row++)
+			std::swap_ranges(pixels.begin() + row * row_size, pixels.begin() + (row + 1) * row_size, pixels.begin() + (this->height - 1 - row) * row_size);
+
+	}
+
+	void FBO::remove() {
+
+		// Delete the objects in OpenGL, only once.
+		if (this->ID == 0)
+			return;
+
+		glDeleteFramebuffers(1, &this->ID);
+		glDeleteRenderbuffers(1, &this->color_buffer);
+		glDeleteRenderbuffers(1, &this->depth_buffer);
+		this->ID = 0;
+		this->color_buffer = 0;
+		this->depth_buffer = 0;
+
+	}
+
+	void FBO::unbind() {
+
+		glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+	}
+
+}  // namespace bgq_opengl
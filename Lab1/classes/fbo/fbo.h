@@ -0,0 +1,145 @@
+/**
+ * @file fbo.h
+ * @brief FBO class header file.
+ * @version 1.0.0 (2026-10-17)
+ * @date 2026-10-17
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#ifndef BGQ_OPENGL_CLASSES_FBO_H_
+#define BGQ_OPENGL_CLASSES_FBO_H_
+
+#include <vector>
+
+#include "GL/glew.h"
+
+namespace bgq_opengl {
+
+	/**
+	 * @brief Implementation of a FBO class.
+	 *
+	 * Implementation of a Framebuffer Object class with a color and a depth
+	 * renderbuffer, so the scene can be drawn off the screen and read back.
+	 *
+	 * @author Borja García Quiroga <garcaqub@tcd.ie>
+	 */
+	class FBO {
+
+	public:
+
+		/**
+		 * @brief Constructs an empty Framebuffer Object.
+		 *
+		 * Constructs a Framebuffer Object with no framebuffer in OpenGL. Nothing
+		 * is called in OpenGL, so it can be used before there is a context.
+		 */
+		FBO();
+
+		/**
+		 * @brief Constructs a Framebuffer Object.
+		 *
+		 * Constructs a Framebuffer Object with an 8 bit RGBA color buffer and a
+		 * 24 bit depth buffer. Exits if OpenGL cannot draw to it.
+		 *
+		 * @param width Width in pixels.
+		 * @param height Height in pixels.
+		 */
+		FBO(GLsizei width, GLsizei height);
+
+		/**
+		 * @brief Moves a Framebuffer Object.
+		 *
+		 * Takes the OpenGL objects of another FBO, which is left empty.
+		 *
+		 * @param other The FBO to move from.
+		 */
+		FBO(FBO &&other) noexcept;
+
+		/**
+		 * @brief Destroys the Framebuffer Object.
+		 *
+		 * Deletes the OpenGL objects, if it still has them.
+		 */
+		~FBO();
+
+		// Copies would delete the same OpenGL objects twice.
+		FBO(const FBO&) = delete;
+		FBO& operator=(const FBO&) = delete;
+
+		/**
+		 * @brief Moves a Framebuffer Object.
+		 *
+		 * Deletes the OpenGL objects of this FBO and takes the ones of another,
+		 * which is left empty.
+		 *
+		 * @param other The FBO to move from.
+		 *
+		 * @returns This FBO.
+		 */
+		FBO& operator=(FBO &&other) noexcept;
+
+		/**
+		 * @brief Binds the FBO.
+		 *
+		 * Binds the FBO to be drawn to and sets the viewport to all of it.
+		 */
+		void bind();
+
+		/**
+		 * @brief Get the height.
+		 *
+		 * @returns The height in pixels.
+		 */
+		GLsizei getHeight() const;
+
+		/**
+		 * @brief Get the width.
+		 *
+		 * @returns The width in pixels.
+		 */
+		GLsizei getWidth() const;
+
+		/**
+		 * @brief Reads the color buffer.
+		 *
+		 * Waits for the drawing to finish and reads the color buffer as 8 bit
+		 * RGB, the top row first.
+		 *
+		 * @param pixels Outputs the pixels.
+		 */
+		void readPixels(std::vector<unsigned char> &pixels);
+
+		/**
+		 * @brief Removes the FBO.
+		 *
+		 * Removes the framebuffer and its renderbuffers from OpenGL.
+		 */
+		void remove();
+
+		/**
+		 * @brief Unbinds the FBO.
+		 *
+		 * Binds the default framebuffer back.
+		 */
+		void unbind();
+
+	private:
+
+		GLuint ID = 0;				// GL ID of the FBO.
+		GLuint color_buffer = 0;	// GL ID of the color renderbuffer.
+		GLuint depth_buffer = 0;	// GL ID of the depth renderbuffer.
+		GLsizei width = 0;			// Width in pixels.
+		GLsizei height = 0;			// Height in pixels.
+
+	};
+
+}  // namespace bgq_opengl
+
+#endif //!BGQ_OPENGL_CLASSES_FBO_H_
@@ -0,0 +1,172 @@
+/**
+ * @file frustum.cpp
+ * @brief Frustum class implementation file.
+ * @version 1.0.0 (2026-10-17)
+ * @date 2026-10-17
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#include "frustum.h"
+
+#include <cmath>
+
+#include "glm/glm.hpp"
+
+#if defined(__x86_64__)
+#define BGQ_OPENGL_FRUSTUM_X86 1
+#include <immintrin.h>
+#elif defined(__ARM_NEON)
+#define BGQ_OPENGL_FRUSTUM_NEON 1
+#include <arm_neon.h>
+#endif
+
+#include "structs/bounding_box/bounding_box.h"
+
+namespace bgq_opengl {
+
+	Frustum::Frustum() {
+
+		// A plane with no normal and a positive distance keeps everything.
+		for (int i = 0; i < Frustum::num_planes; i++) {
+
+			this->normal_x[i] = 0.0f;
+			this->normal_y[i] = 0.0f;
+			this->normal_z[i] = 0.0f;
+			this->distance[i] = 1.0f;
+
+		}
+
+	}
+
+	Frustum::Frustum(const glm::mat4 &view_projection) : Frustum() {
+
+		// Get the rows, as glm stores the columns.
+		glm::vec4 rows[4];
+		for (int i = 0; i < 4; i++)
+			rows[i] = glm::vec4(view_projection[0][i], view_projection[1][i], view_projection[2][i], view_projection[3][i]);
+
+		// Left, right, bottom, top, near and far, for a clip space z in [-w, w].
+		glm::vec4 planes[6] = {
+			rows[3] + rows[0], rows[3] - rows[0],
+			rows[3] + rows[1], rows[3] - rows[1],
+			rows[3] + rows[2], rows[3] - rows[2]
+		};
+
+		// Normalize them so the distances are in world units.
+		for (int i = 0; i < 6; i++) {
+
+			float length = glm::length(glm::vec3(planes[i]));
+			if (length > 0.0f)
+				planes[i] /= length;
+
+			this->normal_x[i] = planes[i].x;
+			this->normal_y[i] = planes[i].y;
+			this->normal_z[i] = planes[i].z;
+			this->distance[i] = planes[i].w;
+
+		}
+
+	}
+
+	int Frustum::classify(const BoundingBox &box) const {
+
+		// Get the box as a centre and half extents.
+		glm::vec3 centre = (box.min + box.max) * 0.5f;
+		glm::vec3 extents = (box.max - box.min) * 0.5f;
+
+#if defined(BGQ_OPENGL_FRUSTUM_X86)
+
+		__m128 cx = _mm_set1_ps(centre.x), cy = _mm_set1_ps(centre.y), cz = _mm_set1_ps(centre.z);
+		__m128 ex = _mm_set1_ps(extents.x), ey = _mm_set1_ps(extents.y), ez = _mm_set1_ps(extents.z);
+		__m128 sign = _mm_set1_ps(-0.0f);
+		__m128 zero = _mm_setzero_ps();
+
+		int out_mask = 0, cross_mask = 0;
+		for (int i = 0; i < Frustum::num_planes; i += 4) {
+
+			__m128 nx = _mm_load_ps(&this->normal_x[i]);
+			__m128 ny = _mm_load_ps(&this->normal_y[i]);
+			__m128 nz = _mm_load_ps(&this->normal_z[i]);
+
+			// Signed distance of the centre and the projected radius of the box.
+			__m128 dist = _mm_add_ps(_mm_add_ps(_mm_mul_ps(nx, cx), _mm_mul_ps(ny, cy)), _mm_add_ps(_mm_mul_ps(nz, cz), _mm_load_ps(&this->distance[i])));
+			__m128 radius = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_andnot_ps(sign, nx), ex), _mm_mul_ps(_mm_andnot_ps(sign, ny), ey)), _mm_mul_ps(_mm_andnot_ps(sign, nz), ez));
+
+			out_mask |= _mm_movemask_ps(_mm_cmplt_ps(_mm_add_ps(dist, radius), zero));
+			cross_mask |= _mm_movemask_ps(_mm_cmplt_ps(_mm_sub_ps(dist, radius), zero));
+
+		}
+
+		if (out_mask)
+			return Frustum::outside;
+
+		return cross_mask ? Frustum::intersecting : Frustum::inside;
+
+#elif defined(BGQ_OPENGL_FRUSTUM_NEON)
+
+		float32x4_t cx = vdupq_n_f32(centre.x), cy = vdupq_n_f32(centre.y), cz = vdupq_n_f32(centre.z);
+		float32x4_t ex = vdupq_n_f32(extents.x), ey = vdupq_n_f32(extents.y), ez = vdupq_n_f32(extents.z);
+		float32x4_t zero = vdupq_n_f32(0.0f);
+
+		uint32x4_t out_mask = vdupq_n_u32(0), cross_mask = vdupq_n_u32(0);
+		for (int i = 0; i < Frustum::num_planes; i += 4) {
+
+			float32x4_t nx = vld1q_f32(&this->normal_x[i]);
+			float32x4_t ny = vld1q_f32(&this->normal_y[i]);
+			float32x4_t nz = vld1q_f32(&this->normal_z[i]);
+
+			// Signed distance of the centre and the projected radius of the box.
+			float32x4_t dist = vmlaq_f32(vmlaq_f32(vmlaq_f32(vld1q_f32(&this->distance[i]), nx, cx), ny, cy), nz, cz);
+			float32x4_t radius = vmlaq_f32(vmlaq_f32(vmulq_f32(vabsq_f32(nx), ex), vabsq_f32(ny), ey), vabsq_f32(nz), ez);
+
+			out_mask = vorrq_u32(out_mask, vcltq_f32(vaddq_f32(dist, radius), zero));
+			cross_mask = vorrq_u32(cross_mask, vcltq_f32(vsubq_f32(dist, radius), zero));
+
+		}
+
+		if (vmaxvq_u32(out_mask))
+			return Frustum::outside;
+
+		return vmaxvq_u32(cross_mask) ? Frustum::intersecting : Frustum::inside;
+
+#else
+
+		return this->classifyScalar(box);
+
+#endif
+
+	}
+
+	int Frustum::classifyScalar(const BoundingBox &box) const {
+
+		// Get the box as a centre and half extents.
+		glm::vec3 centre = (box.min + box.max) * 0.5f;
+		glm::vec3 extents = (box.max - box.min) * 0.5f;
+
+		int result = Frustum::inside;
+		for (int i = 0; i < Frustum::num_planes; i++) {
+
+			// Signed distance of the centre and the projected radius of the box.
+			float dist = this->normal_x[i] * centre.x + this->normal_y[i] * centre.y + this->normal_z[i] * centre.z + this->distance[i];
+			float radius = std::fabs(this->normal_x[i]) * extents.x + std::fabs(this->normal_y[i]) * extents.y + std::fabs(this->normal_z[i]) * extents.z;
+
+			if (dist + radius < 0.0f)
+				return Frustum::outside;
+
+			if (dist - radius < 0.0f)
+				result = Frustum::intersecting;
+
+		}
+
+		return result;
+
+	}
+
+}  // namespace bgq_opengl
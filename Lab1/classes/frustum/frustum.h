@@ -0,0 +1,96 @@
+/**
+ * @file frustum.h
+ * @brief Frustum class header file.
+ * @version 1.0.0 (2026-10-17)
+ * @date 2026-10-17
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#ifndef BGQ_OPENGL_CLASSES_FRUSTUM_H_
+#define BGQ_OPENGL_CLASSES_FRUSTUM_H_
+
+#include "glm/glm.hpp"
+
+#include "structs/bounding_box/bounding_box.h"
+
+namespace bgq_opengl {
+
+	/**
+	 * @brief Implements a view frustum.
+	 *
+	 * Implements the six planes of a view frustum, taken from a camera matrix
+	 * (Gribb and Hartmann 2001), and the tests of boxes against them. The planes
+	 * are stored one component per array, padded to eight with planes that
+	 * nothing is behind, so four planes are tested at once with SSE or NEON.
+	 *
+	 * @author Borja García Quiroga <garcaqub@tcd.ie>
+	 */
+	class Frustum {
+
+		public:
+
+			/**
+			 * @brief Frustum constructor.
+			 *
+			 * Builds a frustum that keeps everything.
+			 */
+			Frustum();
+
+			/**
+			 * @brief Frustum constructor.
+			 *
+			 * Builds the frustum of a camera matrix.
+			 *
+			 * @param view_projection The camera matrix (projection * view).
+			 */
+			Frustum(const glm::mat4 &view_projection);
+
+			/**
+			 * @brief Classifies a box against the frustum.
+			 *
+			 * Tells if the box is fully outside, fully inside or crossing the
+			 * frustum, using the fastest kernel available.
+			 *
+			 * @param box The box, in the space of the camera matrix.
+			 *
+			 * @returns Frustum::outside, Frustum::inside or Frustum::intersecting.
+			 */
+			int classify(const BoundingBox &box) const;
+
+			/**
+			 * @brief Classifies a box against the frustum without SIMD.
+			 *
+			 * Classifies the box with the scalar kernel. Used as a fallback and as
+			 * a reference.
+			 *
+			 * @param box The box, in the space of the camera matrix.
+			 *
+			 * @returns Frustum::outside, Frustum::inside or Frustum::intersecting.
+			 */
+			int classifyScalar(const BoundingBox &box) const;
+
+			static const int outside = 0;			/// The box is behind a plane.
+			static const int intersecting = 1;		/// The box crosses a plane.
+			static const int inside = 2;			/// The box is in front of every plane.
+
+		private:
+
+			static const int num_planes = 8;		/// Planes stored, the six of the frustum and two that keep everything.
+
+			alignas(16) float normal_x[num_planes];	/// X components of the plane normals.
+			alignas(16) float normal_y[num_planes];	/// Y components of the plane normals.
+			alignas(16) float normal_z[num_planes];	/// Z components of the plane normals.
+			alignas(16) float distance[num_planes];	/// Distances of the planes to the origin.
+
+	};
+
+}  // namespace bgq_opengl
+
+#endif  //!BGQ_OPENGL_CLASSES_FRUSTUM_H_
@@ -15,82 +15,163 @@
 
 #include "geometry.h"
 
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <memory>
 #include <vector>
+#include <span>
 #include <stdexcept>
 
 #include "GL/glew.h"
 #include "glm/glm.hpp"
 #include "glm/gtc/type_ptr.hpp"
 
+#include "classes/aabb_kernel/aabb_kernel.h"
+#include "classes/async_loader/async_loader.h"
 #include "classes/camera/camera.h"
-#include "classes/ebo/ebo.h"
+#include "classes/geometry_arena/geometry_arena.h"
+#include "classes/gl_state/gl_state.h"
+#include "classes/mesh/mesh.h"
+#include "classes/ring_buffer/ring_buffer.h"
 #include "classes/shader/shader.h"
 #include "classes/texture/texture.h"
+#include "classes/ubo/ubo.h"
 #include "classes/vao/vao.h"
 #include "structs/vertex/vertex.h"
+#include "structs/arena_range/arena_range.h"
 #include "structs/bounding_box/bounding_box.h"
+#include "structs/draw_data/draw_data.h"
+#include "structs/instance_data/instance_data.h"
+#include "structs/material_data/material_data.h"
+#include "structs/mesh_lod/mesh_lod.h"
+#include "structs/texture_options/texture_options.h"
 
 namespace bgq_opengl {
 
-	Geometry::Geometry(const std::vector<Vertex> &vertices, const std::vector<GLuint> &indices, const std::vector<Texture> &textures, const float shininess) {
+	namespace {
 
-		// Store a copy of these in the attributes.
-		this->vertices = vertices;
-		this->indices = indices;
+		/**
+		 * @brief Transforms a bounding box.
+		 *
+		 * Gets the axis-aligned box that encloses a box once a matrix is
+		 * applied to it, moving its centre and projecting its half extents on
+		 * each axis (Arvo's method).
+		 */
+		BoundingBox transformBox(const BoundingBox &bounding_box, const glm::mat4 &matrix) {
+
+			// Get the box as a centre and half extents.
+			glm::vec3 centre = (bounding_box.min + bounding_box.max) / 2.0f;
+			glm::vec3 extents = (bounding_box.max - bounding_box.min) / 2.0f;
+
+			glm::vec3 world_centre = glm::vec3(matrix * glm::vec4(centre, 1.0f));
+			glm::vec3 world_extents(0.0f, 0.0f, 0.0f);
+
+			for (int axis = 0; axis < 3; axis++) {
+
+				world_extents[axis] = std::abs(matrix[0][axis]) * extents.x
+					+ std::abs(matrix[1][axis]) * extents.y
+					+ std::abs(matrix[2][axis]) * extents.z;
+
+			}
+
+			// Build the bb.
+			BoundingBox bb;
+			bb.min = world_centre - world_extents;
+			bb.max = world_centre + world_extents;
+
+			return bb;
+
+		}
+
+		/**
+		 * @brief Gets the largest scale of a matrix.
+		 */
+		float getMaxScale(const glm::mat4 &matrix) {
+
+			return std::max({glm::length(glm::vec3(matrix[0])), glm::length(glm::vec3(matrix[1])), glm::length(glm::vec3(matrix[2]))});
+
+		}
+
+	}  // namespace
+
+	float Geometry::lod_threshold = 1.0f;
+
+	Geometry::Geometry(const std::vector<Vertex> &vertices, const std::vector<GLuint> &indices, const std::vector<Texture> &textures, const float shininess)
+		: Geometry(std::make_shared<Mesh>(vertices, indices, false, true), textures, shininess) {}
+
+	Geometry::Geometry(std::shared_ptr<Mesh> mesh, const std::vector<Texture> &textures, const float shininess, glm::vec3 color) {
+
+		// Store these in the attributes. The mesh is shared, not copied.
+		this->mesh = mesh;
         this->textures = textures;
-        this->shininess = shininess;
+        this->material.shininess = shininess;
+        this->material.color = glm::vec4(color, 1.0f);
+
+		// Create the buffer for the material. It is filled on the first draw.
+		this->material_ubo = UBO(sizeof(MaterialData), MaterialData::binding);
 
-		// Generate a VAO and bind it, generate a VBO for the vertices and a EBO for the indices.
-		this->vao.bind();
-		VBO vbo(vertices);
-		EBO ebo(indices);
+		// The vertices are read through the VAO of the arena of the mesh.
+
+	}
 
-		// Links VBO attributes such as coordinates and colors to VAO.
-		vao.link_attribute(vbo, 0, 3, GL_FLOAT, sizeof(bgq_opengl::Vertex), (void*)0);
-		vao.link_attribute(vbo, 1, 3, GL_FLOAT, sizeof(bgq_opengl::Vertex), (void*)(3 * sizeof(float)));
-		vao.link_attribute(vbo, 2, 3, GL_FLOAT, sizeof(bgq_opengl::Vertex), (void*)(6 * sizeof(float)));
-        vao.link_attribute(vbo, 3, 2, GL_FLOAT, sizeof(bgq_opengl::Vertex), (void*)(9 * sizeof(float)));
-        vao.link_attribute(vbo, 4, 1, GL_FLOAT, sizeof(bgq_opengl::Vertex), (void*)(11 * sizeof(float)));
+	const std::vector<GLuint>& Geometry::getIndices() const {
 
-		vao.unbind();
-		vbo.unbind();
-		ebo.unbind();
+		return this->mesh->getIndices();
 
 	}
 
-	std::vector<GLuint> Geometry::getIndices() {
+	const std::shared_ptr<Mesh>& Geometry::getMesh() const {
 
-		return this->indices;
+		return this->mesh;
 
 	}
 
-	std::vector<Texture>  Geometry::getTextures() {
+	const std::vector<Texture>& Geometry::getTextures() const {
 
 		return this->textures;
 
 	}
 
-	VAO Geometry::getVAO() {
+	VAO& Geometry::getVAO() {
 
-		return this->vao;
+		if (this->instances_linked)
+			return *this->instance_vao;
+
+		return this->mesh->getArena().getVAO();
 
 	}
 
-	std::vector<Vertex> Geometry::getVertices() {
+	const std::vector<Vertex>& Geometry::getVertices() const {
 
-		return this->vertices;
+		return this->mesh->getVertices();
 
 	}
 
+    const MaterialData& Geometry::getMaterial() const {
+        
+        return this->material;
+        
+    }
+
+    void Geometry::setMaterial(const MaterialData &material) {
+        
+        this->material = material;
+        this->material_dirty = true;
+        
+    }
+
     float Geometry::getShininess() {
         
-        return this->shininess;
+        return this->material.shininess;
         
     }
 
     void Geometry::setShininess(float shine) {
         
-        this->shininess = shine;
+        this->material.shininess = shine;
+        this->material_dirty = true;
         
     }
 
@@ -106,89 +187,365 @@ namespace bgq_opengl {
         
     }
 
-    void Geometry::addTexture(const char* image, const char* name) {
+    void Geometry::addTexture(const char* image, const char* name, const TextureOptions &options, AsyncLoader *loader) {
         
         // Create the new texture from the parameters.
-        Texture new_tex(image, name, (int) this->textures.size() + 1);
+        GLuint slot = (GLuint) this->textures.size() + 1;
         
         // Add this texture to the texture vector.
-        this->textures.push_back(new_tex);
+        if (loader)
+            this->textures.push_back(Texture(image, name, slot, *loader, options));
+        else
+            this->textures.push_back(Texture(image, name, slot, options));
         
     }
 
 	void Geometry::draw(Shader &shader, Camera &camera) {
 
-		// Activate the VAO and the shader to access the uniforms.
+		this->draw(shader, camera, this->writeDrawData());
+
+	}
+
+	void Geometry::draw(Shader &shader, Camera &camera, GLintptr draw_offset) {
+
+		// Set everything up.
+		this->prepareDraw(shader, draw_offset);
+
+		// Draw the actual Geometry from its range of the arena, at the level of
+		// detail its size on the screen needs.
+		ArenaRange range = this->mesh->getRange(this->selectLOD(camera));
+		GeometryArena &arena = this->mesh->getArena();
+		glDrawElementsBaseVertex(GL_TRIANGLES, (GLsizei) range.index_count, arena.getIndexType(), arena.getIndexOffset(range), (GLint) range.first_vertex);
+		GLState::countDraw(range.index_count / 3);
+
+	}
+
+	bool Geometry::canBatchWith(const Geometry &other) const {
+
+		// They must read the same buffers and have no instances.
+		if (&this->mesh->getArena() != &other.mesh->getArena() || this->instances_linked || other.instances_linked)
+			return false;
+
+		// Everything passed to the shader must match, as one call cannot change it.
+		if (this->transforms != other.transforms || this->spin_pivot != other.spin_pivot || this->spin_axis != other.spin_axis)
+			return false;
+
+		if (std::memcmp(&this->material, &other.material, sizeof(MaterialData)) != 0)
+			return false;
+
+		if (this->textures.size() != other.textures.size())
+			return false;
+
+		for (size_t i = 0; i < this->textures.size(); i++) {
+
+			if (this->textures[i].getID() != other.textures[i].getID() || this->textures[i].getSlot() != other.textures[i].getSlot())
+				return false;
+
+		}
+
+		return true;
+
+	}
+
+	void Geometry::drawBatch(std::span<Geometry* const> geometries, Shader &shader, Camera &camera, GLintptr draw_offset) {
+
+		if (geometries.empty())
+			return;
+
+		if (geometries.size() == 1) {
+
+			geometries[0]->draw(shader, camera, draw_offset);
+			return;
+
+		}
+
+		// The first one sets the state for all of them.
+		geometries[0]->prepareDraw(shader, draw_offset);
+
+		// Gather the range of each one.
+		GeometryArena &arena = geometries[0]->mesh->getArena();
+		std::vector<GLsizei> counts(geometries.size());
+		std::vector<void*> offsets(geometries.size());
+		std::vector<GLint> base_vertices(geometries.size());
+		size_t triangles = 0;
+
+		for (size_t i = 0; i < geometries.size(); i++) {
+
+			ArenaRange range = geometries[i]->mesh->getRange(geometries[i]->selectLOD(camera));
+			counts[i] = (GLsizei) range.index_count;
+			offsets[i] = arena.getIndexOffset(range);
+			base_vertices[i] = (GLint) range.first_vertex;
+			triangles += range.index_count / 3;
+
+		}
+
+		// Draw all of them at once.
+		glMultiDrawElementsBaseVertex(GL_TRIANGLES, counts.data(), arena.getIndexType(), offsets.data(), (GLsizei) geometries.size(), base_vertices.data());
+		GLState::countDraw(triangles);
+
+	}
+
+	void Geometry::drawInstanced(Shader &shader, Camera &camera, GLintptr draw_offset) {
+
+		if (this->instance_count == 0)
+			return;
+
+		// Set everything up.
+		this->prepareDraw(shader, draw_offset);
+
+		// Draw all the instances at once, at the level of detail the closest one needs.
+		size_t level = this->selectLOD(camera, this->getWorldBoundingBox(), getMaxScale(this->transforms) * this->instance_scale);
+		ArenaRange range = this->mesh->getRange(level);
+		GeometryArena &arena = this->mesh->getArena();
+		glDrawElementsInstancedBaseVertex(GL_TRIANGLES, (GLsizei) range.index_count, arena.getIndexType(), arena.getIndexOffset(range), this->instance_count, (GLint) range.first_vertex);
+		GLState::countDraw(range.index_count / 3 * this->instance_count);
+
+	}
+
+	size_t Geometry::getInstanceCount() const {
+
+		return this->instance_count;
+
+	}
+
+	void Geometry::setInstances(std::span<const InstanceData> instances) {
+
+		// Without instances, drop the buffer and draw through the arena VAO again.
+		if (instances.empty()) {
+
+			this->instance_vao.reset();
+			this->instance_vbo.remove();
+			this->instances_linked = false;
+
+			this->instance_count = 0;
+			this->instance_models.clear();
+			this->instance_scale = 1.0f;
+
+			return;
+
+		}
+
+		GLsizeiptr size = (GLsizeiptr) instances.size_bytes();
+
+		if (this->instances_linked) {
+
+			// Reuse the buffer.
+			this->instance_vbo.update(instances.data(), size, GL_DYNAMIC_DRAW);
+
+		} else {
+
+			// Create the buffer and a VAO of its own reading it.
+			this->instance_vbo = VBO(instances.data(), size, GL_DYNAMIC_DRAW);
+			this->linkInstances();
+
+			this->instances_linked = true;
+
+		}
+
+		this->instance_count = (GLsizei) instances.size();
+
+		// Keep where they are to bound them, and their largest scale to pick
+		// the level of detail.
+		this->instance_models.clear();
+		this->instance_scale = getMaxScale(instances[0].model);
+
+		for (const InstanceData &instance : instances) {
+
+			this->instance_models.push_back(instance.model);
+			this->instance_scale = std::max(this->instance_scale, getMaxScale(instance.model));
+
+		}
+
+	}
+
+	size_t Geometry::selectLOD(Camera &camera) {
+
+		return this->selectLOD(camera, this->getWorldBoundingBox(), getMaxScale(this->transforms));
+
+	}
+
+	size_t Geometry::selectLOD(Camera &camera, const BoundingBox &world_box, float scale) const {
+
+		const std::vector<MeshLOD> &lods = this->mesh->getLODs();
+		if (lods.size() == 1)
+			return 0;
+
+		// Get the distance to the closest point of the box. Inside it, draw it all.
+		const glm::vec3 &eye = camera.getPosition();
+		float distance = glm::distance(eye, glm::clamp(eye, world_box.min, world_box.max));
+		if (distance <= 0.0f)
+			return 0;
+
+		// Pixels a unit of model space spans on the screen at that distance.
+		float pixels_per_unit = camera.getProjection()[1][1] * camera.getHeight() * 0.5f * scale / distance;
+
+		// Take the coarsest level whose error stays under the threshold.
+		size_t level = 0;
+		while (level + 1 < lods.size() && lods[level + 1].error * pixels_per_unit <= Geometry::lod_threshold)
+			level++;
+
+		return level;
+
+	}
+
+	float Geometry::getLODThreshold() {
+
+		return Geometry::lod_threshold;
+
+	}
+
+	void Geometry::setLODThreshold(float pixels) {
+
+		Geometry::lod_threshold = pixels;
+
+	}
+
+	void Geometry::setSpin(glm::vec3 pivot, glm::vec3 axis) {
+
+		this->spin_pivot = pivot;
+		this->spin_axis = axis;
+
+	}
+
+	void Geometry::linkInstances() {
+
+		if (!this->instance_vao)
+			this->instance_vao.emplace();
+
+		// Link the arena, then the instances on top.
+		// A mat4 takes four attribute locations, one per column.
+		GeometryArena &arena = this->mesh->getArena();
+		arena.link(*this->instance_vao);
+
+		for (GLuint column = 0; column < 4; column++)
+			this->instance_vao->link_instance_attribute(this->instance_vbo, 5 + column, 4, GL_FLOAT, sizeof(InstanceData), (void*)(column * sizeof(glm::vec4)));
+		this->instance_vao->link_instance_attribute(this->instance_vbo, 9, 1, GL_FLOAT, sizeof(InstanceData), (void*)offsetof(InstanceData, phase));
+
+		this->instance_vao->unbind();
+		this->instance_generation = arena.getGeneration();
+
+	}
+
+	void Geometry::prepareDraw(Shader &shader, GLintptr draw_offset) {
+
+		// Pick the cheapest permutation for the material and activate it to
+		// access the uniforms.
+		shader.setFeatures(this->getFeatures());
 		shader.activate();
-		vao.bind();
+
+		// Bind the VAO, linking the instances again if the arena grew since.
+		// Every geometry without instances binds the same one.
+		if (this->instances_linked && this->instance_generation != this->mesh->getArena().getGeneration())
+			this->linkInstances();
+
+		this->getVAO().bind();
+
+		// Without an instance buffer the instance attributes read these constants,
+		// so the instance model is the identity and the phase is 0. They are set
+		// on every draw, as drawing from the instance arrays leaves them undefined.
+		if (!this->instances_linked) {
+
+			glVertexAttrib4f(5, 1.0f, 0.0f, 0.0f, 0.0f);
+			glVertexAttrib4f(6, 0.0f, 1.0f, 0.0f, 0.0f);
+			glVertexAttrib4f(7, 0.0f, 0.0f, 1.0f, 0.0f);
+			glVertexAttrib4f(8, 0.0f, 0.0f, 0.0f, 1.0f);
+			glVertexAttrib1f(9, 0.0f);
+
+		}
+
+		// Packed vertices read a white color, so only the material colors them.
+		// Unpacked meshes read colors from an array, which leaves it undefined.
+		if (this->mesh->isPacked())
+			glVertexAttrib4f(2, 1.0f, 1.0f, 1.0f, 1.0f);
 
 		for (size_t i = 0; i < textures.size(); i++) {
 
-			std::string name = textures[i].getName();
-			std::string id = "";
-			
             textures[i].bind();
 			shader.passTexture(textures[i]);
 
 		}
 
-		// Pass the camera to the shader.
-		shader.passCamera(camera);
-        
-        // Pass the shininess to the shader.
-        shader.passFloat("materialShininess", this->shininess);
-        
-		// Get the model matrix and pass it.
-		glm::mat4 model = this->transforms;
-		glUniformMatrix4fv(glGetUniformLocation(shader.getProgramID(), "Model"), 1, GL_FALSE, glm::value_ptr(model));
+		// Upload the material only if it changed and bind it.
+		// The camera and the light are already in the Frame block.
+		if (this->material_dirty) {
+
+			this->material_ubo.update(&this->material, sizeof(MaterialData));
+			this->material_dirty = false;
+
+		}
+		this->material_ubo.bind();
 
-		// Get the View matrix and compute the modelView;
-		glm::mat4 view = camera.getView();
-		glm::mat4 model_view = view * model;
-		glUniformMatrix4fv(glGetUniformLocation(shader.getProgramID(), "modelView"), 1, GL_FALSE, glm::value_ptr(model_view));
+		// Point the Draw block to the model matrix and the rest.
+		Geometry::getDrawBuffer().bindRange(draw_offset, sizeof(DrawData));
 
-		// Get the normal matrix and pass it.
-		glm::mat4 normal_matrix = glm::transpose(glm::inverse(model_view));
-		glUniformMatrix4fv(glGetUniformLocation(shader.getProgramID(), "normalMatrix"), 1, GL_FALSE, glm::value_ptr(normal_matrix));
+	}
+
+	GLintptr Geometry::writeDrawData() const {
+
+		RingBuffer &draw_buffer = Geometry::getDrawBuffer();
+		DrawData data = this->getDrawData();
 
-		// Draw the actual Geometry
-		glDrawElements(GL_TRIANGLES, (GLsizei) indices.size(), GL_UNSIGNED_INT, 0);
+		GLintptr offset;
+		std::memcpy(draw_buffer.map(sizeof(DrawData), &offset), &data, sizeof(DrawData));
+		draw_buffer.unmap();
+
+		return offset;
 
 	}
 
-	BoundingBox Geometry::getBoundingBox() {
+	BoundingBox Geometry::getBoundingBox() const {
+
+		return this->mesh->getBoundingBox();
 
-		// Create the bb.
-		BoundingBox bb;
+	}
 
-		// Init the bounding box with the first vertex.
-		bb.min = glm::vec3(this->vertices[0].position.x, this->vertices[0].position.y, this->vertices[0].position.z);
-		bb.max = glm::vec3(this->vertices[0].position.x, this->vertices[0].position.y, this->vertices[0].position.z);
+	RingBuffer& Geometry::getDrawBuffer() {
 
-		// Loop through the vertices and get tge min and max values.
-		for (int i = 1; i < this->vertices.size(); i++) {
+		static RingBuffer draw_buffer(DrawData::binding);
+		return draw_buffer;
 
-			if (bb.min.x > this->vertices[i].position.x)
-				bb.min.x = this->vertices[i].position.x;
+	}
 
-			if (bb.min.y > this->vertices[i].position.y)
-				bb.min.y = this->vertices[i].position.y;
+	DrawData Geometry::getDrawData() const {
 
-			if (bb.min.z > this->vertices[i].position.z)
-				bb.min.z = this->vertices[i].position.z;
+		DrawData data;
+		data.model = this->transforms;
 
-			if (bb.max.x < this->vertices[i].position.x)
-				bb.max.x = this->vertices[i].position.x;
+		// The View is a rigid transform, so the shader can apply it to normals as is.
+		data.normal_matrix = glm::transpose(glm::inverse(this->transforms));
 
-			if (bb.max.y < this->vertices[i].position.y)
-				bb.max.y = this->vertices[i].position.y;
+		data.spin_pivot = glm::vec4(this->spin_pivot, 0.0f);
+		data.spin_axis = glm::vec4(this->spin_axis, 0.0f);
 
-			if (bb.max.z < this->vertices[i].position.z)
-				bb.max.z = this->vertices[i].position.z;
+		return data;
 
-		}
+	}
+
+	BoundingBox Geometry::getWorldBoundingBox() const {
+
+		BoundingBox box = transformBox(this->mesh->getBoundingBox(), this->transforms);
+		if (this->instance_models.empty())
+			return box;
+
+		// The instances are placed on top of the transforms, so each one moves
+		// the whole box.
+		BoundingBox instances_box = transformBox(box, this->instance_models[0]);
+		for (size_t i = 1; i < this->instance_models.size(); i++)
+			instances_box = AABBKernel::merge(instances_box, transformBox(box, this->instance_models[i]));
+
+		return instances_box;
+
+	}
+
+	unsigned int Geometry::getFeatures() const {
+
+		return Shader::selectFeatures(this->material, !this->textures.empty());
+
+	}
+
+	bool Geometry::isTransparent() const {
 
-		return bb;
+		return this->material.color.a < 1.0f;
 
 	}
 
@@ -16,20 +16,31 @@
 #ifndef BGQ_OPENGL_CLASSES_GEOMETRY_H_
 #define BGQ_OPENGL_CLASSES_GEOMETRY_H_
 
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <span>
 #include <vector>
 
 #include "GL/glew.h"
 #include "glm/glm.hpp"
 #include "glm/gtc/type_ptr.hpp"
 
+#include "classes/async_loader/async_loader.h"
 #include "classes/camera/camera.h"
 #include "classes/shader/shader.h"
 #include "classes/texture/texture.h"
-#include "classes/ebo/ebo.h"
+#include "classes/mesh/mesh.h"
+#include "classes/ring_buffer/ring_buffer.h"
 #include "classes/vbo/vbo.h"
+#include "classes/ubo/ubo.h"
 #include "classes/vao/vao.h"
 #include "structs/vertex/vertex.h"
 #include "structs/bounding_box/bounding_box.h"
+#include "structs/draw_data/draw_data.h"
+#include "structs/instance_data/instance_data.h"
+#include "structs/material_data/material_data.h"
+#include "structs/texture_options/texture_options.h"
 
 namespace bgq_opengl {
 
@@ -48,7 +59,8 @@ namespace bgq_opengl {
 			/**
 			 * @brief Initializes the Geometry.
 			 * 
-			 * Initializes the geometry and stores it.
+			 * Initializes the geometry and stores it, keeping a copy of the
+			 * vertices and indices.
 			 * 
 			 * @param vertices Vertices of the object.
 			 * @param indices Indices of the vertices.
@@ -56,33 +68,87 @@ namespace bgq_opengl {
 			 */
 			Geometry(const std::vector<Vertex> &vertices, const std::vector<GLuint> &indices, const std::vector<Texture> &textures, const float shininess);
 
+			/**
+			 * @brief Initializes the Geometry from a shared mesh.
+			 *
+			 * Initializes the geometry on top of a mesh that may be shared with
+			 * other geometries. Only the material, transforms and instances are
+			 * its own; the VAO is the one of the arena of the mesh.
+			 *
+			 * @param mesh The mesh with the vertices and indices.
+			 * @param textures Textures in connection with this geometry.
+			 * @param shininess The shininess of the material.
+			 * @param color The diffuse color of the material, applied over the vertex colors.
+			 */
+			Geometry(std::shared_ptr<Mesh> mesh, const std::vector<Texture> &textures, const float shininess,
+				glm::vec3 color = glm::vec3(1.0f, 1.0f, 1.0f));
+
 			/**
 			 * @brief Get the indices of the geometry.
 			 *
-			 * Get the indices of the geometry.
+			 * Get the indices of the geometry without copying them. They are
+			 * empty unless the mesh was built keeping them.
+			 *
+			 * @returns A read-only reference to the indices.
+			 */
+			const std::vector<GLuint>& getIndices() const;
+
+			/**
+			 * @brief Get the mesh.
+			 *
+			 * Get the mesh holding the vertices and indices of the geometry.
+			 *
+			 * @returns The shared mesh.
 			 */
-			std::vector<GLuint> getIndices();
+			const std::shared_ptr<Mesh>& getMesh() const;
 			
 			/**
 			 * @brief Get the textures.
 			 *
-			 * Get the textures.
+			 * Get the textures without copying them.
+			 *
+			 * @returns A read-only reference to the textures.
 			 */
-			std::vector<Texture> getTextures();
+			const std::vector<Texture>& getTextures() const;
 			
 			/**
 			 * @brief Get the VAO.
 			 *
-			 * Get the VAO.
+			 * Get the VAO the geometry draws with. That is the one of the arena
+			 * of the mesh, unless it has instances.
+			 *
+			 * @returns A reference to the VAO.
 			 */
-			VAO getVAO();
+			VAO& getVAO();
 			
 			/**
 			 * @brief Get the vertices of the geometry.
 			 *
-			 * Get the vertices of the geometry.
+			 * Get the vertices of the geometry without copying them. They are
+			 * empty unless the mesh was built keeping them.
+			 *
+			 * @returns A read-only reference to the vertices.
 			 */
-			std::vector<Vertex> getVertices();
+			const std::vector<Vertex>& getVertices() const;
+        
+            /**
+             * @brief Get the material.
+             *
+             * Get the material parameters of the geometry.
+             *
+             * @returns The material.
+             */
+            const MaterialData& getMaterial() const;
+        
+            /**
+             * @brief Set the material.
+             *
+             * Set the material parameters of the geometry. They are uploaded on
+             * the next draw.
+             *
+             * @param material The material.
+             */
+            void setMaterial(const MaterialData &material);
         
             /**
              * @brief Get the object shininess.
@@ -119,28 +185,202 @@ namespace bgq_opengl {
             /**
              * @brief Add a new texture to the geometry.
              *
-             * Add a new texture that will be passed to the shader.
+             * Add a new texture that will be passed to the shader. An image
+             * already loaded with the same options is reused.
              *
              * @param image Image containing the texture.
              * @param name Texture type.
+             * @param options How the image is loaded and sampled.
+             * @param loader Loader to decode the image in the background, or null to load it now.
              */
-            void addTexture(const char* image, const char* name);
+            void addTexture(const char* image, const char* name, const TextureOptions &options = TextureOptions(), AsyncLoader *loader = nullptr);
 
 			/**
 			 * @brief Draws the Geometry.
 			 *
-			 * Displays the Geometry in OpenGL.
+			 * Displays the Geometry in OpenGL. Its draw data is written to the
+			 * draw buffer first.
 			 */
 			void draw(Shader &shader, Camera &camera);
 
+			/**
+			 * @brief Draws the Geometry with data already written.
+			 *
+			 * Displays the Geometry in OpenGL, reading the draw data from a block
+			 * of the draw buffer that was written before, with all the others of
+			 * the frame.
+			 *
+			 * @param shader The shader that will draw the geometry.
+			 * @param camera The camera.
+			 * @param draw_offset The offset of the draw data in the draw buffer.
+			 */
+			void draw(Shader &shader, Camera &camera, GLintptr draw_offset);
+
+			/**
+			 * @brief Checks if two geometries can be drawn in one call.
+			 *
+			 * Checks if another geometry reads the same arena and passes the
+			 * same uniforms, material and textures, so both can go in one
+			 * drawBatch. Geometries with instances never can.
+			 *
+			 * @param other The other geometry.
+			 *
+			 * @returns True if they can be drawn together.
+			 */
+			bool canBatchWith(const Geometry &other) const;
+
+			/**
+			 * @brief Draws some geometries in one call.
+			 *
+			 * Draws geometries that can all be batched with the first one with a
+			 * single glMultiDrawElementsBaseVertex, using the state of the first.
+			 * They share their draw data, as they share their transforms.
+			 *
+			 * @param geometries The geometries.
+			 * @param shader The shader that will draw them.
+			 * @param camera The camera.
+			 * @param draw_offset The offset of the draw data in the draw buffer.
+			 */
+			static void drawBatch(std::span<Geometry* const> geometries, Shader &shader, Camera &camera, GLintptr draw_offset);
+
+			/**
+			 * @brief Get the draw buffer.
+			 *
+			 * Get the ring buffer every geometry writes its draw data to. It has
+			 * to be told when a frame ends and removed before the context is.
+			 *
+			 * @returns The draw buffer.
+			 */
+			static RingBuffer& getDrawBuffer();
+
+			/**
+			 * @brief Get the draw data.
+			 *
+			 * Get the data of the Draw block for the current transforms and spin.
+			 *
+			 * @returns The draw data.
+			 */
+			DrawData getDrawData() const;
+
+			/**
+			 * @brief Picks the level of detail to draw.
+			 *
+			 * Picks the coarsest level of detail of the mesh whose error, projected
+			 * on the screen at the distance of the closest point of the geometry,
+			 * stays under the threshold.
+			 *
+			 * @param camera The camera.
+			 *
+			 * @returns The level, 0 for the full mesh.
+			 */
+			size_t selectLOD(Camera &camera);
+
+			/**
+			 * @brief Get the level of detail threshold.
+			 *
+			 * Get the largest error, in pixels, a level of detail may show.
+			 *
+			 * @returns The threshold.
+			 */
+			static float getLODThreshold();
+
+			/**
+			 * @brief Set the level of detail threshold.
+			 *
+			 * Set the largest error, in pixels, a level of detail may show, for
+			 * every geometry. 0 always draws the full meshes.
+			 *
+			 * @param pixels The threshold.
+			 */
+			static void setLODThreshold(float pixels);
+
+			/**
+			 * @brief Draws every instance of the Geometry.
+			 *
+			 * Displays all the instances set with setInstances in a single call,
+			 * reading the draw data from a block of the draw buffer that was
+			 * written before. The vertices and indices are shared, only the
+			 * instance data changes.
+			 *
+			 * @param shader The shader that will draw the geometry.
+			 * @param camera The camera.
+			 * @param draw_offset The offset of the draw data in the draw buffer.
+			 */
+			void drawInstanced(Shader &shader, Camera &camera, GLintptr draw_offset);
+
+			/**
+			 * @brief Get the number of instances.
+			 *
+			 * Get the number of instances drawn by drawInstanced.
+			 *
+			 * @returns The number of instances.
+			 */
+			size_t getInstanceCount() const;
+
+			/**
+			 * @brief Set the instances.
+			 *
+			 * Uploads the per instance data to the instance buffer. Their model
+			 * matrices are applied on top of the one of the geometry and are
+			 * expected to have a uniform scale, as the normal matrix is not
+			 * corrected for them. After this, draw() uses the first instance.
+			 * An empty list removes the instances and their buffer.
+			 *
+			 * @param instances The data of every instance.
+			 */
+			void setInstances(std::span<const InstanceData> instances);
+
+			/**
+			 * @brief Set the spin of the geometry.
+			 *
+			 * Sets the pivot and axis, in model space, the phase of each instance
+			 * rotates the geometry around. A zero axis disables it.
+			 *
+			 * @param pivot The point it spins around.
+			 * @param axis The axis it spins around.
+			 */
+			void setSpin(glm::vec3 pivot, glm::vec3 axis);
+
 			/**
 			 * @brief Gets the bounding box.
 			 * 
-			 * Gets the bounding box of the geometry.
+			 * Gets the bounding box of the geometry in model space. It is computed
+			 * when the vertices are set, so this does not touch the vertices.
 			 * 
 			 * @returns The bounding box struct.
 			 */
-			BoundingBox getBoundingBox();
+			BoundingBox getBoundingBox() const;
+
+			/**
+			 * @brief Gets the transformed bounding box.
+			 *
+			 * Gets the axis-aligned box that encloses the model space bounding box
+			 * once the current transform matrix is applied to it. With instances,
+			 * it encloses every one of them.
+			 *
+			 * @returns The bounding box struct.
+			 */
+			BoundingBox getWorldBoundingBox() const;
+
+			/**
+			 * @brief Gets the shader features the geometry needs.
+			 *
+			 * Gets the cheapest shader permutation for the material and textures
+			 * of the geometry.
+			 *
+			 * @returns A mask of Shader features.
+			 */
+			unsigned int getFeatures() const;
+
+			/**
+			 * @brief Checks if the geometry is see-through.
+			 *
+			 * Checks if the material color is not fully opaque, in which case it
+			 * has to be blended over what is behind it.
+			 *
+			 * @returns True if it is transparent.
+			 */
+			bool isTransparent() const;
 
 			/**
 			 * @brief Reset
@@ -192,12 +432,59 @@ namespace bgq_opengl {
 			 */
 			void updateNormalMatrix();
 
-			std::vector<GLuint> indices;				/// Indices of the vertices.
+			/**
+			 * @brief Picks the level of detail to draw for a box.
+			 *
+			 * @param camera The camera.
+			 * @param world_box The box drawn, in world space.
+			 * @param scale The largest scale from model to world space.
+			 *
+			 * @returns The level, 0 for the full mesh.
+			 */
+			size_t selectLOD(Camera &camera, const BoundingBox &world_box, float scale) const;
+
+			/**
+			 * @brief Links the instance VAO.
+			 *
+			 * Links the arena of the mesh and the instance buffer to the VAO used
+			 * for instances, creating it if needed.
+			 */
+			void linkInstances();
+
+			/**
+			 * @brief Prepares the state shared by both draw calls.
+			 *
+			 * Binds the VAO, textures, material and draw data.
+			 *
+			 * @param shader The shader that will draw the geometry.
+			 * @param draw_offset The offset of the draw data in the draw buffer.
+			 */
+			void prepareDraw(Shader &shader, GLintptr draw_offset);
+
+			/**
+			 * @brief Writes the draw data to the draw buffer.
+			 *
+			 * @returns The offset of the draw data in the draw buffer.
+			 */
+			GLintptr writeDrawData() const;
+
+			std::shared_ptr<Mesh> mesh;					/// Vertices and indices, maybe shared.
 			std::vector<Texture> textures;				/// Textures that will color this geometry.
-			VAO vao;									/// VAO containing this object.
-			std::vector<Vertex> vertices;				/// Geometry vertices.
 			glm::mat4 transforms = glm::mat4(1.0f);		/// Tranform matrixes that will be passed to the shader.
-            float shininess = 1.0;
+			MaterialData material;						/// Material parameters of the geometry.
+			UBO material_ubo;							/// Uniform buffer holding the material.
+			bool material_dirty = true;					/// Whether the material has to be uploaded again.
+			glm::vec3 spin_pivot = glm::vec3(0.0f);		/// Point the instances spin around.
+			glm::vec3 spin_axis = glm::vec3(0.0f);		/// Axis the instances spin around. Zero for none.
+			VBO instance_vbo;							/// Per instance data.
+			std::optional<VAO> instance_vao;			/// Reads the arena and the instance buffer, once there is one.
+			unsigned int instance_generation = 0;		/// Generation of the arena the instance VAO is linked to.
+			GLsizei instance_count = 0;					/// Number of instances in the buffer.
+			std::vector<glm::mat4> instance_models;		/// Model matrix of every instance, to bound them.
+			float instance_scale = 1.0f;				/// Largest scale of the instances.
+			bool instances_linked = false;				/// Whether the instance buffer is linked to the VAO.
+
+			static float lod_threshold;					/// Largest error a level of detail may show, in pixels.
 
 	};
 
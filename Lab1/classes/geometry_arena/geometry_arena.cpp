@@ -0,0 +1,258 @@
+/**
+ * @file geometry_arena.cpp
+ * @brief GeometryArena class implementation file.
+ * @version 1.0.0 (2026-10-17)
+ * @date 2026-10-17
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#include "geometry_arena.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "GL/glew.h"
+
+#include "classes/ebo/ebo.h"
+#include "classes/gl_state/gl_state.h"
+#include "classes/resource_registry/resource_registry.h"
+#include "classes/vao/vao.h"
+#include "classes/vbo/vbo.h"
+#include "structs/arena_range/arena_range.h"
+#include "structs/packed_vertex/packed_vertex.h"
+#include "structs/vertex/vertex.h"
+
+namespace bgq_opengl {
+
+	GeometryArena::GeometryArena(bool packed, GLenum index_type) {
+
+		this->packed = packed;
+		this->index_type = index_type;
+		this->vertex_size = packed ? sizeof(PackedVertex) : sizeof(Vertex);
+		this->index_size = index_type == GL_UNSIGNED_SHORT ? sizeof(GLushort) : sizeof(GLuint);
+
+		this->grow(GeometryArena::initial_vertices, GeometryArena::initial_indices);
+
+	}
+
+	ArenaRange GeometryArena::allocate(const void *vertices, size_t vertex_count, const void *indices, size_t index_count) {
+
+		ArenaRange range;
+		range.vertex_count = vertex_count;
+		range.index_count = index_count;
+
+		// Grow until both fit, at least doubling so it happens rarely.
+		while (!GeometryArena::take(this->free_vertices, vertex_count, &range.first_vertex))
+			this->grow(std::max(this->vertex_capacity * 2, this->vertex_capacity + vertex_count), this->index_capacity);
+
+		while (!GeometryArena::take(this->free_indices, index_count, &range.first_index))
+			this->grow(this->vertex_capacity, std::max(this->index_capacity * 2, this->index_capacity + index_count));
+
+		// Upload through the copy target, which no VAO records.
+		glBindBuffer(GL_COPY_WRITE_BUFFER, this->vertex_buffer.getID());
+		glBufferSubData(GL_COPY_WRITE_BUFFER, (GLintptr) (range.first_vertex * this->vertex_size), (GLsizeiptr) (vertex_count * this->vertex_size), vertices);
+		glBindBuffer(GL_COPY_WRITE_BUFFER, this->index_buffer.getID());
+		glBufferSubData(GL_COPY_WRITE_BUFFER, (GLintptr) (range.first_index * this->index_size), (GLsizeiptr) (index_count * this->index_size), indices);
+		glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+		return range;
+
+	}
+
+	void GeometryArena::free(const ArenaRange &range) {
+
+		GeometryArena::give(this->free_vertices, range.first_vertex, range.vertex_count);
+		GeometryArena::give(this->free_indices, range.first_index, range.index_count);
+
+	}
+
+	std::shared_ptr<GeometryArena> GeometryArena::get(bool packed, GLenum index_type) {
+
+		// The registry only keeps weak references, so an arena is deleted with its
+		// last mesh, while the context is still alive.
+		static ResourceRegistry<GeometryArena> registry;
+		std::string key = std::string(packed ? "packed" : "full") + "|" + std::to_string(index_type);
+
+		return registry.acquire(key, [&]() {
+
+			return std::make_shared<GeometryArena>(packed, index_type);
+
+		});
+
+	}
+
+	unsigned int GeometryArena::getGeneration() const {
+
+		return this->generation;
+
+	}
+
+	GLenum GeometryArena::getIndexType() const {
+
+		return this->index_type;
+
+	}
+
+	void* GeometryArena::getIndexOffset(const ArenaRange &range) const {
+
+		return (void *) (range.first_index * this->index_size);
+
+	}
+
+	VAO& GeometryArena::getVAO() {
+
+		return this->vao;
+
+	}
+
+	void GeometryArena::link(VAO &vao) {
+
+		// The VAO records the index buffer bound while it is.
+		vao.bind();
+		this->index_buffer.bind();
+
+		// Links VBO attributes such as coordinates and colors to VAO.
+		if (this->packed) {
+
+			// Packed vertices have no color, so the shader reads a constant.
+			vao.link_attribute(this->vertex_buffer, 0, 3, GL_FLOAT, sizeof(PackedVertex), (void*)offsetof(PackedVertex, position));
+			vao.link_attribute(this->vertex_buffer, 1, 4, GL_INT_2_10_10_10_REV, sizeof(PackedVertex), (void*)offsetof(PackedVertex, normal), GL_TRUE);
+			vao.link_attribute(this->vertex_buffer, 3, 2, GL_HALF_FLOAT, sizeof(PackedVertex), (void*)offsetof(PackedVertex, uv));
+
+		} else {
+
+			vao.link_attribute(this->vertex_buffer, 0, 3, GL_FLOAT, sizeof(Vertex), (void*)offsetof(Vertex, position));
+			vao.link_attribute(this->vertex_buffer, 1, 3, GL_FLOAT, sizeof(Vertex), (void*)offsetof(Vertex, normal));
+			vao.link_attribute(this->vertex_buffer, 2, 3, GL_FLOAT, sizeof(Vertex), (void*)offsetof(Vertex, color));
+			vao.link_attribute(this->vertex_buffer, 3, 2, GL_FLOAT, sizeof(Vertex), (void*)offsetof(Vertex, uv));
+
+		}
+
+	}
+
+	bool GeometryArena::take(std::vector<Block> &blocks, size_t size, size_t *offset) {
+
+		if (size == 0) {
+
+			*offset = 0;
+			return true;
+
+		}
+
+		for (size_t i = 0; i < blocks.size(); i++) {
+
+			if (blocks[i].size < size)
+				continue;
+
+			*offset = blocks[i].offset;
+			blocks[i].offset += size;
+			blocks[i].size -= size;
+
+			if (blocks[i].size == 0)
+				blocks.erase(blocks.begin() + i);
+
+			return true;
+
+		}
+
+		return false;
+
+	}
+
+	void GeometryArena::give(std::vector<Block> &blocks, size_t offset, size_t size) {
+
+		if (size == 0)
+			return;
+
+		// Keep the blocks sorted, so neighbours are next to each other.
+		auto next = std::lower_bound(blocks.begin(), blocks.end(), offset, [](const Block &block, size_t value) {
+
+			return block.offset < value;
+
+		});
+		next = blocks.insert(next, Block{offset, size});
+
+		// Merge with the block after it.
+		if (next + 1 != blocks.end() && next->offset + next->size == (next + 1)->offset) {
+
+			next->size += (next + 1)->size;
+			blocks.erase(next + 1);
+
+		}
+
+		// Merge with the block before it.
+		if (next != blocks.begin() && (next - 1)->offset + (next - 1)->size == next->offset) {
+
+			(next - 1)->size += next->size;
+			blocks.erase(next);
+
+		}
+
+	}
+
+	void GeometryArena::grow(size_t vertex_capacity, size_t index_capacity) {
+
+		// Creating the index buffer binds it to the bound VAO, so bind none.
+		GLState::bindVertexArray(0);
+
+		if (vertex_capacity > this->vertex_capacity) {
+
+			VBO vertex_buffer(nullptr, (GLsizeiptr) (vertex_capacity * this->vertex_size), GL_STATIC_DRAW);
+			vertex_buffer.unbind();
+
+			// Copy the old vertices on the GPU.
+			if (this->vertex_capacity > 0) {
+
+				glBindBuffer(GL_COPY_READ_BUFFER, this->vertex_buffer.getID());
+				glBindBuffer(GL_COPY_WRITE_BUFFER, vertex_buffer.getID());
+				glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, 0, (GLsizeiptr) (this->vertex_capacity * this->vertex_size));
+
+			}
+
+			GeometryArena::give(this->free_vertices, this->vertex_capacity, vertex_capacity - this->vertex_capacity);
+			this->vertex_buffer = std::move(vertex_buffer);
+			this->vertex_capacity = vertex_capacity;
+
+		}
+
+		if (index_capacity > this->index_capacity) {
+
+			EBO index_buffer(nullptr, (GLsizeiptr) (index_capacity * this->index_size), GL_STATIC_DRAW);
+			index_buffer.unbind();
+
+			// Copy the old indices on the GPU.
+			if (this->index_capacity > 0) {
+
+				glBindBuffer(GL_COPY_READ_BUFFER, this->index_buffer.getID());
+				glBindBuffer(GL_COPY_WRITE_BUFFER, index_buffer.getID());
+				glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, 0, (GLsizeiptr) (this->index_capacity * this->index_size));
+
+			}
+
+			GeometryArena::give(this->free_indices, this->index_capacity, index_capacity - this->index_capacity);
+			this->index_buffer = std::move(index_buffer);
+			this->index_capacity = index_capacity;
+
+		}
+
+		glBindBuffer(GL_COPY_READ_BUFFER, 0);
+		glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+		// Point the VAO to the new buffers and tell everyone else to.
+		this->link(this->vao);
+		this->vao.unbind();
+		this->generation++;
+
+	}
+
+}  // namespace bgq_opengl
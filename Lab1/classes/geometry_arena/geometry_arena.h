@@ -0,0 +1,218 @@
+/**
+ * @file geometry_arena.h
+ * @brief GeometryArena class header file.
+ * @version 1.0.0 (2026-10-17)
+ * @date 2026-10-17
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#ifndef BGQ_OPENGL_CLASSES_GEOMETRY_ARENA_H_
+#define BGQ_OPENGL_CLASSES_GEOMETRY_ARENA_H_
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include "GL/glew.h"
+
+#include "classes/ebo/ebo.h"
+#include "classes/resource_registry/resource_registry.h"
+#include "classes/vao/vao.h"
+#include "classes/vbo/vbo.h"
+#include "structs/arena_range/arena_range.h"
+
+namespace bgq_opengl {
+
+	/**
+	 * @brief Implements a pool of vertices and indices shared by many meshes.
+	 *
+	 * Implements a vertex buffer and an index buffer shared by every mesh of
+	 * one vertex layout and index type, and the VAO reading them. Each mesh takes
+	 * a range of both, so drawing any number of them needs a single VAO bind and
+	 * neighbouring ranges can be drawn with one glMultiDrawElementsBaseVertex.
+	 *
+	 * Ranges are handed out first fit from lists of free blocks, which merge
+	 * again as ranges are freed. When a range does not fit the buffers are
+	 * replaced by bigger ones and the old contents are copied on the GPU. That
+	 * bumps the generation, so VAOs linked elsewhere know to link again.
+	 *
+	 * @author Borja García Quiroga <garcaqub@tcd.ie>
+	 */
+	class GeometryArena {
+
+		public:
+
+			/**
+			 * @brief Creates an empty arena.
+			 *
+			 * Creates the buffers and links the VAO for a vertex layout and an
+			 * index type. Use get() instead, so every mesh of a kind shares one.
+			 *
+			 * @param packed Whether it holds PackedVertex instead of Vertex.
+			 * @param index_type GL_UNSIGNED_SHORT or GL_UNSIGNED_INT.
+			 */
+			GeometryArena(bool packed, GLenum index_type);
+
+			// Ranges point into the buffers, so it cannot be copied or moved.
+			GeometryArena(const GeometryArena&) = delete;
+			GeometryArena& operator=(const GeometryArena&) = delete;
+
+			/**
+			 * @brief Takes a range and fills it.
+			 *
+			 * Takes room for some vertices and indices, growing the buffers if
+			 * needed, and uploads them. No VAO may be bound.
+			 *
+			 * @param vertices The vertices, in the layout of the arena.
+			 * @param vertex_count The number of vertices.
+			 * @param indices The indices, of the type of the arena, relative to the first vertex.
+			 * @param index_count The number of indices.
+			 *
+			 * @returns The range taken.
+			 */
+			ArenaRange allocate(const void *vertices, size_t vertex_count, const void *indices, size_t index_count);
+
+			/**
+			 * @brief Frees a range.
+			 *
+			 * Gives the room of a range back, so later ranges can take it.
+			 *
+			 * @param range The range.
+			 */
+			void free(const ArenaRange &range);
+
+			/**
+			 * @brief Get the arena of a kind of mesh.
+			 *
+			 * Get the arena shared by every mesh with a vertex layout and index
+			 * type, creating it if none is alive.
+			 *
+			 * @param packed Whether the meshes hold PackedVertex instead of Vertex.
+			 * @param index_type GL_UNSIGNED_SHORT or GL_UNSIGNED_INT.
+			 *
+			 * @returns The shared arena.
+			 */
+			static std::shared_ptr<GeometryArena> get(bool packed, GLenum index_type);
+
+			/**
+			 * @brief Get the generation of the buffers.
+			 *
+			 * Get a number that changes every time the buffers are replaced.
+			 *
+			 * @returns The generation.
+			 */
+			unsigned int getGeneration() const;
+
+			/**
+			 * @brief Get the type of the indices.
+			 *
+			 * @returns GL_UNSIGNED_SHORT or GL_UNSIGNED_INT.
+			 */
+			GLenum getIndexType() const;
+
+			/**
+			 * @brief Get the offset of the first index of a range.
+			 *
+			 * Get the offset of the first index of a range in the index buffer,
+			 * as glDrawElements takes it.
+			 *
+			 * @param range The range.
+			 *
+			 * @returns The offset in bytes, as a pointer.
+			 */
+			void* getIndexOffset(const ArenaRange &range) const;
+
+			/**
+			 * @brief Get the VAO.
+			 *
+			 * Get the VAO reading the buffers of the arena.
+			 *
+			 * @returns The VAO.
+			 */
+			VAO& getVAO();
+
+			/**
+			 * @brief Links the buffers to a VAO.
+			 *
+			 * Links the vertex attributes of the layout of the arena and its
+			 * index buffer to a VAO, which is left bound.
+			 *
+			 * @param vao The VAO.
+			 */
+			void link(VAO &vao);
+
+		private:
+
+			/**
+			 * @brief A run of free elements in a buffer.
+			 */
+			struct Block {
+
+				size_t offset;		/// First free element.
+				size_t size;		/// Number of free elements.
+
+			};
+
+			/**
+			 * @brief Takes a run of elements.
+			 *
+			 * Takes the first free block big enough.
+			 *
+			 * @param blocks The free blocks.
+			 * @param size The number of elements.
+			 * @param offset Outputs the first element taken.
+			 *
+			 * @returns True if one was big enough.
+			 */
+			static bool take(std::vector<Block> &blocks, size_t size, size_t *offset);
+
+			/**
+			 * @brief Gives a run of elements back.
+			 *
+			 * Adds a block to the free ones, merging it with its neighbours.
+			 *
+			 * @param blocks The free blocks.
+			 * @param offset The first element.
+			 * @param size The number of elements.
+			 */
+			static void give(std::vector<Block> &blocks, size_t offset, size_t size);
+
+			/**
+			 * @brief Grows the buffers.
+			 *
+			 * Replaces the buffers with bigger ones, copying the contents, and
+			 * links the VAO to them.
+			 *
+			 * @param vertex_capacity The new vertex capacity, in vertices.
+			 * @param index_capacity The new index capacity, in indices.
+			 */
+			void grow(size_t vertex_capacity, size_t index_capacity);
+
+			bool packed;							/// Whether it holds packed vertices.
+			GLenum index_type;						/// Type of the indices.
+			size_t vertex_size;						/// Size of a vertex in bytes.
+			size_t index_size;						/// Size of an index in bytes.
+			size_t vertex_capacity = 0;				/// Vertices the buffer can hold.
+			size_t index_capacity = 0;				/// Indices the buffer can hold.
+			std::vector<Block> free_vertices;		/// Free runs of the vertex buffer.
+			std::vector<Block> free_indices;		/// Free runs of the index buffer.
+			unsigned int generation = 0;			/// Bumped when the buffers are replaced.
+			VBO vertex_buffer;						/// Vertices of every mesh.
+			EBO index_buffer;						/// Indices of every mesh.
+			VAO vao;								/// Reads the buffers.
+
+			static const size_t initial_vertices = 1 << 16;		/// Vertex capacity of a new arena.
+			static const size_t initial_indices = 3 << 16;		/// Index capacity of a new arena.
+
+	};
+
+}  // namespace bgq_opengl
+
+#endif  //!BGQ_OPENGL_CLASSES_GEOMETRY_ARENA_H_
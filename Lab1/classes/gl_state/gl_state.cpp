@@ -0,0 +1,274 @@
+/**
+ * @file gl_state.cpp
+ * @brief GLState class implementation file.
+ * @version 1.0.0 (2026-10-17)
+ * @date 2026-10-17
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#include "gl_state.h"
+
+#include <cstring>
+#include <unordered_map>
+#include <vector>
+
+#include "GL/glew.h"
+
+#include "structs/state_stats/state_stats.h"
+#include "structs/uniform/uniform.h"
+
+namespace bgq_opengl {
+
+	GLuint GLState::program = GLState::unknown;
+	GLuint GLState::vertex_array = GLState::unknown;
+	GLuint GLState::active_slot = GLState::unknown;
+	GLuint GLState::textures[2][GLState::max_slots];
+	GLuint GLState::uniform_buffers[GLState::max_slots];
+	std::unordered_map<GLuint, std::vector<UniformValue>> GLState::uniform_values;
+	StateStats GLState::stats;
+
+	void GLState::activeTexture(GLuint slot) {
+
+		if (GLState::active_slot == slot) {
+
+			GLState::stats.elided++;
+			return;
+
+		}
+
+		glActiveTexture(GL_TEXTURE0 + slot);
+		GLState::active_slot = slot;
+		GLState::stats.issued++;
+
+	}
+
+	void GLState::bindTexture(GLuint slot, GLenum target, GLuint texture) {
+
+		int target_index = GLState::getTargetIndex(target);
+
+		// Untracked targets and slots always go to OpenGL.
+		if (target_index < 0 || slot >= GLState::max_slots) {
+
+			GLState::activeTexture(slot);
+			glBindTexture(target, texture);
+			GLState::stats.issued++;
+			return;
+
+		}
+
+		if (GLState::textures[target_index][slot] == texture) {
+
+			GLState::stats.elided++;
+			return;
+
+		}
+
+		GLState::activeTexture(slot);
+		glBindTexture(target, texture);
+		GLState::textures[target_index][slot] = texture;
+		GLState::stats.issued++;
+
+	}
+
+	void GLState::bindUniformBuffer(GLuint binding, GLuint buffer) {
+
+		// Untracked binding points always go to OpenGL.
+		if (binding >= GLState::max_slots) {
+
+			glBindBufferBase(GL_UNIFORM_BUFFER, binding, buffer);
+			GLState::stats.issued++;
+			return;
+
+		}
+
+		if (GLState::uniform_buffers[binding] == buffer) {
+
+			GLState::stats.elided++;
+			return;
+
+		}
+
+		glBindBufferBase(GL_UNIFORM_BUFFER, binding, buffer);
+		GLState::uniform_buffers[binding] = buffer;
+		GLState::stats.issued++;
+
+	}
+
+	void GLState::bindUniformBufferRange(GLuint binding, GLuint buffer, GLintptr offset, GLsizeiptr size) {
+
+		glBindBufferRange(GL_UNIFORM_BUFFER, binding, buffer, offset, size);
+		GLState::stats.issued++;
+
+		if (binding < GLState::max_slots)
+			GLState::uniform_buffers[binding] = GLState::unknown;
+
+	}
+
+	void GLState::bindVertexArray(GLuint vao) {
+
+		if (GLState::vertex_array == vao) {
+
+			GLState::stats.elided++;
+			return;
+
+		}
+
+		glBindVertexArray(vao);
+		GLState::vertex_array = vao;
+		GLState::stats.issued++;
+
+	}
+
+	void GLState::countDraw(size_t triangles) {
+
+		GLState::stats.draws++;
+		GLState::stats.triangles += (unsigned int) triangles;
+
+	}
+
+	void GLState::forgetProgram(GLuint program) {
+
+		GLState::uniform_values.erase(program);
+
+		// Deleting the program in use leaves it in use until another one is set.
+		if (GLState::program == program)
+			GLState::program = GLState::unknown;
+
+	}
+
+	void GLState::forgetTexture(GLuint texture) {
+
+		// OpenGL unbinds a deleted texture from every slot.
+		for (int target = 0; target < 2; target++)
+			for (GLuint slot = 0; slot < GLState::max_slots; slot++)
+				if (GLState::textures[target][slot] == texture)
+					GLState::textures[target][slot] = 0;
+
+	}
+
+	void GLState::forgetUniformBuffer(GLuint buffer) {
+
+		// OpenGL unbinds a deleted buffer from every binding point.
+		for (GLuint binding = 0; binding < GLState::max_slots; binding++)
+			if (GLState::uniform_buffers[binding] == buffer)
+				GLState::uniform_buffers[binding] = 0;
+
+	}
+
+	void GLState::forgetVertexArray(GLuint vao) {
+
+		// OpenGL binds 0 when the bound VAO is deleted.
+		if (GLState::vertex_array == vao)
+			GLState::vertex_array = 0;
+
+	}
+
+	GLuint GLState::getProgram() {
+
+		return GLState::program;
+
+	}
+
+	StateStats GLState::getStats() {
+
+		return GLState::stats;
+
+	}
+
+	void GLState::invalidate() {
+
+		GLState::program = GLState::unknown;
+		GLState::vertex_array = GLState::unknown;
+		GLState::active_slot = GLState::unknown;
+
+		for (int target = 0; target < 2; target++)
+			for (GLuint slot = 0; slot < GLState::max_slots; slot++)
+				GLState::textures[target][slot] = GLState::unknown;
+
+		for (GLuint binding = 0; binding < GLState::max_slots; binding++)
+			GLState::uniform_buffers[binding] = GLState::unknown;
+
+	}
+
+	void GLState::resetStats() {
+
+		GLState::stats = StateStats();
+
+	}
+
+	bool GLState::uniformChanged(GLuint program, GLint location, const void *value, size_t size) {
+
+		// OpenGL ignores inactive uniforms, so there is nothing to send. They are
+		// counted apart, as no cache was needed to skip them.
+		if (location < 0) {
+
+			GLState::stats.inactive++;
+			return false;
+
+		}
+
+		// The value would go to another program, so it cannot be cached.
+		if (program != GLState::program) {
+
+			GLState::stats.issued++;
+			return true;
+
+		}
+
+		// Get the values of this program, growing them to fit the location.
+		std::vector<UniformValue> &values = GLState::uniform_values[program];
+		if ((size_t) location >= values.size())
+			values.resize(location + 1);
+
+		// Skip it if the same bytes were sent last time.
+		UniformValue &last = values[location];
+		if (last.size == size && std::memcmp(last.data, value, size) == 0) {
+
+			GLState::stats.elided++;
+			return false;
+
+		}
+
+		std::memcpy(last.data, value, size);
+		last.size = size;
+		GLState::stats.issued++;
+
+		return true;
+
+	}
+
+	void GLState::useProgram(GLuint program) {
+
+		if (GLState::program == program) {
+
+			GLState::stats.elided++;
+			return;
+
+		}
+
+		glUseProgram(program);
+		GLState::program = program;
+		GLState::stats.issued++;
+
+	}
+
+	int GLState::getTargetIndex(GLenum target) {
+
+		if (target == GL_TEXTURE_2D)
+			return 0;
+
+		if (target == GL_TEXTURE_CUBE_MAP)
+			return 1;
+
+		return -1;
+
+	}
+
+}  // namespace bgq_opengl
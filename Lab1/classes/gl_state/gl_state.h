@@ -0,0 +1,236 @@
+/**
+ * @file gl_state.h
+ * @brief GLState class header file.
+ * @version 1.0.0 (2026-10-17)
+ * @date 2026-10-17
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#ifndef BGQ_OPENGL_CLASSES_GL_STATE_H_
+#define BGQ_OPENGL_CLASSES_GL_STATE_H_
+
+#include <cstddef>
+#include <unordered_map>
+#include <vector>
+
+#include "GL/glew.h"
+
+#include "structs/state_stats/state_stats.h"
+#include "structs/uniform/uniform.h"
+
+namespace bgq_opengl {
+
+	/**
+	 * @brief Implements a shadow copy of the OpenGL state.
+	 *
+	 * Implements a shadow copy of the OpenGL state that the rest of the classes
+	 * change: the program in use, the bound VAO, the active texture slot, the
+	 * textures bound to each slot and the last values sent to each uniform. Any
+	 * change that would set a value that is already set is skipped, and both the
+	 * issued and the skipped calls are counted.
+	 *
+	 * There is a single OpenGL context, so everything is static.
+	 *
+	 * @author Borja García Quiroga <garcaqub@tcd.ie>
+	 */
+	class GLState {
+
+		public:
+
+			/**
+			 * @brief Sets the active texture slot.
+			 *
+			 * Calls glActiveTexture if the slot is not active already.
+			 *
+			 * @param slot The texture slot, starting at 0.
+			 */
+			static void activeTexture(GLuint slot);
+
+			/**
+			 * @brief Binds a texture to a slot.
+			 *
+			 * Activates the slot and binds the texture to it if it is not bound
+			 * already. Only 2D and cube map textures are tracked.
+			 *
+			 * @param slot The texture slot, starting at 0.
+			 * @param target The texture target.
+			 * @param texture The texture ID. 0 to unbind.
+			 */
+			static void bindTexture(GLuint slot, GLenum target, GLuint texture);
+
+			/**
+			 * @brief Binds a uniform buffer to a binding point.
+			 *
+			 * Calls glBindBufferBase if the buffer is not bound to that point
+			 * already.
+			 *
+			 * @param binding The binding point.
+			 * @param buffer The buffer ID. 0 to unbind.
+			 */
+			static void bindUniformBuffer(GLuint binding, GLuint buffer);
+
+			/**
+			 * @brief Binds part of a uniform buffer to a binding point.
+			 *
+			 * Calls glBindBufferRange. The ranges change every draw, so it is
+			 * never elided, and the binding point is left unknown so the next
+			 * bindUniformBuffer is not elided either.
+			 *
+			 * @param binding The binding point.
+			 * @param buffer The buffer ID.
+			 * @param offset The offset of the range in bytes.
+			 * @param size The size of the range in bytes.
+			 */
+			static void bindUniformBufferRange(GLuint binding, GLuint buffer, GLintptr offset, GLsizeiptr size);
+
+			/**
+			 * @brief Binds a VAO.
+			 *
+			 * Calls glBindVertexArray if the VAO is not bound already.
+			 *
+			 * @param vao The VAO ID. 0 to unbind.
+			 */
+			static void bindVertexArray(GLuint vao);
+
+			/**
+			 * @brief Counts a draw call.
+			 *
+			 * Adds a draw call and the triangles it drew to the counters.
+			 *
+			 * @param triangles The triangles drawn, instances included.
+			 */
+			static void countDraw(size_t triangles);
+
+			/**
+			 * @brief Forgets a deleted program.
+			 *
+			 * Forgets a program and its uniform values so a new program reusing the
+			 * same ID does not inherit them.
+			 *
+			 * @param program The program ID.
+			 */
+			static void forgetProgram(GLuint program);
+
+			/**
+			 * @brief Forgets a deleted texture.
+			 *
+			 * Clears every slot the texture was bound to.
+			 *
+			 * @param texture The texture ID.
+			 */
+			static void forgetTexture(GLuint texture);
+
+			/**
+			 * @brief Forgets a deleted uniform buffer.
+			 *
+			 * Clears every binding point the buffer was bound to.
+			 *
+			 * @param buffer The buffer ID.
+			 */
+			static void forgetUniformBuffer(GLuint buffer);
+
+			/**
+			 * @brief Forgets a deleted VAO.
+			 *
+			 * Clears the VAO if it was the bound one.
+			 *
+			 * @param vao The VAO ID.
+			 */
+			static void forgetVertexArray(GLuint vao);
+
+			/**
+			 * @brief Get the program in use.
+			 *
+			 * Get the program in use according to the shadow state.
+			 *
+			 * @returns The program ID.
+			 */
+			static GLuint getProgram();
+
+			/**
+			 * @brief Get the counters.
+			 *
+			 * Get the number of issued and skipped calls since the last reset.
+			 *
+			 * @returns The counters.
+			 */
+			static StateStats getStats();
+
+			/**
+			 * @brief Forgets the bindings.
+			 *
+			 * Marks the program, VAO, texture and uniform buffer bindings as
+			 * unknown so the next call always reaches OpenGL. Has to be called
+			 * after code that changes them without going through this class.
+			 * Uniform values are kept, as they belong to the programs.
+			 */
+			static void invalidate();
+
+			/**
+			 * @brief Resets the counters.
+			 *
+			 * Resets the counters. Meant to be called at the start of every frame.
+			 */
+			static void resetStats();
+
+			/**
+			 * @brief Checks if a uniform value has to be sent.
+			 *
+			 * Compares a value with the last one sent to the same uniform of the
+			 * program in use and remembers it. Values sent while a different
+			 * program is in use are not cached, as OpenGL would apply them to the
+			 * program in use. Values for inactive uniforms are never sent, and
+			 * counted as inactive rather than elided.
+			 *
+			 * @param program The program the value is meant for.
+			 * @param location The uniform location.
+			 * @param value Pointer to the raw value.
+			 * @param size Size of the value in bytes.
+			 *
+			 * @returns True if the value has to be sent to OpenGL.
+			 */
+			static bool uniformChanged(GLuint program, GLint location, const void *value, size_t size);
+
+			/**
+			 * @brief Uses a program.
+			 *
+			 * Calls glUseProgram if the program is not in use already.
+			 *
+			 * @param program The program ID.
+			 */
+			static void useProgram(GLuint program);
+
+		private:
+
+			/**
+			 * @brief Gets the index of a tracked texture target.
+			 *
+			 * @param target The texture target.
+			 *
+			 * @returns 0 for 2D, 1 for cube maps, -1 for untracked targets.
+			 */
+			static int getTargetIndex(GLenum target);
+
+			static const GLuint max_slots = 32;		/// Number of texture slots tracked.
+			static const GLuint unknown = (GLuint) -1;	/// Marks a binding as unknown.
+
+			static GLuint program;						/// Program in use.
+			static GLuint vertex_array;					/// VAO bound.
+			static GLuint active_slot;					/// Active texture slot.
+			static GLuint textures[2][max_slots];		/// Textures bound per target and slot.
+			static GLuint uniform_buffers[max_slots];	/// Uniform buffers bound per binding point.
+			static std::unordered_map<GLuint, std::vector<UniformValue>> uniform_values;	/// Last values per program and location.
+			static StateStats stats;					/// Counters since the last reset.
+
+	};
+
+}  // namespace bgq_opengl
+
+#endif  //!BGQ_OPENGL_CLASSES_GL_STATE_H_
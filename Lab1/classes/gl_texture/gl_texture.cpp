@@ -0,0 +1,122 @@
+/**
+ * @file gl_texture.cpp
+ * @brief GLTexture class implementation file.
+ * @version 1.0.0 (2026-10-17)
+ * @date 2026-10-17
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#include "gl_texture.h"
+
+#include <utility>
+
+#include "GL/glew.h"
+
+#include "classes/gl_state/gl_state.h"
+#include "classes/resource_registry/resource_registry.h"
+
+namespace bgq_opengl {
+
+	GLTexture::GLTexture(GLenum target) {
+
+		this->target = target;
+		glGenTextures(1, &this->ID);
+
+	}
+
+	GLTexture::GLTexture(GLTexture &&other) noexcept {
+
+		*this = std::move(other);
+
+	}
+
+	GLTexture::~GLTexture() {
+
+		this->remove();
+
+	}
+
+	GLTexture& GLTexture::operator=(GLTexture &&other) noexcept {
+
+		if (this != &other) {
+
+			// Free ours and take theirs.
+			this->remove();
+			this->ID = other.ID;
+			this->target = other.target;
+			this->width = other.width;
+			this->height = other.height;
+			this->channels = other.channels;
+			other.ID = 0;
+
+		}
+
+		return *this;
+
+	}
+
+	int GLTexture::getChannels() const {
+
+		return this->channels;
+
+	}
+
+	int GLTexture::getHeight() const {
+
+		return this->height;
+
+	}
+
+	GLuint GLTexture::getID() const {
+
+		return this->ID;
+
+	}
+
+	ResourceRegistry<GLTexture>& GLTexture::getRegistry() {
+
+		static ResourceRegistry<GLTexture> registry;
+		return registry;
+
+	}
+
+	GLenum GLTexture::getTarget() const {
+
+		return this->target;
+
+	}
+
+	int GLTexture::getWidth() const {
+
+		return this->width;
+
+	}
+
+	void GLTexture::setSize(int width, int height, int channels) {
+
+		this->width = width;
+		this->height = height;
+		this->channels = channels;
+
+	}
+
+	void GLTexture::remove() {
+
+		// Delete it only once.
+		if (this->ID == 0)
+			return;
+
+		glDeleteTextures(1, &this->ID);
+		GLState::forgetTexture(this->ID);
+		this->ID = 0;
+
+	}
+
+}  // namespace bgq_opengl
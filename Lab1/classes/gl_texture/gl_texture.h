@@ -0,0 +1,163 @@
+/**
+ * @file gl_texture.h
+ * @brief GLTexture class header file.
+ * @version 1.0.0 (2026-10-17)
+ * @date 2026-10-17
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#ifndef BGQ_OPENGL_CLASSES_GL_TEXTURE_H_
+#define BGQ_OPENGL_CLASSES_GL_TEXTURE_H_
+
+#include "GL/glew.h"
+
+#include "classes/resource_registry/resource_registry.h"
+
+namespace bgq_opengl {
+
+	/**
+	 * @brief Owns a texture in OpenGL.
+	 *
+	 * Owns the OpenGL name of a texture and deletes it when destroyed. It can be
+	 * moved but not copied. Texture and Cubemap share them through the registry,
+	 * so an image loaded twice is only uploaded once.
+	 *
+	 * @author Borja García Quiroga <garcaqub@tcd.ie>
+	 */
+	class GLTexture {
+
+		public:
+
+			/**
+			 * @brief Creates a texture in OpenGL.
+			 *
+			 * Generates a new texture name. Its contents are up to the caller.
+			 *
+			 * @param target The texture target (GL_TEXTURE_2D, GL_TEXTURE_CUBE_MAP...).
+			 */
+			GLTexture(GLenum target);
+
+			/**
+			 * @brief Moves a texture.
+			 *
+			 * Takes the OpenGL texture of another GLTexture, which is left empty.
+			 *
+			 * @param other The GLTexture to move from.
+			 */
+			GLTexture(GLTexture &&other) noexcept;
+
+			/**
+			 * @brief Destroys the texture.
+			 *
+			 * Deletes the OpenGL texture, if it still has one.
+			 */
+			~GLTexture();
+
+			// Copies would delete the same OpenGL texture twice.
+			GLTexture(const GLTexture&) = delete;
+			GLTexture& operator=(const GLTexture&) = delete;
+
+			/**
+			 * @brief Moves a texture.
+			 *
+			 * Deletes the OpenGL texture of this GLTexture and takes the one of
+			 * another, which is left empty.
+			 *
+			 * @param other The GLTexture to move from.
+			 *
+			 * @returns This GLTexture.
+			 */
+			GLTexture& operator=(GLTexture &&other) noexcept;
+
+			/**
+			 * @brief Get the number of channels.
+			 *
+			 * Get the number of channels of the source image.
+			 *
+			 * @returns The number of channels.
+			 */
+			int getChannels() const;
+
+			/**
+			 * @brief Get the height.
+			 *
+			 * Get the height of the texture in pixels.
+			 *
+			 * @returns The height.
+			 */
+			int getHeight() const;
+
+			/**
+			 * @brief Get the ID.
+			 *
+			 * Get the OpenGL name of the texture.
+			 *
+			 * @returns The ID. 0 if it was moved from.
+			 */
+			GLuint getID() const;
+
+			/**
+			 * @brief Get the registry of textures.
+			 *
+			 * Get the registry shared by every texture loaded from a file.
+			 *
+			 * @returns The registry.
+			 */
+			static ResourceRegistry<GLTexture>& getRegistry();
+
+			/**
+			 * @brief Get the target.
+			 *
+			 * Get the texture target.
+			 *
+			 * @returns The target.
+			 */
+			GLenum getTarget() const;
+
+			/**
+			 * @brief Get the width.
+			 *
+			 * Get the width of the texture in pixels.
+			 *
+			 * @returns The width.
+			 */
+			int getWidth() const;
+
+			/**
+			 * @brief Set the size.
+			 *
+			 * Stores the size of the source image once it is loaded.
+			 *
+			 * @param width The width in pixels.
+			 * @param height The height in pixels.
+			 * @param channels The number of channels.
+			 */
+			void setSize(int width, int height, int channels);
+
+		private:
+
+			/**
+			 * @brief Deletes the texture.
+			 *
+			 * Deletes the OpenGL texture, if it still has one.
+			 */
+			void remove();
+
+			GLuint ID = 0;				/// Texture OpenGL ID.
+			GLenum target = 0;			/// Texture target.
+			int width = 0;				/// Width in pixels.
+			int height = 0;				/// Height in pixels.
+			int channels = 0;			/// Number of channels of the source.
+
+	};
+
+}  // namespace bgq_opengl
+
+#endif  //!BGQ_OPENGL_CLASSES_GL_TEXTURE_H_
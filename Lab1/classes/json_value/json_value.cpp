@@ -0,0 +1,420 @@
+/**
+ * @file json_value.cpp
+ * @brief JsonValue class implementation file.
+ * @version 1.0.0 (2026-10-17)
+ * @date 2026-10-17
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#include "json_value.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace bgq_opengl {
+
+	namespace {
+
+		/**
+		 * @brief Skips the whitespace.
+		 *
+		 * Moves a position past the whitespace.
+		 *
+		 * @param text The document.
+		 * @param position The position.
+		 */
+		void skipWhitespace(std::string_view text, size_t *position) {
+
+			while (*position < text.size() && (text[*position] == ' ' || text[*position] == '\t' || text[*position] == '\n' || text[*position] == '\r'))
+				(*position)++;
+
+		}
+
+		/**
+		 * @brief Reads four hexadecimal digits.
+		 *
+		 * Reads the four hexadecimal digits of a \u escape.
+		 *
+		 * @param text The document.
+		 * @param position The position, moved past the digits.
+		 * @param code Outputs the code unit.
+		 *
+		 * @returns True if they were valid.
+		 */
+		bool parseHex(std::string_view text, size_t *position, uint32_t *code) {
+
+			if (*position + 4 > text.size())
+				return false;
+
+			*code = 0;
+			for (int i = 0; i < 4; i++) {
+
+				char digit = text[(*position)++];
+				*code <<= 4;
+
+				if (digit >= '0' && digit <= '9')
+					*code |= (uint32_t) (digit - '0');
+				else if (digit >= 'a' && digit <= 'f')
+					*code |= (uint32_t) (digit - 'a' + 10);
+				else if (digit >= 'A' && digit <= 'F')
+					*code |= (uint32_t) (digit - 'A' + 10);
+				else
+					return false;
+
+			}
+
+			return true;
+
+		}
+
+		/**
+		 * @brief Appends a code point.
+		 *
+		 * Appends a code point to a string, encoded in UTF-8.
+		 *
+		 * @param code The code point.
+		 * @param string The string.
+		 */
+		void appendUTF8(uint32_t code, std::string *string) {
+
+			if (code < 0x80) {
+
+				string->push_back((char) code);
+
+			} else if (code < 0x800) {
+
+				string->push_back((char) (0xC0 | (code >> 6)));
+				string->push_back((char) (0x80 | (code & 0x3F)));
+
+			} else if (code < 0x10000) {
+
+				string->push_back((char) (0xE0 | (code >> 12)));
+				string->push_back((char) (0x80 | ((code >> 6) & 0x3F)));
+				string->push_back((char) (0x80 | (code & 0x3F)));
+
+			} else {
+
+				string->push_back((char) (0xF0 | (code >> 18)));
+				string->push_back((char) (0x80 | ((code >> 12) & 0x3F)));
+				string->push_back((char) (0x80 | ((code >> 6) & 0x3F)));
+				string->push_back((char) (0x80 | (code & 0x3F)));
+
+			}
+
+		}
+
+	}
+
+	bool JsonValue::parse(std::string_view text, JsonValue *value) {
+
+		*value = JsonValue();
+
+		size_t position = 0;
+		if (!JsonValue::parseValue(text, &position, 0, value))
+			return false;
+
+		// Nothing but whitespace can follow the value.
+		skipWhitespace(text, &position);
+		return position == text.size();
+
+	}
+
+	const JsonValue& JsonValue::operator[](const std::string &key) const {
+
+		static const JsonValue null_value;
+
+		for (size_t i = 0; i < this->keys.size(); i++)
+			if (this->keys[i] == key)
+				return this->elements[i];
+
+		return null_value;
+
+	}
+
+	const JsonValue& JsonValue::operator[](size_t index) const {
+
+		static const JsonValue null_value;
+
+		if (this->type != Array || index >= this->elements.size())
+			return null_value;
+
+		return this->elements[index];
+
+	}
+
+	bool JsonValue::getBoolean(bool fallback) const {
+
+		return this->type == Boolean ? this->boolean : fallback;
+
+	}
+
+	double JsonValue::getNumber(double fallback) const {
+
+		return this->type == Number ? this->number : fallback;
+
+	}
+
+	const std::string& JsonValue::getString() const {
+
+		return this->string;
+
+	}
+
+	JsonValue::Type JsonValue::getType() const {
+
+		return this->type;
+
+	}
+
+	bool JsonValue::has(const std::string &key) const {
+
+		for (const std::string &member : this->keys)
+			if (member == key)
+				return true;
+
+		return false;
+
+	}
+
+	size_t JsonValue::size() const {
+
+		return this->type == Array || this->type == Object ? this->elements.size() : 0;
+
+	}
+
+	bool JsonValue::parseValue(std::string_view text, size_t *position, size_t depth, JsonValue *value) {
+
+		// Deep nesting is surely not a model, and would overflow the stack.
+		if (depth > JsonValue::max_depth)
+			return false;
+
+		skipWhitespace(text, position);
+		if (*position >= text.size())
+			return false;
+
+		char first = text[*position];
+
+		if (first == '{') {
+
+			value->type = Object;
+			(*position)++;
+			skipWhitespace(text, position);
+
+			if (*position < text.size() && text[*position] == '}') {
+
+				(*position)++;
+				return true;
+
+			}
+
+			while (true) {
+
+				// Read the name, the colon and the value.
+				std::string key;
+				skipWhitespace(text, position);
+				if (!JsonValue::parseString(text, position, &key))
+					return false;
+
+				skipWhitespace(text, position);
+				if (*position >= text.size() || text[*position] != ':')
+					return false;
+				(*position)++;
+
+				JsonValue member;
+				if (!JsonValue::parseValue(text, position, depth + 1, &member))
+					return false;
+
+				value->keys.push_back(std::move(key));
+				value->elements.push_back(std::move(member));
+
+				// Then either another member or the end.
+				skipWhitespace(text, position);
+				if (*position >= text.size())
+					return false;
+
+				if (text[(*position)++] == '}')
+					return true;
+				if (text[*position - 1] != ',')
+					return false;
+
+			}
+
+		}
+
+		if (first == '[') {
+
+			value->type = Array;
+			(*position)++;
+			skipWhitespace(text, position);
+
+			if (*position < text.size() && text[*position] == ']') {
+
+				(*position)++;
+				return true;
+
+			}
+
+			while (true) {
+
+				JsonValue element;
+				if (!JsonValue::parseValue(text, position, depth + 1, &element))
+					return false;
+
+				value->elements.push_back(std::move(element));
+
+				// Then either another element or the end.
+				skipWhitespace(text, position);
+				if (*position >= text.size())
+					return false;
+
+				if (text[(*position)++] == ']')
+					return true;
+				if (text[*position - 1] != ',')
+					return false;
+
+			}
+
+		}
+
+		if (first == '"') {
+
+			value->type = String;
+			return JsonValue::parseString(text, position, &value->string);
+
+		}
+
+		// The literals.
+		if (text.substr(*position, 4) == "true") {
+
+			value->type = Boolean;
+			value->boolean = true;
+			*position += 4;
+			return true;
+
+		}
+
+		if (text.substr(*position, 5) == "false") {
+
+			value->type = Boolean;
+			value->boolean = false;
+			*position += 5;
+			return true;
+
+		}
+
+		if (text.substr(*position, 4) == "null") {
+
+			value->type = Null;
+			*position += 4;
+			return true;
+
+		}
+
+		// Otherwise it has to be a number. Find where it ends, as strtod needs a
+		// terminated string.
+		size_t end = *position;
+		while (end < text.size() && (text[end] == '-' || text[end] == '+' || text[end] == '.' || text[end] == 'e' || text[end] == 'E' || (text[end] >= '0' && text[end] <= '9')))
+			end++;
+
+		if (end == *position)
+			return false;
+
+		std::string number(text.substr(*position, end - *position));
+		char *number_end = nullptr;
+		value->type = Number;
+		value->number = std::strtod(number.c_str(), &number_end);
+
+		if (number_end != number.c_str() + number.size())
+			return false;
+
+		*position = end;
+		return true;
+
+	}
+
+	bool JsonValue::parseString(std::string_view text, size_t *position, std::string *string) {
+
+		if (*position >= text.size() || text[*position] != '"')
+			return false;
+		(*position)++;
+
+		while (*position < text.size()) {
+
+			char character = text[(*position)++];
+
+			if (character == '"')
+				return true;
+
+			if (character != '\\') {
+
+				string->push_back(character);
+				continue;
+
+			}
+
+			if (*position >= text.size())
+				return false;
+
+			char escape = text[(*position)++];
+			switch (escape) {
+
+				case '"': string->push_back('"'); break;
+				case '\\': string->push_back('\\'); break;
+				case '/': string->push_back('/'); break;
+				case 'b': string->push_back('\b'); break;
+				case 'f': string->push_back('\f'); break;
+				case 'n': string->push_back('\n'); break;
+				case 'r': string->push_back('\r'); break;
+				case 't': string->push_back('\t'); break;
+
+				case 'u': {
+
+					uint32_t code;
+					if (!parseHex(text, position, &code))
+						return false;
+
+					// Characters outside the basic plane come as a surrogate pair.
+					if (code >= 0xD800 && code <= 0xDBFF) {
+
+						uint32_t low;
+						if (text.substr(*position, 2) != "\\u")
+							return false;
+						*position += 2;
+
+						if (!parseHex(text, position, &low) || low < 0xDC00 || low > 0xDFFF)
+							return false;
+
+						code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+
+					}
+
+					appendUTF8(code, string);
+					break;
+
+				}
+
+				default:
+					return false;
+
+			}
+
+		}
+
+		// The string was not closed.
+		return false;
+
+	}
+
+}  // namespace bgq_opengl
@@ -0,0 +1,182 @@
+/**
+ * @file json_value.h
+ * @brief JsonValue class header file.
+ * @version 1.0.0 (2026-10-17)
+ * @date 2026-10-17
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#ifndef BGQ_OPENGL_CLASSES_JSON_VALUE_H_
+#define BGQ_OPENGL_CLASSES_JSON_VALUE_H_
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace bgq_opengl {
+
+	/**
+	 * @brief Implements a JsonValue class.
+	 *
+	 * Implements a parsed JSON value, with just what the glTF loader needs.
+	 * Reading a member or an element that is not there gives a null value, so
+	 * optional properties can be read without checking every step.
+	 *
+	 * @author Borja García Quiroga <garcaqub@tcd.ie>
+	 */
+	class JsonValue {
+
+		public:
+
+			/**
+			 * @brief Declares the types of values.
+			 *
+			 * Declares the types of values.
+			 */
+			enum Type { Null, Boolean, Number, String, Array, Object };
+
+			/**
+			 * @brief Parses a JSON document.
+			 *
+			 * Parses a JSON document, which must hold a single value.
+			 *
+			 * @param text The document.
+			 * @param value Outputs the value.
+			 *
+			 * @returns True if the document was valid.
+			 */
+			static bool parse(std::string_view text, JsonValue *value);
+
+			/**
+			 * @brief Gets a member of an object.
+			 *
+			 * Gets a member of an object.
+			 *
+			 * @param key The name of the member.
+			 *
+			 * @returns The member, or a null value if there is none.
+			 */
+			const JsonValue& operator[](const std::string &key) const;
+
+			/**
+			 * @brief Gets an element of an array.
+			 *
+			 * Gets an element of an array.
+			 *
+			 * @param index The index of the element.
+			 *
+			 * @returns The element, or a null value if there is none.
+			 */
+			const JsonValue& operator[](size_t index) const;
+
+			/**
+			 * @brief Gets the boolean.
+			 *
+			 * Gets the boolean.
+			 *
+			 * @param fallback The value returned if it is not a boolean.
+			 *
+			 * @returns The boolean.
+			 */
+			bool getBoolean(bool fallback = false) const;
+
+			/**
+			 * @brief Gets the number.
+			 *
+			 * Gets the number.
+			 *
+			 * @param fallback The value returned if it is not a number.
+			 *
+			 * @returns The number.
+			 */
+			double getNumber(double fallback = 0.0) const;
+
+			/**
+			 * @brief Gets the string.
+			 *
+			 * Gets the string, empty if it is not a string.
+			 *
+			 * @returns The string.
+			 */
+			const std::string& getString() const;
+
+			/**
+			 * @brief Gets the type.
+			 *
+			 * Gets the type.
+			 *
+			 * @returns The type.
+			 */
+			Type getType() const;
+
+			/**
+			 * @brief Checks if an object has a member.
+			 *
+			 * Checks if an object has a member.
+			 *
+			 * @param key The name of the member.
+			 *
+			 * @returns True if it has it.
+			 */
+			bool has(const std::string &key) const;
+
+			/**
+			 * @brief Gets the number of elements or members.
+			 *
+			 * Gets the number of elements of an array or members of an object.
+			 *
+			 * @returns The number, 0 for any other type.
+			 */
+			size_t size() const;
+
+			static const size_t max_depth = 256;	/// Deepest nesting parsed.
+
+		private:
+
+			/**
+			 * @brief Parses a value.
+			 *
+			 * Parses a value starting at a position.
+			 *
+			 * @param text The document.
+			 * @param position The position, moved past the value.
+			 * @param depth The nesting of the value.
+			 * @param value Outputs the value.
+			 *
+			 * @returns True if it was valid.
+			 */
+			static bool parseValue(std::string_view text, size_t *position, size_t depth, JsonValue *value);
+
+			/**
+			 * @brief Parses a string.
+			 *
+			 * Parses a string starting at its opening quote, decoding its escapes.
+			 *
+			 * @param text The document.
+			 * @param position The position, moved past the string.
+			 * @param string Outputs the string, in UTF-8.
+			 *
+			 * @returns True if it was valid.
+			 */
+			static bool parseString(std::string_view text, size_t *position, std::string *string);
+
+			Type type = Null;						/// The type of the value.
+			bool boolean = false;					/// The boolean, if it is one.
+			double number = 0.0;					/// The number, if it is one.
+			std::string string;						/// The string, if it is one.
+			std::vector<JsonValue> elements;		/// The elements of an array, or the member values of an object.
+			std::vector<std::string> keys;			/// The member names of an object.
+
+	};
+
+}  // namespace bgq_opengl
+
+#endif  //!BGQ_OPENGL_CLASSES_JSON_VALUE_H_
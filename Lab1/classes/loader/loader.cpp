@@ -15,20 +15,90 @@
 
 #include "loader.h"
 
+#include <algorithm>
+#include <cctype>
+#include <filesystem>
+#include <iomanip>
+#include <memory>
+#include <optional>
 #include <string>
 #include <fstream>
 #include <sstream>
 #include <iostream>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "classes/loader_assimp/loader_assimp.h"
+#include "classes/loader_gltf/loader_gltf.h"
+#include "classes/mesh/mesh.h"
+#include "classes/mesh_cache/mesh_cache.h"
+#include "classes/mesh_optimizer/mesh_optimizer.h"
+#include "classes/mesh_simplifier/mesh_simplifier.h"
+#include "structs/cached_geometry/cached_geometry.h"
+#include "structs/model_payload/model_payload.h"
+#include "structs/vertex_cache_stats/vertex_cache_stats.h"
 
 namespace bgq_opengl {
 
-	Loader::Loader(const char* filename) {
+	Loader::Loader(const char* filename, bool optimize) {
 
 		this->filename = filename;
+		this->optimize = optimize;
+
+	}
+
+	std::unique_ptr<Loader> Loader::create(const char *filename, const char *type) {
+
+		// Use the type if given, the extension otherwise.
+		std::string key = type ? type : std::filesystem::path(filename).extension().string();
+		if (!type && !key.empty())
+			key.erase(0, 1);
+
+		std::transform(key.begin(), key.end(), key.begin(), [](unsigned char c) { return (char) std::tolower(c); });
+
+		std::unordered_map<std::string, Factory> &factories = Loader::getFactories();
+		auto factory = factories.find(key);
+
+		// Extensions with no loader of their own go to the default one.
+		if (factory == factories.end() && !type)
+			factory = factories.find("*");
+
+		if (factory == factories.end())
+			return nullptr;
+
+		return factory->second(filename);
 
 	}
 
-    inline void Loader::loadModel() {}
+	void Loader::getGeometries(std::vector<Geometry> *geoms, std::vector<glm::mat4> *matrices) {
+
+		// Geometries cannot be copied, so they are handed over.
+		(*geoms) = std::move(this->geometries);
+		(*matrices) = this->transform_matrixes;
+
+	}
+
+	void Loader::loadModel() {
+
+		// Read the file and upload every geometry. This runs on the render thread,
+		// so it can still stop the program if the file cannot be read.
+		std::optional<ModelPayload> read = this->parse();
+		if (!read)
+			exit(1);
+
+		ModelPayload &payload = *read;
+
+		for (size_t i = 0; i < payload.geometries.size(); i++) {
+
+			std::shared_ptr<Mesh> shared_mesh = Loader::uploadMesh(this->filename, i, payload.geometries[i]);
+
+			// Create a Geometry object that contains all this data.
+			this->geometries.push_back(Geometry(shared_mesh, std::vector<Texture>(), payload.geometries[i].shininess, payload.geometries[i].color));
+
+		}
+
+	}
 
 	std::string Loader::readFileContents(const char* filename) {
 
@@ -66,4 +136,142 @@ namespace bgq_opengl {
 
     }
 
+	void Loader::registerLoader(const char *key, Factory factory) {
+
+		std::string lower_key = key;
+		std::transform(lower_key.begin(), lower_key.end(), lower_key.begin(), [](unsigned char c) { return (char) std::tolower(c); });
+
+		Loader::getFactories()[lower_key] = std::move(factory);
+
+	}
+
+	std::shared_ptr<Mesh> Loader::uploadMesh(const char* filename, size_t index, const CachedGeometry &geometry) {
+
+		// The same mesh of the same file is only uploaded once.
+		std::string key = std::string(filename) + "#" + std::to_string(index);
+
+		return Mesh::getRegistry().acquire(key, [&]() {
+
+			// The color is the same for the whole geometry, so it goes to the
+			// material and the vertices are packed.
+			return std::make_shared<Mesh>(geometry.vertices, geometry.indices, geometry.bounding_box, true, geometry.lods);
+
+		});
+
+	}
+
+	void Loader::process(ModelPayload *payload) const {
+
+		// Optimize the geometries for the vertex cache once, so the cache keeps them so.
+		if (this->optimize) {
+
+			VertexCacheStats before;
+			VertexCacheStats after;
+
+			for (size_t i = 0; i < payload->geometries.size(); i++) {
+
+				VertexCacheStats stats = MeshOptimizer::simulate(payload->indices[i], payload->vertices[i].size());
+				before.triangles += stats.triangles;
+				before.vertices += stats.vertices;
+				before.misses += stats.misses;
+
+				MeshOptimizer::optimize(payload->vertices[i], payload->indices[i]);
+
+				stats = MeshOptimizer::simulate(payload->indices[i], payload->vertices[i].size());
+				after.triangles += stats.triangles;
+				after.vertices += stats.vertices;
+				after.misses += stats.misses;
+
+			}
+
+			if (before.triangles > 0) {
+
+				std::cerr << std::fixed << std::setprecision(3);
+				std::cerr << "  " << before.vertices << " -> " << after.vertices << " vertices" << std::endl;
+				std::cerr << "  ACMR " << (double) before.misses / before.triangles << " -> " << (double) after.misses / after.triangles << std::endl;
+				std::cerr << "  ATVR " << (double) before.misses / before.vertices << " -> " << (double) after.misses / after.vertices << std::endl;
+				std::cerr << std::defaultfloat;
+
+			}
+
+		}
+
+		// Build the levels of detail after the indices of the full meshes, whether
+		// they were optimized or not.
+		payload->lods.resize(payload->geometries.size());
+		std::vector<size_t> level_triangles;
+
+		for (size_t i = 0; i < payload->geometries.size(); i++) {
+
+			payload->lods[i] = MeshSimplifier::buildLODs(payload->vertices[i], payload->indices[i]);
+
+			for (size_t level = 0; level < payload->lods[i].size(); level++) {
+
+				if (level_triangles.size() <= level)
+					level_triangles.push_back(0);
+				level_triangles[level] += payload->lods[i][level].index_count / 3;
+
+			}
+
+		}
+
+		std::cerr << "  LOD triangles";
+		for (size_t triangles : level_triangles)
+			std::cerr << " " << triangles;
+		std::cerr << std::endl;
+
+		// Point the geometries to their data now that it will not move.
+		for (size_t i = 0; i < payload->geometries.size(); i++) {
+
+			payload->geometries[i].vertices = payload->vertices[i];
+			payload->geometries[i].indices = payload->indices[i];
+			if (i < payload->lods.size())
+				payload->geometries[i].lods = payload->lods[i];
+
+		}
+
+		// Write the cache for the next run. It is fine if it fails.
+		std::string cache_path = MeshCache::getPath(this->filename);
+		if (!MeshCache::write(cache_path.c_str(), this->filename, payload->geometries, this->optimize))
+			std::cerr << "  Could not write the mesh cache " << cache_path << std::endl;
+
+	}
+
+	bool Loader::readCache(ModelPayload *payload) const {
+
+		// Skip the parsing if the cache is up to date.
+		std::string cache_path = MeshCache::getPath(this->filename);
+		std::shared_ptr<MeshCache> cache = std::make_shared<MeshCache>(cache_path.c_str());
+
+		if (!cache->isValid(this->filename, this->optimize))
+			return false;
+
+		std::cerr << "  " << this->filename << std::endl;
+		std::cerr << "  " << cache->getGeometryCount() << " meshes from " << cache_path << std::endl;
+
+		for (size_t i = 0; i < cache->getGeometryCount(); i++)
+			payload->geometries.push_back(cache->getGeometry(i));
+
+		// The geometries point into the mapping, so keep it.
+		payload->cache = cache;
+		return true;
+
+	}
+
+	std::unordered_map<std::string, Loader::Factory>& Loader::getFactories() {
+
+		// glTF has a loader of its own, Assimp reads everything else.
+		static std::unordered_map<std::string, Factory> factories = {
+
+			{"*", [](const char *filename) { return std::make_unique<LoaderAssimp>(filename); }},
+			{"assimp", [](const char *filename) { return std::make_unique<LoaderAssimp>(filename); }},
+			{"gltf", [](const char *filename) { return std::make_unique<LoaderGLTF>(filename); }},
+			{"glb", [](const char *filename) { return std::make_unique<LoaderGLTF>(filename); }},
+
+		};
+
+		return factories;
+
+	}
+
 }
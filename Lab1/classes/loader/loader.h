@@ -16,17 +16,29 @@
 #ifndef BGQ_OPENGL_CLASSES_LOADER_H_
 #define BGQ_OPENGL_CLASSES_LOADER_H_
 
+#include <functional>
+#include <memory>
+#include <optional>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "classes/geometry/geometry.h"
+#include "classes/mesh/mesh.h"
+#include "structs/cached_geometry/cached_geometry.h"
+#include "structs/model_payload/model_payload.h"
 
 namespace bgq_opengl {
 
 	/**
 	 * @brief Implements a Loader class.
 	 * 
-	 * Implements a loader class that will allow us to load models.
+	 * Implements a loader class that will allow us to load models. Each format
+	 * only has to parse its files into a ModelPayload. The binary cache, the
+	 * optimization, the levels of detail and the upload are shared.
+	 *
+	 * Loaders are registered by extension, so create() picks the right one for
+	 * a file. Any extension without a loader of its own goes to Assimp.
 	 * 
 	 * @author Borja García Quiroga <garcaqub@tcd.ie>
 	 */
@@ -35,18 +47,39 @@ namespace bgq_opengl {
 		public:
 
 			/**
-			 * @brief Declares the types of Loaders available.
-			 *
-			 * Declares the types of Loaders available.
+			 * @brief Builds a loader for a file.
 			 */
-			enum LoaderTypes { GLTF };
+			using Factory = std::function<std::unique_ptr<Loader>(const char *filename)>;
 
 			/**
 			 * @brief Build a loader instance.
 			 * 
 			 * Build a loader instance.
+			 *
+			 * @param filename The name of the model file.
+			 * @param optimize Whether to run MeshOptimizer on the parsed geometries. Their levels of detail are built either way.
+			 */
+			Loader(const char *filename, bool optimize = true);
+
+			/**
+			 * @brief Destroys the loader.
+			 *
+			 * Destroys the loader. Virtual so it can be deleted through a Loader pointer.
+			 */
+			virtual ~Loader() = default;
+
+			/**
+			 * @brief Builds the loader of a file.
+			 *
+			 * Builds the loader registered for a type, or for the extension of
+			 * the file if no type is given. Keys are not case sensitive.
+			 *
+			 * @param filename The name of the model file.
+			 * @param type The loader to use, such as "Assimp" or "GLTF", or null to pick it by the extension.
+			 *
+			 * @returns The loader, or null if the type is not registered.
 			 */
-			Loader(const char *filename);
+			static std::unique_ptr<Loader> create(const char *filename, const char *type = nullptr);
 
 			/**
 			 * @brief Get the geometries from the loaded model.
@@ -56,14 +89,27 @@ namespace bgq_opengl {
 			 * @param geoms Outputs the geometries returned.
 			 * @param matrices Outputs the transformation matrices.
 			 */
-			virtual void getGeometries(std::vector<Geometry> *geoms, std::vector<glm::mat4> *matrices) = 0;
+			virtual void getGeometries(std::vector<Geometry> *geoms, std::vector<glm::mat4> *matrices);
 
 			/**
 			 * @brief Loads the data from the file.
 			 * 
-			 * Loads the data from the file.
+			 * Parses the file and uploads every geometry.
 			 */
-			virtual void loadModel() = 0;
+			virtual void loadModel();
+
+			/**
+			 * @brief Reads the geometries from the file.
+			 *
+			 * Reads the geometries from the binary cache if it is up to date, or
+			 * parses, optimizes and simplifies the file otherwise and writes the
+			 * cache for the next run. It does not touch OpenGL, so it can run on
+			 * any thread. It never exits on errors, it logs them and returns
+			 * nothing, as it may be running on a worker.
+			 *
+			 * @returns The geometries, ready to be uploaded. Empty if the file could not be read.
+			 */
+			virtual std::optional<ModelPayload> parse() const = 0;
 
 			/**
 			 * @brief Gets the content of a file as a string.
@@ -76,11 +122,69 @@ namespace bgq_opengl {
 			 */
 			static std::string readFileContents(const char* filename);
 
+			/**
+			 * @brief Registers a loader.
+			 *
+			 * Registers the loader of an extension or type, replacing the one it
+			 * had. The key "*" is used for the extensions with none.
+			 *
+			 * @param key The extension without the dot, or the type.
+			 * @param factory Builds the loader for a file.
+			 */
+			static void registerLoader(const char *key, Factory factory);
+
+			/**
+			 * @brief Uploads a geometry of a model.
+			 *
+			 * Builds the mesh of a geometry, unless the same geometry of the same
+			 * file is already loaded.
+			 *
+			 * @param filename The name of the model file.
+			 * @param index The index of the geometry in the model.
+			 * @param geometry The geometry.
+			 *
+			 * @returns The mesh.
+			 */
+			static std::shared_ptr<Mesh> uploadMesh(const char* filename, size_t index, const CachedGeometry &geometry);
+
 		protected:
 
+			/**
+			 * @brief Finishes a parsed model.
+			 *
+			 * Optimizes the geometries and builds their levels of detail if asked,
+			 * points them to their data and writes the cache for the next run.
+			 *
+			 * @param payload The model, with its vertices and indices filled.
+			 */
+			void process(ModelPayload *payload) const;
+
+			/**
+			 * @brief Reads the model from its cache.
+			 *
+			 * Reads the geometries from the binary cache, if it is up to date.
+			 *
+			 * @param payload Outputs the model.
+			 *
+			 * @returns True if it was read.
+			 */
+			bool readCache(ModelPayload *payload) const;
+
 			std::vector<Geometry> geometries;			/// The Geometries loaded by the model loader.
 			const char *filename;						/// Name of the file containing the model.
 			std::vector<glm::mat4> transform_matrixes;	/// Transform matrixes for each Geometry in the object.
+			bool optimize;								/// Whether the parsed geometries are optimized.
+
+		private:
+
+			/**
+			 * @brief Get the registered loaders.
+			 *
+			 * Get the loaders by key, with the built in ones registered.
+			 *
+			 * @returns The loaders.
+			 */
+			static std::unordered_map<std::string, Factory>& getFactories();
 
 	};
 
@@ -16,6 +16,9 @@
 #include "loader_assimp.h"
 #include "classes/loader/loader.h"
 
+#include <optional>
+#include <string>
+#include <utility>
 #include <vector>
 #include <iostream>
 
@@ -25,13 +28,22 @@
 #include "assimp/scene.h"
 #include "assimp/postprocess.h"
 
+#include "classes/aabb_kernel/aabb_kernel.h"
+#include "structs/cached_geometry/cached_geometry.h"
+#include "structs/model_payload/model_payload.h"
 #include "structs/vertex/vertex.h"
 
 namespace bgq_opengl {
 
-	LoaderAssimp::LoaderAssimp(const char* filename) : Loader(filename) {}
+	LoaderAssimp::LoaderAssimp(const char* filename, bool optimize) : Loader(filename, optimize) {}
 
-	void LoaderAssimp::loadModel() {
+	std::optional<ModelPayload> LoaderAssimp::parse() const {
+        
+        ModelPayload payload;
+        
+        // Skip the import if the cache is up to date.
+        if (this->readCache(&payload))
+            return payload;
         
         // Import the scene from the file.
         const aiScene* scene = aiImportFile(filename, aiProcess_Triangulate | aiProcess_PreTransformVertices);
@@ -40,7 +52,7 @@ namespace bgq_opengl {
         if (!scene) {
             
             std::cerr << "Could not read mesh on file " << filename << std::endl;
-            exit(1);
+            return std::nullopt;
             
         }
 
@@ -56,22 +68,27 @@ namespace bgq_opengl {
             // Get the mesh itself.
             const aiMesh* mesh = scene->mMeshes[i];
             
-            // Load this mesh.
-            loadGeometry(scene, mesh);
+            // Read this mesh.
+            this->parseGeometry(scene, mesh, &payload);
             
         }
 
         aiReleaseImport(scene);
+        
+        // Optimize, simplify and cache it.
+        this->process(&payload);
+        
+        return payload;
 
 	}
 
-	void LoaderAssimp::loadGeometry(const aiScene* scene, const aiMesh* mesh) {
+	void LoaderAssimp::parseGeometry(const aiScene* scene, const aiMesh* mesh, ModelPayload *payload) const {
         
         // Init the ds.
         std::vector<bgq_opengl::Vertex> vertices(0);
         std::vector<GLuint> indices(0);
         
-        // If has materials, pass them.
+        // If has materials, pass them. The color goes to the material, not to every vertex.
         aiMaterial *mat = scene->mMaterials[mesh->mMaterialIndex];
         aiColor3D color;
         mat->Get(AI_MATKEY_COLOR_DIFFUSE, color);
@@ -80,7 +97,7 @@ namespace bgq_opengl {
         
         // Iterate through the vertices in the mesh.
         for (unsigned int i = 0; i < mesh->mNumVertices; i++) {
-            
+        
             // Build an empty vertex.
             bgq_opengl::Vertex vertex{
                 glm::vec3(0.0f, 0.0f, 0.0f),    // Position.
@@ -88,78 +105,55 @@ namespace bgq_opengl {
                 glm::vec3(1.0f, 1.0f, 1.0f),    // Color.
                 glm::vec2(0.0f, 0.0f)           // UV coords.
             };
-            
+        
             // If it has a position, subtitute it in the vertex.
             if (mesh->HasPositions()) {
-                
+            
                 const aiVector3D* vp = &(mesh->mVertices[i]);
                 vertex.position = glm::vec3(vp->x, vp->y, vp->z);
-                
-            }
-            
-            vertex.color = glm::vec3(color.r, color.g, color.b);
             
+            }
+        
             // If it has a normal, subtitute it in the vertex.
             if (mesh->HasNormals()) {
-                
+            
                 const aiVector3D* vn = &(mesh->mNormals[i]);
                 vertex.normal = glm::vec3(vn->x, vn->y, vn->z);
-                
-            }
             
+            }
+        
             // If it has UV textures, subtitute it in the vertex.
             if (mesh->HasTextureCoords(0)) {
-                                
+                            
                 const aiVector3D* vt = &(mesh->mTextureCoords[0][i]);
                 vertex.uv = glm::vec2(-vt->y, vt->x);
-                
-            }
             
+            }
+        
             // Add that to vertices.
             vertices.push_back(vertex);
 
         }
-        
+    
         // Lets store all the indices or faces.
         for (unsigned int j = 0; j < mesh->mNumFaces; j++) {
-            
+        
             indices.push_back(mesh->mFaces[j].mIndices[0]);
             indices.push_back(mesh->mFaces[j].mIndices[1]);
             indices.push_back(mesh->mFaces[j].mIndices[2]);
-        
+    
         }
 
-		// Obtain the textures.
-		std::vector<bgq_opengl::Texture> textures = getTextures();
-
-		// Create a Geometry object that contains all this data.
-		this->geometries.push_back(bgq_opengl::Geometry(vertices, indices, textures, shine));
-
-	}
-
-	std::vector<bgq_opengl::Texture> LoaderAssimp::getTextures() {
-
-		// Init the textures holder.
-		std::vector<bgq_opengl::Texture> textures;
+        // Compute the bounding box here, off the render thread.
+        CachedGeometry geometry;
+        geometry.bounding_box = AABBKernel::compute(vertices);
+        geometry.shininess = shine;
+        geometry.color = glm::vec3(color.r, color.g, color.b);
         
-        // Get the texture filename.
-        // std::string texture_filename = "Textures/white.png";
-        //std::string texture_name = "baseColor";
-
-        // Load the texture.
-        //bgq_opengl::Texture new_texture = bgq_opengl::Texture((texture_filename).c_str(), texture_name.c_str(), (unsigned int) textures.size());
-
-        // Add it to the textures.
-        //textures.push_back(new_texture);
-
-		return textures;
-
-	}
-
-	void LoaderAssimp::getGeometries(std::vector<Geometry> *geoms, std::vector<glm::mat4> *matrices) {
-
-		(*geoms) = this->geometries;
-		(*matrices) = this->transform_matrixes;
+        // Store it. The spans are set once every geometry is in.
+        payload->geometries.push_back(geometry);
+        payload->vertices.push_back(std::move(vertices));
+        payload->indices.push_back(std::move(indices));
 
 	}
 
@@ -18,6 +18,7 @@
 
 #include "classes/loader/loader.h"
 
+#include <optional>
 #include <vector>
 
 #include "glm/glm.hpp"
@@ -25,6 +26,8 @@
 #include "assimp/scene.h"
 #include "assimp/postprocess.h"
 
+#include "structs/model_payload/model_payload.h"
+
 namespace bgq_opengl {
 
 	/**
@@ -42,43 +45,36 @@ namespace bgq_opengl {
 			 * @brief Build a loader instance.
 			 *
 			 * Build a loader instance.
+			 *
+			 * @param filename The name of the model file.
+			 * @param optimize Whether to run MeshOptimizer on the imported geometries and build their levels of detail.
 			 */
-			LoaderAssimp(const char* filename);
-
-			/**
-			 * @brief Get the geometries from the loaded model.
-			 * 
-			 * Get the geometries from the loaded model.
-			 * 
-			 * @param geoms Outputs the geometries returned.
-			 * @param matrices Outputs the transformation matrices.
-			 */
-			void getGeometries(std::vector<Geometry> *geoms, std::vector<glm::mat4> *matrices);
+			LoaderAssimp(const char* filename, bool optimize = true);
 
 			/**
-			 * @brief Loads the data from the file.
-		 	 *
-			 * Loads the data from the file.
+			 * @brief Reads the geometries from the file.
+			 *
+			 * Reads the geometries from the binary cache if it is up to date, or
+			 * imports, optimizes and simplifies the file otherwise and writes the
+			 * cache for the next run. It does not touch OpenGL, so it can run on
+			 * any thread.
+			 *
+			 * @returns The geometries, ready to be uploaded. Empty if the file could not be read.
 			 */
-			void loadModel();
+			std::optional<ModelPayload> parse() const override;
 
 		private:
 
 			/**
-			 * @brief Loads a mesh by its index.
+			 * @brief Reads a mesh.
 			 *
-			 * Loads a mesh by its index.
+			 * Reads the vertices and indices of a mesh and adds them to a model.
 			 *
-			 * @param mesh the assimp  mesh.
+			 * @param scene The assimp scene.
+			 * @param mesh The assimp mesh.
+			 * @param payload The model it is added to.
 			 */
-			void loadGeometry(const aiScene* scene, const aiMesh* mesh);
-        
-            /**
-             * @brief Load the textures for this model.
-             *
-             * Load the textures for this model.
-             */
-            std::vector<bgq_opengl::Texture> getTextures();
+			void parseGeometry(const aiScene* scene, const aiMesh* mesh, ModelPayload *payload) const;
 
 	};
 
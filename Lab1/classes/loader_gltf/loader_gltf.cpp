@@ -0,0 +1,746 @@
+/**
+ * @file loader_gltf.cpp
+ * @brief LoaderGLTF class implementation file.
+ * @version 1.0.0 (2026-10-17)
+ * @date 2026-10-17
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#include "loader_gltf.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "GL/glew.h"
+#include "glm/glm.hpp"
+#include "glm/gtc/matrix_transform.hpp"
+#include "glm/gtc/quaternion.hpp"
+
+#include "classes/aabb_kernel/aabb_kernel.h"
+#include "classes/json_value/json_value.h"
+#include "classes/mapped_file/mapped_file.h"
+#include "structs/cached_geometry/cached_geometry.h"
+#include "structs/model_payload/model_payload.h"
+#include "structs/vertex/vertex.h"
+
+namespace bgq_opengl {
+
+	namespace {
+
+		const uint32_t glb_magic = 0x46546C67;		// "glTF"
+		const uint32_t glb_json_chunk = 0x4E4F534A;	// "JSON"
+		const uint32_t glb_bin_chunk = 0x004E4942;	// "BIN\0"
+		const double triangles_mode = 4;
+
+		/**
+		 * @brief A glTF file being read.
+		 *
+		 * Holds the JSON and the buffers, which point into the mapped files or
+		 * into the decoded data URIs.
+		 */
+		struct Document {
+
+			JsonValue json;										/// The JSON of the file.
+			std::vector<std::span<const unsigned char>> buffers;	/// The contents of every buffer.
+			std::vector<std::unique_ptr<MappedFile>> files;		/// The mapped files the buffers point into.
+			std::vector<std::vector<unsigned char>> decoded;	/// The decoded data URIs the buffers point into.
+
+		};
+
+		/**
+		 * @brief An accessor, checked against its buffer.
+		 */
+		struct Accessor {
+
+			const unsigned char *data = nullptr;	/// The first element, or null if it is all zeros.
+			size_t count = 0;						/// The number of elements.
+			size_t stride = 0;						/// The bytes from one element to the next.
+			GLenum component_type = GL_FLOAT;		/// The type of the components.
+			size_t component_size = 0;				/// The size of a component in bytes.
+			size_t components = 0;					/// The components per element.
+			bool normalized = false;				/// Whether integers are mapped to [0, 1] or [-1, 1].
+
+		};
+
+		/**
+		 * @brief Reads an index from the JSON.
+		 *
+		 * @param value The value.
+		 * @param index Outputs the index.
+		 *
+		 * @returns True if the value is a valid index.
+		 */
+		bool getIndex(const JsonValue &value, size_t *index) {
+
+			double number = value.getNumber(-1.0);
+			if (number < 0.0 || number > 4294967295.0)
+				return false;
+
+			*index = (size_t) number;
+			return true;
+
+		}
+
+		/**
+		 * @brief Reads a little endian 32 bit integer.
+		 */
+		uint32_t readUint32(std::span<const unsigned char> data, size_t offset) {
+
+			uint32_t value;
+			std::memcpy(&value, data.data() + offset, sizeof(value));
+			return value;
+
+		}
+
+		/**
+		 * @brief Decodes base64.
+		 *
+		 * @param text The encoded text.
+		 * @param data Outputs the decoded bytes.
+		 *
+		 * @returns True if the text was valid.
+		 */
+		bool decodeBase64(std::string_view text, std::vector<unsigned char> *data) {
+
+			uint32_t bits = 0;
+			int bit_count = 0;
+			data->reserve(text.size() * 3 / 4);
+
+			for (char character : text) {
+
+				uint32_t value;
+				if (character >= 'A' && character <= 'Z')
+					value = (uint32_t) (character - 'A');
+				else if (character >= 'a' && character <= 'z')
+					value = (uint32_t) (character - 'a' + 26);
+				else if (character >= '0' && character <= '9')
+					value = (uint32_t) (character - '0' + 52);
+				else if (character == '+')
+					value = 62;
+				else if (character == '/')
+					value = 63;
+				else if (character == '=')
+					break;
+				else
+					return false;
+
+				bits = (bits << 6) | value;
+				bit_count += 6;
+
+				if (bit_count >= 8) {
+
+					bit_count -= 8;
+					data->push_back((unsigned char) (bits >> bit_count));
+
+				}
+
+			}
+
+			return true;
+
+		}
+
+		/**
+		 * @brief Decodes the escapes of a relative URI.
+		 *
+		 * @param uri The URI.
+		 *
+		 * @returns The path it points to.
+		 */
+		std::string decodeURI(const std::string &uri) {
+
+			std::string path;
+			for (size_t i = 0; i < uri.size(); i++) {
+
+				unsigned int code;
+				if (uri[i] == '%' && i + 2 < uri.size() && std::sscanf(uri.c_str() + i + 1, "%2x", &code) == 1) {
+
+					path.push_back((char) code);
+					i += 2;
+
+				} else {
+
+					path.push_back(uri[i]);
+
+				}
+
+			}
+
+			return path;
+
+		}
+
+		/**
+		 * @brief Reads a glTF or GLB file.
+		 *
+		 * Maps the file, parses its JSON and finds the contents of every buffer.
+		 *
+		 * @param filename The name of the file.
+		 * @param document Outputs the file.
+		 *
+		 * @returns True if it was valid.
+		 */
+		bool readDocument(const char *filename, Document *document) {
+
+			std::unique_ptr<MappedFile> file = std::make_unique<MappedFile>();
+			if (!file->open(filename))
+				return false;
+
+			std::span<const unsigned char> data = file->getData();
+			std::string_view json_text;
+			std::span<const unsigned char> binary;
+
+			if (data.size() >= 12 && readUint32(data, 0) == glb_magic) {
+
+				// A GLB is a header and chunks, the JSON first and then the binary buffer.
+				if (readUint32(data, 4) != 2)
+					return false;
+
+				size_t length = std::min((size_t) readUint32(data, 8), data.size());
+				size_t offset = 12;
+
+				while (offset + 8 <= length) {
+
+					size_t chunk_length = readUint32(data, offset);
+					uint32_t chunk_type = readUint32(data, offset + 4);
+					offset += 8;
+
+					if (chunk_length > length - offset)
+						return false;
+
+					if (chunk_type == glb_json_chunk && json_text.empty())
+						json_text = std::string_view((const char *) data.data() + offset, chunk_length);
+					else if (chunk_type == glb_bin_chunk && binary.empty())
+						binary = data.subspan(offset, chunk_length);
+
+					// Chunks are padded to 4 bytes.
+					offset += (chunk_length + 3) & ~(size_t) 3;
+
+				}
+
+				if (json_text.empty())
+					return false;
+
+			} else {
+
+				json_text = std::string_view((const char *) data.data(), data.size());
+
+			}
+
+			if (!JsonValue::parse(json_text, &document->json))
+				return false;
+
+			document->files.push_back(std::move(file));
+
+			// Find the contents of every buffer.
+			const JsonValue &buffers = document->json["buffers"];
+			std::filesystem::path folder = std::filesystem::path(filename).parent_path();
+
+			for (size_t i = 0; i < buffers.size(); i++) {
+
+				const JsonValue &buffer = buffers[i];
+				std::span<const unsigned char> contents;
+
+				size_t length;
+				if (!getIndex(buffer["byteLength"], &length))
+					return false;
+
+				if (!buffer.has("uri")) {
+
+					// The buffer with no URI is the binary chunk of the GLB.
+					if (i != 0)
+						return false;
+					contents = binary;
+
+				} else {
+
+					const std::string &uri = buffer["uri"].getString();
+
+					if (uri.compare(0, 5, "data:") == 0) {
+
+						// Embedded buffers are base64 data URIs.
+						size_t start = uri.find(";base64,");
+						if (start == std::string::npos)
+							return false;
+
+						std::vector<unsigned char> decoded;
+						if (!decodeBase64(std::string_view(uri).substr(start + 8), &decoded))
+							return false;
+
+						document->decoded.push_back(std::move(decoded));
+						contents = document->decoded.back();
+
+					} else {
+
+						// Other buffers are files next to the model, also mapped.
+						std::unique_ptr<MappedFile> buffer_file = std::make_unique<MappedFile>();
+						if (!buffer_file->open((folder / decodeURI(uri)).string()))
+							return false;
+
+						contents = buffer_file->getData();
+						document->files.push_back(std::move(buffer_file));
+
+					}
+
+				}
+
+				if (contents.size() < length)
+					return false;
+
+				document->buffers.push_back(contents.first(length));
+
+			}
+
+			return true;
+
+		}
+
+		/**
+		 * @brief Reads an accessor.
+		 *
+		 * Reads an accessor and checks that all its elements are inside its
+		 * buffer view, so they can be read without further checks.
+		 *
+		 * @param document The file.
+		 * @param index The index of the accessor.
+		 * @param accessor Outputs the accessor.
+		 *
+		 * @returns True if it is valid.
+		 */
+		bool getAccessor(const Document &document, size_t index, Accessor *accessor) {
+
+			const JsonValue &json = document.json["accessors"][index];
+			if (json.getType() != JsonValue::Object || !getIndex(json["count"], &accessor->count))
+				return false;
+
+			accessor->component_type = (GLenum) json["componentType"].getNumber();
+			accessor->normalized = json["normalized"].getBoolean();
+
+			switch (accessor->component_type) {
+
+				case GL_BYTE: case GL_UNSIGNED_BYTE: accessor->component_size = 1; break;
+				case GL_SHORT: case GL_UNSIGNED_SHORT: accessor->component_size = 2; break;
+				case GL_UNSIGNED_INT: case GL_FLOAT: accessor->component_size = 4; break;
+				default: return false;
+
+			}
+
+			const std::string &type = json["type"].getString();
+			if (type == "SCALAR")
+				accessor->components = 1;
+			else if (type == "VEC2")
+				accessor->components = 2;
+			else if (type == "VEC3")
+				accessor->components = 3;
+			else if (type == "VEC4")
+				accessor->components = 4;
+			else
+				return false;
+
+			size_t element_size = accessor->component_size * accessor->components;
+			accessor->stride = element_size;
+
+			// Accessors with no buffer view are all zeros.
+			size_t view_index;
+			if (!getIndex(json["bufferView"], &view_index))
+				return true;
+
+			const JsonValue &view = document.json["bufferViews"][view_index];
+			size_t buffer, view_offset = 0, view_length, offset = 0;
+
+			if (!getIndex(view["buffer"], &buffer) || buffer >= document.buffers.size() || !getIndex(view["byteLength"], &view_length))
+				return false;
+
+			getIndex(view["byteOffset"], &view_offset);
+			getIndex(view["byteStride"], &accessor->stride);
+			getIndex(json["byteOffset"], &offset);
+
+			if (accessor->stride < element_size || view_offset > document.buffers[buffer].size() || view_length > document.buffers[buffer].size() - view_offset)
+				return false;
+
+			// Every element has to be inside the view.
+			if (accessor->count > 0 && (offset > view_length || accessor->count - 1 > (view_length - offset) / accessor->stride ||
+				offset + (accessor->count - 1) * accessor->stride + element_size > view_length))
+				return false;
+
+			accessor->data = document.buffers[buffer].data() + view_offset + offset;
+			return true;
+
+		}
+
+		/**
+		 * @brief Reads an element of an accessor as floats.
+		 *
+		 * @param accessor The accessor.
+		 * @param element The index of the element.
+		 *
+		 * @returns The element, with the missing components set to 0.
+		 */
+		glm::vec4 readVector(const Accessor &accessor, size_t element) {
+
+			glm::vec4 vector(0.0f, 0.0f, 0.0f, 0.0f);
+			if (accessor.data == nullptr)
+				return vector;
+
+			const unsigned char *data = accessor.data + element * accessor.stride;
+
+			// Floats, by far the most common, are copied as they are.
+			if (accessor.component_type == GL_FLOAT) {
+
+				std::memcpy(&vector[0], data, accessor.components * sizeof(float));
+				return vector;
+
+			}
+
+			for (size_t i = 0; i < accessor.components; i++) {
+
+				const unsigned char *component = data + i * accessor.component_size;
+				float value = 0.0f, scale = 1.0f;
+
+				switch (accessor.component_type) {
+
+					case GL_BYTE: value = (float) *(const int8_t *) component; scale = 127.0f; break;
+					case GL_UNSIGNED_BYTE: value = (float) *component; scale = 255.0f; break;
+					case GL_SHORT: { int16_t raw; std::memcpy(&raw, component, 2); value = (float) raw; scale = 32767.0f; break; }
+					case GL_UNSIGNED_SHORT: { uint16_t raw; std::memcpy(&raw, component, 2); value = (float) raw; scale = 65535.0f; break; }
+					case GL_UNSIGNED_INT: { uint32_t raw; std::memcpy(&raw, component, 4); value = (float) raw; scale = 4294967295.0f; break; }
+
+				}
+
+				vector[(int) i] = accessor.normalized ? std::max(value / scale, -1.0f) : value;
+
+			}
+
+			return vector;
+
+		}
+
+		/**
+		 * @brief Reads an element of an index accessor.
+		 *
+		 * @param accessor The accessor.
+		 * @param element The index of the element.
+		 *
+		 * @returns The index.
+		 */
+		GLuint readIndex(const Accessor &accessor, size_t element) {
+
+			if (accessor.data == nullptr)
+				return 0;
+
+			const unsigned char *data = accessor.data + element * accessor.stride;
+
+			if (accessor.component_type == GL_UNSIGNED_BYTE)
+				return *data;
+
+			if (accessor.component_type == GL_UNSIGNED_SHORT) {
+
+				uint16_t index;
+				std::memcpy(&index, data, sizeof(index));
+				return index;
+
+			}
+
+			uint32_t index;
+			std::memcpy(&index, data, sizeof(index));
+			return index;
+
+		}
+
+		/**
+		 * @brief Gets the transform of a node relative to its parent.
+		 *
+		 * @param node The node.
+		 *
+		 * @returns Its matrix, or the one built from its translation, rotation and scale.
+		 */
+		glm::mat4 getLocalMatrix(const JsonValue &node) {
+
+			glm::mat4 matrix(1.0f);
+
+			// The matrix is stored by columns, as in glm.
+			const JsonValue &values = node["matrix"];
+			if (values.size() == 16) {
+
+				for (int column = 0; column < 4; column++)
+					for (int row = 0; row < 4; row++)
+						matrix[column][row] = (float) values[(size_t) (column * 4 + row)].getNumber();
+
+				return matrix;
+
+			}
+
+			const JsonValue &translation = node["translation"];
+			const JsonValue &rotation = node["rotation"];
+			const JsonValue &scale = node["scale"];
+
+			if (translation.size() == 3)
+				matrix = glm::translate(matrix, glm::vec3(translation[0].getNumber(), translation[1].getNumber(), translation[2].getNumber()));
+
+			// Rotations are stored as x, y, z, w.
+			if (rotation.size() == 4)
+				matrix = matrix * glm::mat4_cast(glm::quat((float) rotation[3].getNumber(), (float) rotation[0].getNumber(), (float) rotation[1].getNumber(), (float) rotation[2].getNumber()));
+
+			if (scale.size() == 3)
+				matrix = glm::scale(matrix, glm::vec3(scale[0].getNumber(1.0), scale[1].getNumber(1.0), scale[2].getNumber(1.0)));
+
+			return matrix;
+
+		}
+
+		/**
+		 * @brief Reads a primitive.
+		 *
+		 * Reads the vertices and indices of a primitive, moved to world space,
+		 * and adds them to a model as a geometry.
+		 *
+		 * @param document The file.
+		 * @param primitive The primitive.
+		 * @param matrix The world transform of its node.
+		 * @param payload The model it is added to.
+		 */
+		void parsePrimitive(const Document &document, const JsonValue &primitive, const glm::mat4 &matrix, ModelPayload *payload) {
+
+			// Only triangle lists can be drawn.
+			if (primitive["mode"].getNumber(triangles_mode) != triangles_mode)
+				return;
+
+			const JsonValue &attributes = primitive["attributes"];
+			size_t index;
+
+			Accessor positions;
+			if (!getIndex(attributes["POSITION"], &index) || !getAccessor(document, index, &positions) || positions.components != 3)
+				return;
+
+			Accessor normals;
+			bool has_normals = getIndex(attributes["NORMAL"], &index) && getAccessor(document, index, &normals) &&
+				normals.components == 3 && normals.count == positions.count;
+
+			Accessor uvs;
+			bool has_uvs = getIndex(attributes["TEXCOORD_0"], &index) && getAccessor(document, index, &uvs) &&
+				uvs.components == 2 && uvs.count == positions.count;
+
+			// Normals need the inverse transpose, in case of a non uniform scale.
+			glm::mat3 normal_matrix = glm::transpose(glm::inverse(glm::mat3(matrix)));
+
+			// Read every vertex straight from the buffers.
+			std::vector<Vertex> vertices(positions.count, Vertex{
+				glm::vec3(0.0f, 0.0f, 0.0f),	// Position.
+				glm::vec3(1.0f, 1.0f, 1.0f),	// Normal.
+				glm::vec3(1.0f, 1.0f, 1.0f),	// Color.
+				glm::vec2(0.0f, 0.0f)			// UV coords.
+			});
+
+			for (size_t i = 0; i < positions.count; i++) {
+
+				vertices[i].position = glm::vec3(matrix * glm::vec4(glm::vec3(readVector(positions, i)), 1.0f));
+
+				if (has_normals) {
+
+					glm::vec3 normal = normal_matrix * glm::vec3(readVector(normals, i));
+					float length = glm::length(normal);
+					vertices[i].normal = length > 0.0f ? normal / length : normal;
+
+				}
+
+				// Flipped like Assimp does, then mapped as LoaderAssimp does.
+				if (has_uvs) {
+
+					glm::vec4 uv = readVector(uvs, i);
+					vertices[i].uv = glm::vec2(-(1.0f - uv.y), uv.x);
+
+				}
+
+			}
+
+			// Read the indices, or draw the vertices in order if there are none.
+			std::vector<GLuint> indices;
+			Accessor index_accessor;
+
+			if (getIndex(primitive["indices"], &index)) {
+
+				if (!getAccessor(document, index, &index_accessor) || index_accessor.components != 1 || index_accessor.component_type == GL_FLOAT ||
+					index_accessor.component_type == GL_BYTE || index_accessor.component_type == GL_SHORT)
+					return;
+
+				indices.resize(index_accessor.count);
+				for (size_t i = 0; i < index_accessor.count; i++) {
+
+					indices[i] = readIndex(index_accessor, i);
+					if (indices[i] >= vertices.size())
+						return;
+
+				}
+
+			} else {
+
+				indices.resize(vertices.size());
+				for (size_t i = 0; i < indices.size(); i++)
+					indices[i] = (GLuint) i;
+
+			}
+
+			indices.resize(indices.size() - indices.size() % 3);
+			if (indices.empty())
+				return;
+
+			// The color goes to the material, not to every vertex.
+			CachedGeometry geometry;
+			size_t material_index;
+
+			if (getIndex(primitive["material"], &material_index)) {
+
+				const JsonValue &pbr = document.json["materials"][material_index]["pbrMetallicRoughness"];
+				const JsonValue &color = pbr["baseColorFactor"];
+
+				if (color.size() >= 3)
+					geometry.color = glm::vec3(color[0].getNumber(1.0), color[1].getNumber(1.0), color[2].getNumber(1.0));
+
+				// The same approximation of the shininess as the Assimp importer.
+				float roughness = (float) pbr["roughnessFactor"].getNumber(1.0);
+				geometry.shininess = (1.0f - roughness) * (1.0f - roughness) * 1000.0f;
+
+			}
+
+			// Compute the bounding box here, off the render thread.
+			geometry.bounding_box = AABBKernel::compute(vertices);
+
+			// Store it. The spans are set once every geometry is in.
+			payload->geometries.push_back(geometry);
+			payload->vertices.push_back(std::move(vertices));
+			payload->indices.push_back(std::move(indices));
+
+		}
+
+		/**
+		 * @brief Reads a node and its children.
+		 *
+		 * @param document The file.
+		 * @param index The index of the node.
+		 * @param parent The world transform of its parent.
+		 * @param depth The depth of the node, to stop on cycles.
+		 * @param payload The model the geometries are added to.
+		 */
+		void parseNode(const Document &document, size_t index, const glm::mat4 &parent, size_t depth, ModelPayload *payload) {
+
+			const JsonValue &node = document.json["nodes"][index];
+			if (depth > LoaderGLTF::max_depth || node.getType() != JsonValue::Object)
+				return;
+
+			glm::mat4 matrix = parent * getLocalMatrix(node);
+
+			size_t mesh;
+			if (getIndex(node["mesh"], &mesh)) {
+
+				const JsonValue &primitives = document.json["meshes"][mesh]["primitives"];
+				for (size_t i = 0; i < primitives.size(); i++)
+					parsePrimitive(document, primitives[i], matrix, payload);
+
+			}
+
+			const JsonValue &children = node["children"];
+			for (size_t i = 0; i < children.size(); i++) {
+
+				size_t child;
+				if (getIndex(children[i], &child))
+					parseNode(document, child, matrix, depth + 1, payload);
+
+			}
+
+		}
+
+	}
+
+	LoaderGLTF::LoaderGLTF(const char* filename, bool optimize) : Loader(filename, optimize) {}
+
+	std::optional<ModelPayload> LoaderGLTF::parse() const {
+
+		ModelPayload payload;
+
+		// Skip the reading if the cache is up to date.
+		if (this->readCache(&payload))
+			return payload;
+
+		Document document;
+		if (!readDocument(this->filename, &document)) {
+
+			std::cerr << "Could not read mesh on file " << this->filename << std::endl;
+			return std::nullopt;
+
+		}
+
+		const JsonValue &json = document.json;
+
+		// Print info from the file.
+		std::cerr << "  " << this->filename << std::endl;
+		std::cerr << "  " << json["materials"].size() << " materials" << std::endl;
+		std::cerr << "  " << json["meshes"].size() << " meshes" << std::endl;
+		std::cerr << "  " << json["textures"].size() << " textures" << std::endl;
+
+		// Read the default scene, or the first one.
+		size_t scene_index = 0;
+		getIndex(json["scene"], &scene_index);
+		const JsonValue &scene = json["scenes"][scene_index];
+
+		if (scene.getType() == JsonValue::Object) {
+
+			const JsonValue &nodes = scene["nodes"];
+			for (size_t i = 0; i < nodes.size(); i++) {
+
+				size_t node;
+				if (getIndex(nodes[i], &node))
+					parseNode(document, node, glm::mat4(1.0f), 0, &payload);
+
+			}
+
+		} else {
+
+			// With no scenes, read every node that is not a child.
+			const JsonValue &nodes = json["nodes"];
+			std::vector<bool> is_child(nodes.size(), false);
+
+			for (size_t i = 0; i < nodes.size(); i++) {
+
+				const JsonValue &children = nodes[i]["children"];
+				for (size_t j = 0; j < children.size(); j++) {
+
+					size_t child;
+					if (getIndex(children[j], &child) && child < is_child.size())
+						is_child[child] = true;
+
+				}
+
+			}
+
+			for (size_t i = 0; i < nodes.size(); i++)
+				if (!is_child[i])
+					parseNode(document, i, glm::mat4(1.0f), 0, &payload);
+
+		}
+
+		// Optimize, simplify and cache it.
+		this->process(&payload);
+
+		return payload;
+
+	}
+
+}  // namespace bgq_opengl
@@ -0,0 +1,72 @@
+/**
+ * @file loader_gltf.h
+ * @brief LoaderGLTF class header file.
+ * @version 1.0.0 (2026-10-17)
+ * @date 2026-10-17
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#ifndef BGQ_OPENGL_CLASSES_LOADER_GLTF_H_
+#define BGQ_OPENGL_CLASSES_LOADER_GLTF_H_
+
+#include "classes/loader/loader.h"
+
+#include <optional>
+#include "structs/model_payload/model_payload.h"
+
+namespace bgq_opengl {
+
+	/**
+	 * @brief Implements a GLTF Loader class.
+	 *
+	 * Implements a loader class that reads glTF 2.0 models, both .gltf files
+	 * and binary .glb ones, without going through Assimp. The binary chunk of a
+	 * .glb and the external buffers of a .gltf are mapped, and the accessors are
+	 * read straight from the mapping into the vertices.
+	 *
+	 * Only triangle lists are read. The node transforms are baked into the
+	 * vertices, as Assimp does with aiProcess_PreTransformVertices, so both
+	 * loaders give the same geometries.
+	 *
+	 * @author Borja García Quiroga <garcaqub@tcd.ie>
+	 */
+	class LoaderGLTF : public Loader {
+
+		public:
+
+			/**
+			 * @brief Build a loader instance.
+			 *
+			 * Build a loader instance.
+			 *
+			 * @param filename The name of the model file.
+			 * @param optimize Whether to run MeshOptimizer on the read geometries and build their levels of detail.
+			 */
+			LoaderGLTF(const char* filename, bool optimize = true);
+
+			/**
+			 * @brief Reads the geometries from the file.
+			 *
+			 * Reads the geometries from the binary cache if it is up to date, or
+			 * reads, optimizes and simplifies the file otherwise and writes the
+			 * cache for the next run. It does not touch OpenGL, so it can run on
+			 * any thread.
+			 *
+			 * @returns The geometries, ready to be uploaded. Empty if the file could not be read.
+			 */
+			std::optional<ModelPayload> parse() const override;
+
+			static const size_t max_depth = 64;	/// Deepest node hierarchy read.
+
+	};
+
+}  // namespace bgq_opengl
+
+#endif  //!BGQ_OPENGL_CLASSES_LOADER_GLTF_H_
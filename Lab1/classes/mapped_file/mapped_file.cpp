@@ -0,0 +1,183 @@
+/**
+ * @file mapped_file.cpp
+ * @brief MappedFile class implementation file.
+ * @version 1.0.0 (2026-10-17)
+ * @date 2026-10-17
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#include "mapped_file.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <span>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <utility>
+
+namespace bgq_opengl {
+
+	MappedFile::MappedFile(const char* path) {
+
+		this->open(path);
+
+	}
+
+	MappedFile::MappedFile(MappedFile &&other) noexcept {
+
+		*this = std::move(other);
+
+	}
+
+	MappedFile::~MappedFile() {
+
+		this->remove();
+
+	}
+
+	MappedFile& MappedFile::operator=(MappedFile &&other) noexcept {
+
+		if (this != &other) {
+
+			// Free ours and take theirs.
+			this->remove();
+			this->data = other.data;
+			this->size = other.size;
+			other.data = nullptr;
+			other.size = 0;
+
+		}
+
+		return *this;
+
+	}
+
+	std::span<const unsigned char> MappedFile::getData() const {
+
+		return std::span<const unsigned char>(this->data, this->size);
+
+	}
+
+	bool MappedFile::getStamp(const char* path, uint64_t *size, int64_t *time) {
+
+		std::error_code error;
+
+		*size = std::filesystem::file_size(path, error);
+		if (error)
+			return false;
+
+		*time = std::filesystem::last_write_time(path, error).time_since_epoch().count();
+
+		return !error;
+
+	}
+
+	bool MappedFile::open(const std::string &path) {
+
+		this->remove();
+
+		// Open the file and get its size.
+		int file = ::open(path.c_str(), O_RDONLY);
+		if (file < 0)
+			return false;
+
+		struct stat file_stat;
+		if (fstat(file, &file_stat) == 0 && file_stat.st_size > 0) {
+
+			// Map all of it. The mapping stays valid after closing the file.
+			void *mapping = mmap(nullptr, (size_t) file_stat.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+			if (mapping != MAP_FAILED) {
+
+				this->data = (const unsigned char *) mapping;
+				this->size = (size_t) file_stat.st_size;
+
+			}
+
+		}
+
+		close(file);
+
+		return this->data != nullptr;
+
+	}
+
+	void MappedFile::prefetch() const {
+
+		if (this->data != nullptr)
+			madvise((void *) this->data, this->size, MADV_WILLNEED);
+
+	}
+
+	bool MappedFile::write(const char* path, std::span<const Block> blocks) {
+
+		// Write everything to a temporary file of this thread, as two threads
+		// may be writing the same file.
+		std::string temporary_path = std::string(path) + "." + std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id())) + ".tmp";
+		std::ofstream file(temporary_path, std::ios::binary | std::ios::trunc);
+		if (!file)
+			return false;
+
+		const char zeros[64] = {};
+		uint64_t written = 0;
+
+		for (const Block &block : blocks) {
+
+			// Pad up to the block.
+			while (written < block.offset) {
+
+				uint64_t padding = std::min<uint64_t>(block.offset - written, sizeof(zeros));
+				file.write(zeros, (std::streamsize) padding);
+				written += padding;
+
+			}
+
+			file.write((const char *) block.data, (std::streamsize) block.size);
+			written += block.size;
+
+		}
+
+		file.close();
+
+		// Replace the old file only if everything was written.
+		std::error_code error;
+		if (!file) {
+
+			std::filesystem::remove(temporary_path, error);
+			return false;
+
+		}
+
+		std::filesystem::rename(temporary_path, path, error);
+
+		return !error;
+
+	}
+
+	void MappedFile::remove() {
+
+		// Unmaps the file, only once.
+		if (this->data == nullptr)
+			return;
+
+		munmap((void *) this->data, this->size);
+		this->data = nullptr;
+		this->size = 0;
+
+	}
+
+}  // namespace bgq_opengl
@@ -0,0 +1,169 @@
+/**
+ * @file mapped_file.h
+ * @brief MappedFile class header file.
+ * @version 1.0.0 (2026-10-17)
+ * @date 2026-10-17
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#ifndef BGQ_OPENGL_CLASSES_MAPPED_FILE_H_
+#define BGQ_OPENGL_CLASSES_MAPPED_FILE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+
+namespace bgq_opengl {
+
+	/**
+	 * @brief Implements a file mapped in memory.
+	 *
+	 * Implements a whole file mapped read only, unmapped when destroyed. It also
+	 * holds what the binary caches share: the stamp that tells if their source
+	 * changed, and writing a file out of blocks so a failed or concurrent write
+	 * never leaves a broken one behind.
+	 *
+	 * @author Borja García Quiroga <garcaqub@tcd.ie>
+	 */
+	class MappedFile {
+
+		public:
+
+			/**
+			 * @brief A block of a file being written.
+			 */
+			struct Block {
+
+				uint64_t offset;			/// Offset of the block from the start of the file.
+				const void *data;			/// Contents of the block.
+				uint64_t size;				/// Size of the block in bytes.
+
+			};
+
+			/**
+			 * @brief Builds an empty MappedFile.
+			 *
+			 * Builds a MappedFile with no file mapped.
+			 */
+			MappedFile() = default;
+
+			/**
+			 * @brief Maps a file.
+			 *
+			 * Maps a file to memory. If it cannot be opened it is left empty.
+			 *
+			 * @param path The file.
+			 */
+			MappedFile(const char* path);
+
+			/**
+			 * @brief Moves a mapping.
+			 *
+			 * Takes the mapping of another MappedFile, which is left empty.
+			 *
+			 * @param other The MappedFile to move from.
+			 */
+			MappedFile(MappedFile &&other) noexcept;
+
+			/**
+			 * @brief Destroys the MappedFile.
+			 *
+			 * Unmaps the file, if it is still mapped.
+			 */
+			~MappedFile();
+
+			// Copies would unmap the same file twice.
+			MappedFile(const MappedFile&) = delete;
+			MappedFile& operator=(const MappedFile&) = delete;
+
+			/**
+			 * @brief Moves a mapping.
+			 *
+			 * Unmaps the file of this MappedFile and takes the mapping of
+			 * another, which is left empty.
+			 *
+			 * @param other The MappedFile to move from.
+			 *
+			 * @returns This MappedFile.
+			 */
+			MappedFile& operator=(MappedFile &&other) noexcept;
+
+			/**
+			 * @brief Get the contents of the file.
+			 *
+			 * @returns The mapping, empty if no file is mapped.
+			 */
+			std::span<const unsigned char> getData() const;
+
+			/**
+			 * @brief Gets the stamp of a file.
+			 *
+			 * Gets the size and modification time of a file.
+			 *
+			 * @param path The file.
+			 * @param size Outputs the size.
+			 * @param time Outputs the modification time.
+			 *
+			 * @returns True if the file exists.
+			 */
+			static bool getStamp(const char* path, uint64_t *size, int64_t *time);
+
+			/**
+			 * @brief Maps a file.
+			 *
+			 * Unmaps the file mapped, if any, and maps another.
+			 *
+			 * @param path The file.
+			 *
+			 * @returns True if it was mapped.
+			 */
+			bool open(const std::string &path);
+
+			/**
+			 * @brief Starts reading the file in.
+			 *
+			 * Tells the system the whole mapping will be read soon, so it is
+			 * read from the disk before it is touched.
+			 */
+			void prefetch() const;
+
+			/**
+			 * @brief Writes a file.
+			 *
+			 * Writes some blocks to a file, padding the gaps between them with
+			 * zeros. It is written to a temporary file of this thread first and
+			 * then moved over the old one, so a failed write never leaves a
+			 * broken file behind and two threads writing the same one do not mix.
+			 *
+			 * @param path The file.
+			 * @param blocks The blocks, sorted by offset and not overlapping.
+			 *
+			 * @returns True if it was written.
+			 */
+			static bool write(const char* path, std::span<const Block> blocks);
+
+		private:
+
+			/**
+			 * @brief Unmaps the file.
+			 *
+			 * Unmaps the file, only once.
+			 */
+			void remove();
+
+			const unsigned char *data = nullptr;	/// Start of the mapping.
+			size_t size = 0;						/// Size of the mapping.
+
+	};
+
+}  // namespace bgq_opengl
+
+#endif  //!BGQ_OPENGL_CLASSES_MAPPED_FILE_H_
@@ -0,0 +1,216 @@
+/**
+ * @file mesh.cpp
+ * @brief Mesh class implementation file.
+ * @version 1.0.0 (2026-10-17)
+ * @date 2026-10-17
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#include "mesh.h"
+
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
+
+#include "GL/glew.h"
+#include "glm/glm.hpp"
+#include "glm/gtc/packing.hpp"
+
+#include "classes/aabb_kernel/aabb_kernel.h"
+#include "classes/geometry_arena/geometry_arena.h"
+#include "classes/gl_state/gl_state.h"
+#include "classes/resource_registry/resource_registry.h"
+#include "structs/arena_range/arena_range.h"
+#include "structs/mesh_lod/mesh_lod.h"
+#include "structs/bounding_box/bounding_box.h"
+#include "structs/packed_vertex/packed_vertex.h"
+#include "structs/vertex/vertex.h"
+
+namespace bgq_opengl {
+
+	Mesh::Mesh(std::span<const Vertex> vertices, std::span<const GLuint> indices, bool packed, bool keep_data)
+		: Mesh(vertices, indices, AABBKernel::compute(vertices.data(), vertices.size()), packed, {}, keep_data) {}
+
+	Mesh::Mesh(std::span<const Vertex> vertices, std::span<const GLuint> indices, const BoundingBox &bounding_box, bool packed,
+		std::span<const MeshLOD> lods, bool keep_data) {
+
+		// Without levels, all the indices are the full mesh.
+		if (lods.empty()) {
+
+			MeshLOD full;
+			full.index_count = (uint32_t) indices.size();
+			this->lods.push_back(full);
+
+		} else {
+
+			this->lods.assign(lods.begin(), lods.end());
+
+		}
+
+		// Only keep a copy if asked, as OpenGL already has them.
+		if (keep_data) {
+
+			this->vertices.assign(vertices.begin(), vertices.end());
+			this->indices.assign(indices.begin() + this->lods[0].first_index, indices.begin() + this->lods[0].first_index + this->lods[0].index_count);
+
+		}
+
+		this->bounding_box = bounding_box;
+		this->packed = packed;
+
+		// Upload them with no VAO bound, as growing the arena would change it.
+		GLState::bindVertexArray(0);
+
+		// Pack the vertices if asked.
+		std::vector<PackedVertex> packed_vertices;
+		const void *vertex_data = vertices.data();
+
+		if (packed) {
+
+			packed_vertices.reserve(vertices.size());
+			for (const Vertex &vertex : vertices)
+				packed_vertices.push_back(Mesh::pack(vertex));
+
+			vertex_data = packed_vertices.data();
+
+		}
+
+		// Every index fits in 16 bits if there are at most 65536 vertices.
+		if (vertices.size() <= 65536) {
+
+			std::vector<GLushort> short_indices(indices.begin(), indices.end());
+			this->arena = GeometryArena::get(packed, GL_UNSIGNED_SHORT);
+			this->range = this->arena->allocate(vertex_data, vertices.size(), short_indices.data(), short_indices.size());
+
+		} else {
+
+			this->arena = GeometryArena::get(packed, GL_UNSIGNED_INT);
+			this->range = this->arena->allocate(vertex_data, vertices.size(), indices.data(), indices.size());
+
+		}
+
+	}
+
+	Mesh::~Mesh() {
+
+		this->arena->free(this->range);
+
+	}
+
+	GeometryArena& Mesh::getArena() const {
+
+		return *this->arena;
+
+	}
+
+	const BoundingBox& Mesh::getBoundingBox() const {
+
+		return this->bounding_box;
+
+	}
+
+	const std::vector<GLuint>& Mesh::getIndices() const {
+
+		return this->indices;
+
+	}
+
+	GLenum Mesh::getIndexType() const {
+
+		return this->arena->getIndexType();
+
+	}
+
+	const std::vector<MeshLOD>& Mesh::getLODs() const {
+
+		return this->lods;
+
+	}
+
+	ResourceRegistry<Mesh>& Mesh::getRegistry() {
+
+		static ResourceRegistry<Mesh> registry;
+		return registry;
+
+	}
+
+	std::shared_ptr<Mesh> Mesh::getPlaceholder() {
+
+		return Mesh::getRegistry().acquire("placeholder:cube", []() {
+
+			// One vertex per corner, with the normal pointing out of it.
+			std::vector<Vertex> vertices;
+			for (int corner = 0; corner < 8; corner++) {
+
+				glm::vec3 position((corner & 1) ? 0.5f : -0.5f, (corner & 2) ? 0.5f : -0.5f, (corner & 4) ? 0.5f : -0.5f);
+				vertices.push_back(Vertex{position, glm::normalize(position), glm::vec3(1.0f, 1.0f, 1.0f), glm::vec2(0.0f, 0.0f)});
+
+			}
+
+			// Two counter-clockwise triangles per face.
+			std::vector<GLuint> indices {
+				0, 2, 3, 3, 1, 0,	// -z
+				4, 5, 7, 7, 6, 4,	// +z
+				0, 4, 6, 6, 2, 0,	// -x
+				1, 3, 7, 7, 5, 1,	// +x
+				0, 1, 5, 5, 4, 0,	// -y
+				2, 6, 7, 7, 3, 2	// +y
+			};
+
+			return std::make_shared<Mesh>(vertices, indices);
+
+		});
+
+	}
+
+	ArenaRange Mesh::getRange(size_t level) const {
+
+		// The levels share the vertices and take part of the indices.
+		ArenaRange range = this->range;
+		range.first_index += this->lods[level].first_index;
+		range.index_count = this->lods[level].index_count;
+
+		return range;
+
+	}
+
+	const std::vector<Vertex>& Mesh::getVertices() const {
+
+		return this->vertices;
+
+	}
+
+	bool Mesh::isPacked() const {
+
+		return this->packed;
+
+	}
+
+	PackedVertex Mesh::pack(const Vertex &vertex) {
+
+		PackedVertex packed;
+		packed.position = vertex.position;
+
+		// The normal may not be normalized, but it has to fit in [-1, 1].
+		glm::vec3 normal = vertex.normal;
+		float length = glm::length(normal);
+		if (length > 0.0f)
+			normal /= length;
+		packed.normal = glm::packSnorm3x10_1x2(glm::vec4(normal, 0.0f));
+
+		packed.uv[0] = glm::packHalf1x16(vertex.uv.x);
+		packed.uv[1] = glm::packHalf1x16(vertex.uv.y);
+
+		return packed;
+
+	}
+
+}  // namespace bgq_opengl
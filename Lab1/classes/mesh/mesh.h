@@ -0,0 +1,214 @@
+/**
+ * @file mesh.h
+ * @brief Mesh class header file.
+ * @version 1.0.0 (2026-10-17)
+ * @date 2026-10-17
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#ifndef BGQ_OPENGL_CLASSES_MESH_H_
+#define BGQ_OPENGL_CLASSES_MESH_H_
+
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <vector>
+
+#include "GL/glew.h"
+
+#include "classes/geometry_arena/geometry_arena.h"
+#include "classes/resource_registry/resource_registry.h"
+#include "structs/arena_range/arena_range.h"
+#include "structs/bounding_box/bounding_box.h"
+#include "structs/mesh_lod/mesh_lod.h"
+#include "structs/packed_vertex/packed_vertex.h"
+#include "structs/vertex/vertex.h"
+
+namespace bgq_opengl {
+
+	/**
+	 * @brief Implementation of a Mesh class.
+	 *
+	 * Implementation of a Mesh class that holds the vertices and indices of a
+	 * geometry along with their range in a GeometryArena. Meshes are shared
+	 * between every Geometry drawing them, so a model loaded twice is only
+	 * uploaded once.
+	 *
+	 * A mesh can be uploaded in the full Vertex layout or packed as PackedVertex,
+	 * and its indices are uploaded as 16 bit whenever they fit. Each combination
+	 * has its own arena.
+	 *
+	 * @author Borja García Quiroga <garcaqub@tcd.ie>
+	 */
+	class Mesh {
+
+		public:
+
+			/**
+			 * @brief Builds the mesh.
+			 *
+			 * Uploads the vertices and indices to OpenGL and computes the bounding
+			 * box.
+			 *
+			 * @param vertices Vertices of the mesh.
+			 * @param indices Indices of the vertices.
+			 * @param packed Whether to upload the vertices packed. Their colors are dropped.
+			 * @param keep_data Whether to keep a copy of the vertices and indices in memory.
+			 */
+			Mesh(std::span<const Vertex> vertices, std::span<const GLuint> indices, bool packed = false, bool keep_data = false);
+
+			/**
+			 * @brief Builds the mesh with a known bounding box.
+			 *
+			 * Uploads the vertices and indices to OpenGL straight from the given
+			 * memory, which may be a mapped file. Every level of detail is
+			 * uploaded in the same range, after the full mesh. Nothing is copied
+			 * unless asked for.
+			 *
+			 * @param vertices Vertices of the mesh.
+			 * @param indices Indices of the vertices, every level one after the other.
+			 * @param bounding_box Bounding box of the vertices.
+			 * @param packed Whether to upload the vertices packed. Their colors are dropped.
+			 * @param lods Levels of detail in the indices, the full mesh first. Empty if there is only the full mesh.
+			 * @param keep_data Whether to keep a copy of the vertices and the indices of the full mesh in memory.
+			 */
+			Mesh(std::span<const Vertex> vertices, std::span<const GLuint> indices, const BoundingBox &bounding_box, bool packed = false,
+				std::span<const MeshLOD> lods = {}, bool keep_data = false);
+
+			/**
+			 * @brief Destroys the mesh.
+			 *
+			 * Gives its range back to the arena.
+			 */
+			~Mesh();
+
+			// Copies would free the same range twice.
+			Mesh(const Mesh&) = delete;
+			Mesh& operator=(const Mesh&) = delete;
+
+			/**
+			 * @brief Gets the arena.
+			 *
+			 * Gets the arena holding the vertices and indices in OpenGL.
+			 *
+			 * @returns The arena.
+			 */
+			GeometryArena& getArena() const;
+
+			/**
+			 * @brief Gets the bounding box.
+			 *
+			 * Gets the bounding box of the vertices in model space.
+			 *
+			 * @returns The bounding box.
+			 */
+			const BoundingBox& getBoundingBox() const;
+
+			/**
+			 * @brief Gets the indices.
+			 *
+			 * Gets the indices of the full mesh, if it was built keeping them.
+			 *
+			 * @returns A read-only reference to the indices.
+			 */
+			const std::vector<GLuint>& getIndices() const;
+
+			/**
+			 * @brief Gets the type of the indices in OpenGL.
+			 *
+			 * @returns GL_UNSIGNED_SHORT or GL_UNSIGNED_INT.
+			 */
+			GLenum getIndexType() const;
+
+			/**
+			 * @brief Gets the levels of detail.
+			 *
+			 * Gets every level of detail, the full mesh first. There is always
+			 * at least that one.
+			 *
+			 * @returns A read-only reference to the levels.
+			 */
+			const std::vector<MeshLOD>& getLODs() const;
+
+			/**
+			 * @brief Get the registry of meshes.
+			 *
+			 * Get the registry shared by every mesh loaded from a file.
+			 *
+			 * @returns The registry.
+			 */
+			static ResourceRegistry<Mesh>& getRegistry();
+
+			/**
+			 * @brief Get the placeholder mesh.
+			 *
+			 * Get a white unit cube centred at the origin, shown in place of
+			 * models that are still loading.
+			 *
+			 * @returns The shared placeholder.
+			 */
+			static std::shared_ptr<Mesh> getPlaceholder();
+
+			/**
+			 * @brief Gets the range of a level of detail.
+			 *
+			 * Gets the range of the arena holding the vertices and the indices
+			 * of a level of detail.
+			 *
+			 * @param level The level, 0 for the full mesh.
+			 *
+			 * @returns The range.
+			 */
+			ArenaRange getRange(size_t level = 0) const;
+
+			/**
+			 * @brief Gets the vertices.
+			 *
+			 * Gets the vertices, if it was built keeping them.
+			 *
+			 * @returns A read-only reference to the vertices.
+			 */
+			const std::vector<Vertex>& getVertices() const;
+
+			/**
+			 * @brief Checks if the vertices are packed.
+			 *
+			 * Checks if the buffer holds PackedVertex instead of Vertex.
+			 *
+			 * @returns True if the vertices are packed.
+			 */
+			bool isPacked() const;
+
+			/**
+			 * @brief Packs a vertex.
+			 *
+			 * Packs a vertex into its compact form, dropping its color.
+			 *
+			 * @param vertex The vertex.
+			 *
+			 * @returns The packed vertex.
+			 */
+			static PackedVertex pack(const Vertex &vertex);
+
+		private:
+
+			std::vector<Vertex> vertices;			/// Vertices of the mesh, if kept.
+			std::vector<GLuint> indices;			/// Indices of the full mesh, if kept.
+			std::vector<MeshLOD> lods;				/// Levels of detail, the full mesh first.
+			BoundingBox bounding_box;				/// Bounding box of the vertices.
+			std::shared_ptr<GeometryArena> arena;	/// Arena with the vertices and indices.
+			ArenaRange range;						/// Where they are in the arena, every level included.
+			bool packed = false;					/// Whether the arena holds packed vertices.
+
+	};
+
+}  // namespace bgq_opengl
+
+#endif  //!BGQ_OPENGL_CLASSES_MESH_H_
@@ -0,0 +1,198 @@
+/**
+ * @file mesh_cache.cpp
+ * @brief MeshCache class implementation file.
+ * @version 1.0.0 (2026-10-17)
+ * @date 2026-10-17
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#include "mesh_cache.h"
+
+#include <cstring>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "glm/glm.hpp"
+
+#include "classes/mapped_file/mapped_file.h"
+#include "structs/bounding_box/bounding_box.h"
+#include "structs/cached_geometry/cached_geometry.h"
+#include "structs/mesh_lod/mesh_lod.h"
+#include "structs/vertex/vertex.h"
+
+namespace bgq_opengl {
+
+	MeshCache::MeshCache(const char* path) : file(path) {}
+
+	MeshCache::MeshCache(MeshCache &&other) noexcept = default;
+
+	MeshCache& MeshCache::operator=(MeshCache &&other) noexcept = default;
+
+	CachedGeometry MeshCache::getGeometry(size_t index) const {
+
+		// The entries come right after the header.
+		const unsigned char *data = this->file.getData().data();
+		const Entry *entry = (const Entry *) (data + sizeof(Header)) + index;
+
+		// Point to the data in the mapping.
+		CachedGeometry geometry;
+		geometry.vertices = std::span<const Vertex>((const Vertex *) (data + entry->vertex_offset), entry->vertex_count);
+		geometry.indices = std::span<const GLuint>((const GLuint *) (data + entry->index_offset), entry->index_count);
+		geometry.lods = std::span<const MeshLOD>((const MeshLOD *) (data + entry->lod_offset), entry->lod_count);
+		geometry.bounding_box.min = glm::vec3(entry->bounding_box[0], entry->bounding_box[1], entry->bounding_box[2]);
+		geometry.bounding_box.max = glm::vec3(entry->bounding_box[3], entry->bounding_box[4], entry->bounding_box[5]);
+		geometry.shininess = entry->shininess;
+		geometry.color = glm::vec3(entry->color[0], entry->color[1], entry->color[2]);
+
+		return geometry;
+
+	}
+
+	size_t MeshCache::getGeometryCount() const {
+
+		return ((const Header *) this->file.getData().data())->geometry_count;
+
+	}
+
+	std::string MeshCache::getPath(const char* source) {
+
+		return std::string(source) + ".bgqmesh";
+
+	}
+
+	bool MeshCache::isValid(const char* source, bool optimized) const {
+
+		// It has to have a header of this version.
+		const unsigned char *data = this->file.getData().data();
+		size_t size = this->file.getData().size();
+		if (data == nullptr || size < sizeof(Header))
+			return false;
+
+		const Header *header = (const Header *) data;
+		if (std::memcmp(header->magic, "BGQM", 4) != 0 || header->version != MeshCache::version
+			|| header->vertex_size != sizeof(Vertex) || header->optimized != (optimized ? 1u : 0u))
+			return false;
+
+		// The model cannot have changed since.
+		uint64_t source_size;
+		int64_t source_time;
+		if (!MappedFile::getStamp(source, &source_size, &source_time)
+			|| header->source_size != source_size || header->source_time != source_time)
+			return false;
+
+		// Every entry and the data it points to have to be inside the file.
+		if (header->geometry_count > (size - sizeof(Header)) / sizeof(Entry))
+			return false;
+
+		const Entry *entries = (const Entry *) (data + sizeof(Header));
+		for (uint32_t i = 0; i < header->geometry_count; i++) {
+
+			const Entry &entry = entries[i];
+
+			if (entry.vertex_offset % MeshCache::alignment != 0 || entry.index_offset % MeshCache::alignment != 0
+				|| entry.lod_offset % MeshCache::alignment != 0)
+				return false;
+
+			if (entry.vertex_offset > size || entry.vertex_count > (size - entry.vertex_offset) / sizeof(Vertex))
+				return false;
+
+			if (entry.index_offset > size || entry.index_count > (size - entry.index_offset) / sizeof(GLuint))
+				return false;
+
+			if (entry.lod_offset > size || entry.lod_count > (size - entry.lod_offset) / sizeof(MeshLOD))
+				return false;
+
+			// Every level has to be inside the indices.
+			const MeshLOD *lods = (const MeshLOD *) (data + entry.lod_offset);
+			for (uint64_t level = 0; level < entry.lod_count; level++)
+				if ((uint64_t) lods[level].first_index + lods[level].index_count > entry.index_count)
+					return false;
+
+			// Every index has to point to one of the vertices.
+			const GLuint *indices = (const GLuint *) (data + entry.index_offset);
+			for (uint64_t index = 0; index < entry.index_count; index++)
+				if (indices[index] >= entry.vertex_count)
+					return false;
+
+		}
+
+		return true;
+
+	}
+
+	bool MeshCache::write(const char* path, const char* source, std::span<const CachedGeometry> geometries, bool optimized) {
+
+		// Build the header.
+		Header header;
+		std::memcpy(header.magic, "BGQM", 4);
+		header.version = MeshCache::version;
+		header.vertex_size = sizeof(Vertex);
+		header.geometry_count = (uint32_t) geometries.size();
+		header.optimized = optimized ? 1 : 0;
+		header.padding = 0;
+
+		if (!MappedFile::getStamp(source, &header.source_size, &header.source_time))
+			return false;
+
+		// Lay the data out after the entries, every block aligned.
+		std::vector<Entry> entries(geometries.size());
+		uint64_t offset = sizeof(Header) + geometries.size() * sizeof(Entry);
+
+		for (size_t i = 0; i < geometries.size(); i++) {
+
+			const CachedGeometry &geometry = geometries[i];
+			Entry &entry = entries[i];
+
+			offset = (offset + MeshCache::alignment - 1) / MeshCache::alignment * MeshCache::alignment;
+			entry.vertex_offset = offset;
+			entry.vertex_count = geometry.vertices.size();
+			offset += geometry.vertices.size_bytes();
+
+			offset = (offset + MeshCache::alignment - 1) / MeshCache::alignment * MeshCache::alignment;
+			entry.index_offset = offset;
+			entry.index_count = geometry.indices.size();
+			offset += geometry.indices.size_bytes();
+
+			offset = (offset + MeshCache::alignment - 1) / MeshCache::alignment * MeshCache::alignment;
+			entry.lod_offset = offset;
+			entry.lod_count = geometry.lods.size();
+			offset += geometry.lods.size_bytes();
+
+			for (int axis = 0; axis < 3; axis++) {
+
+				entry.bounding_box[axis] = geometry.bounding_box.min[axis];
+				entry.bounding_box[3 + axis] = geometry.bounding_box.max[axis];
+				entry.color[axis] = geometry.color[axis];
+
+			}
+
+			entry.shininess = geometry.shininess;
+
+		}
+
+		// Write the header, the entries and the data of every geometry.
+		std::vector<MappedFile::Block> blocks;
+		blocks.push_back({0, &header, sizeof(Header)});
+		blocks.push_back({sizeof(Header), entries.data(), entries.size() * sizeof(Entry)});
+
+		for (size_t i = 0; i < geometries.size(); i++) {
+
+			blocks.push_back({entries[i].vertex_offset, geometries[i].vertices.data(), geometries[i].vertices.size_bytes()});
+			blocks.push_back({entries[i].index_offset, geometries[i].indices.data(), geometries[i].indices.size_bytes()});
+			blocks.push_back({entries[i].lod_offset, geometries[i].lods.data(), geometries[i].lods.size_bytes()});
+
+		}
+
+		return MappedFile::write(path, blocks);
+
+	}
+
+}  // namespace bgq_opengl
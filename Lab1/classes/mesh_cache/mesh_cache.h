@@ -0,0 +1,186 @@
+/**
+ * @file mesh_cache.h
+ * @brief MeshCache class header file.
+ * @version 1.0.0 (2026-10-17)
+ * @date 2026-10-17
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#ifndef BGQ_OPENGL_CLASSES_MESH_CACHE_H_
+#define BGQ_OPENGL_CLASSES_MESH_CACHE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+
+#include "classes/mapped_file/mapped_file.h"
+#include "structs/cached_geometry/cached_geometry.h"
+
+namespace bgq_opengl {
+
+	/**
+	 * @brief Implements a binary cache of the geometries of a model.
+	 *
+	 * Implements a binary file holding the vertices, indices, levels of detail,
+	 * bounding boxes and material of every geometry of a model, so later runs can skip importing
+	 * it. The file is mapped to memory and the geometries point straight into
+	 * the mapping, so it has to outlive them until they are uploaded.
+	 *
+	 * The file starts with a header, followed by one entry per geometry and the
+	 * data they point to. It stores the size and modification time of the model
+	 * it was built from, so it is ignored as soon as the model changes. It is
+	 * written in the byte order of the machine, so it is not meant to be shared.
+	 *
+	 * @author Borja García Quiroga <garcaqub@tcd.ie>
+	 */
+	class MeshCache {
+
+		public:
+
+			/**
+			 * @brief Maps a cache file.
+			 *
+			 * Maps a cache file to memory. If it cannot be opened the cache is
+			 * empty and never valid.
+			 *
+			 * @param path The cache file.
+			 */
+			MeshCache(const char* path);
+
+			/**
+			 * @brief Moves a cache.
+			 *
+			 * Takes the mapping of another MeshCache, which is left empty.
+			 *
+			 * @param other The MeshCache to move from.
+			 */
+			MeshCache(MeshCache &&other) noexcept;
+
+			/**
+			 * @brief Moves a cache.
+			 *
+			 * Unmaps the file of this MeshCache and takes the mapping of another,
+			 * which is left empty.
+			 *
+			 * @param other The MeshCache to move from.
+			 *
+			 * @returns This MeshCache.
+			 */
+			MeshCache& operator=(MeshCache &&other) noexcept;
+
+			/**
+			 * @brief Get a geometry.
+			 *
+			 * Get a geometry of the cache. Its spans point into the mapping. Only
+			 * valid caches can be read.
+			 *
+			 * @param index The index of the geometry.
+			 *
+			 * @returns The geometry.
+			 */
+			CachedGeometry getGeometry(size_t index) const;
+
+			/**
+			 * @brief Get the number of geometries.
+			 *
+			 * Get the number of geometries of the cache. Only valid caches can be
+			 * read.
+			 *
+			 * @returns The number of geometries.
+			 */
+			size_t getGeometryCount() const;
+
+			/**
+			 * @brief Get the cache file of a model.
+			 *
+			 * Get the path of the cache file of a model, next to it.
+			 *
+			 * @param source The model file.
+			 *
+			 * @returns The cache file.
+			 */
+			static std::string getPath(const char* source);
+
+			/**
+			 * @brief Checks if the cache can be used.
+			 *
+			 * Checks the format and version of the file, that every entry lies
+			 * inside it and every index points to a vertex, that the model has not
+			 * changed since it was written and that it was optimized the same way.
+			 *
+			 * @param source The model file.
+			 * @param optimized Whether the geometries have to be optimized.
+			 *
+			 * @returns True if the cache is valid for the model.
+			 */
+			bool isValid(const char* source, bool optimized) const;
+
+			/**
+			 * @brief Writes a cache file.
+			 *
+			 * Writes the geometries of a model to a cache file. It is written to
+			 * a temporary file first so a failed write never leaves a broken
+			 * cache behind.
+			 *
+			 * @param path The cache file.
+			 * @param source The model file the geometries come from.
+			 * @param geometries The geometries.
+			 * @param optimized Whether the geometries were optimized.
+			 *
+			 * @returns True if it was written.
+			 */
+			static bool write(const char* path, const char* source, std::span<const CachedGeometry> geometries, bool optimized);
+
+		private:
+
+			/**
+			 * @brief Header of a cache file.
+			 */
+			struct Header {
+
+				char magic[4];				/// Always "BGQM".
+				uint32_t version;			/// Format version.
+				uint32_t vertex_size;		/// Size of a Vertex when it was written.
+				uint32_t geometry_count;	/// Number of entries after the header.
+				uint64_t source_size;		/// Size of the model file.
+				int64_t source_time;		/// Modification time of the model file.
+				uint32_t optimized;			/// Whether the geometries went through MeshOptimizer.
+				uint32_t padding;			/// Keeps the entries 8 byte aligned.
+
+			};
+
+			/**
+			 * @brief Entry of a geometry in a cache file.
+			 */
+			struct Entry {
+
+				uint64_t vertex_offset;		/// Offset of the vertices from the start of the file.
+				uint64_t vertex_count;		/// Number of vertices.
+				uint64_t index_offset;		/// Offset of the indices from the start of the file.
+				uint64_t index_count;		/// Number of indices.
+				uint64_t lod_offset;		/// Offset of the levels of detail from the start of the file.
+				uint64_t lod_count;			/// Number of levels of detail.
+				float bounding_box[6];		/// Minimum and maximum of the bounding box.
+				float shininess;			/// Shininess of the material.
+				float color[3];				/// Diffuse color of the material.
+
+			};
+
+			static const uint32_t version = 5;		/// Current format version.
+			static const size_t alignment = 16;		/// Alignment of the data blocks.
+
+			MappedFile file;						/// The mapped cache file.
+
+	};
+
+}  // namespace bgq_opengl
+
+#endif  //!BGQ_OPENGL_CLASSES_MESH_CACHE_H_
@@ -0,0 +1,349 @@
+/**
+ * @file mesh_optimizer.cpp
+ * @brief MeshOptimizer class implementation file.
+ * @version 1.0.0 (2026-10-17)
+ * @date 2026-10-17
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#include "mesh_optimizer.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <span>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "GL/glew.h"
+#include "glm/glm.hpp"
+
+#include "structs/vertex/vertex.h"
+#include "structs/vertex_cache_stats/vertex_cache_stats.h"
+
+namespace bgq_opengl {
+
+	namespace {
+
+		/**
+		 * @brief Hashes a vertex by its bytes.
+		 */
+		struct VertexHash {
+
+			size_t operator()(const Vertex &vertex) const {
+
+				return std::hash<std::string_view>()(std::string_view((const char *) &vertex, sizeof(Vertex)));
+
+			}
+
+		};
+
+		/**
+		 * @brief Compares two vertices by their bytes.
+		 */
+		struct VertexEqual {
+
+			bool operator()(const Vertex &a, const Vertex &b) const {
+
+				return std::memcmp(&a, &b, sizeof(Vertex)) == 0;
+
+			}
+
+		};
+
+		/**
+		 * @brief A run of triangles Tipsify emitted without a dead end.
+		 */
+		struct Cluster {
+
+			size_t first;		/// First triangle in the Tipsify order.
+			size_t count;		/// Number of triangles.
+			float sort_key;		/// How much it faces away from the centre of the mesh.
+
+		};
+
+	}  // namespace
+
+	void MeshOptimizer::optimize(std::vector<Vertex> &vertices, std::vector<GLuint> &indices) {
+
+		MeshOptimizer::weld(vertices, indices);
+		MeshOptimizer::reorderTriangles(vertices, indices);
+		MeshOptimizer::reorderVertices(vertices, indices);
+
+	}
+
+	void MeshOptimizer::reorderVertices(std::vector<Vertex> &vertices, std::vector<GLuint> &indices) {
+
+		// Number the vertices in the order they are first used.
+		const GLuint unused = (GLuint) -1;
+		std::vector<GLuint> remap(vertices.size(), unused);
+		std::vector<Vertex> reordered;
+		reordered.reserve(vertices.size());
+
+		for (GLuint &index : indices) {
+
+			if (remap[index] == unused) {
+
+				remap[index] = (GLuint) reordered.size();
+				reordered.push_back(vertices[index]);
+
+			}
+
+			index = remap[index];
+
+		}
+
+		vertices = std::move(reordered);
+
+	}
+
+	void MeshOptimizer::reorderTriangles(const std::vector<Vertex> &vertices, std::vector<GLuint> &indices) {
+
+		const size_t none = (size_t) -1;
+		size_t vertex_count = vertices.size();
+		size_t triangle_count = indices.size() / 3;
+		if (triangle_count == 0)
+			return;
+
+		// List the triangles of every vertex, all in one array.
+		std::vector<size_t> offsets(vertex_count + 1, 0);
+		for (GLuint index : indices)
+			offsets[index + 1]++;
+		for (size_t v = 0; v < vertex_count; v++)
+			offsets[v + 1] += offsets[v];
+
+		std::vector<size_t> adjacency(triangle_count * 3);
+		std::vector<size_t> filled(offsets.begin(), offsets.end() - 1);
+		for (size_t t = 0; t < triangle_count; t++)
+			for (size_t corner = 0; corner < 3; corner++)
+				adjacency[filled[indices[t * 3 + corner]]++] = t;
+
+		// Triangles each vertex still has to draw, and when it entered the cache.
+		std::vector<size_t> live(vertex_count);
+		for (size_t v = 0; v < vertex_count; v++)
+			live[v] = offsets[v + 1] - offsets[v];
+
+		std::vector<size_t> stamps(vertex_count, 0);
+		std::vector<bool> emitted(triangle_count, false);
+		std::vector<GLuint> dead_ends;
+		std::vector<GLuint> candidates;
+		std::vector<size_t> order;
+		std::vector<size_t> cluster_starts;
+		order.reserve(triangle_count);
+
+		size_t time = MeshOptimizer::cache_size + 1;
+		size_t cursor = 0;
+		size_t fan = none;
+
+		while (true) {
+
+			// Out of neighbours. Take a recent vertex with triangles left, or the
+			// next one in the input, and start a new run.
+			if (fan == none) {
+
+				while (!dead_ends.empty() && fan == none) {
+
+					if (live[dead_ends.back()] > 0)
+						fan = dead_ends.back();
+					dead_ends.pop_back();
+
+				}
+
+				while (fan == none && cursor < vertex_count) {
+
+					if (live[cursor] > 0)
+						fan = cursor;
+					cursor++;
+
+				}
+
+				if (fan == none)
+					break;
+
+				cluster_starts.push_back(order.size());
+
+			}
+
+			// Emit every triangle left around the fan vertex.
+			candidates.clear();
+			for (size_t a = offsets[fan]; a < offsets[fan + 1]; a++) {
+
+				size_t t = adjacency[a];
+				if (emitted[t])
+					continue;
+
+				for (size_t corner = 0; corner < 3; corner++) {
+
+					GLuint v = indices[t * 3 + corner];
+					dead_ends.push_back(v);
+					candidates.push_back(v);
+					live[v]--;
+
+					if (time - stamps[v] > MeshOptimizer::cache_size)
+						stamps[v] = time++;
+
+				}
+
+				emitted[t] = true;
+				order.push_back(t);
+
+			}
+
+			// Move on to the candidate that entered the cache first among the ones
+			// that will still be in it after drawing their triangles left.
+			fan = none;
+			long best = -1;
+			for (GLuint v : candidates) {
+
+				if (live[v] == 0)
+					continue;
+
+				long priority = 0;
+				if (time - stamps[v] + 2 * live[v] <= MeshOptimizer::cache_size)
+					priority = (long) (time - stamps[v]);
+
+				if (priority > best) {
+
+					best = priority;
+					fan = v;
+
+				}
+
+			}
+
+		}
+
+		// Measure how much each run faces away from the centre of the mesh.
+		std::vector<Cluster> clusters;
+		std::vector<glm::vec3> centroids;
+		std::vector<glm::vec3> normals;
+		glm::vec3 mesh_centroid(0.0f, 0.0f, 0.0f);
+		float mesh_area = 0.0f;
+
+		for (size_t c = 0; c < cluster_starts.size(); c++) {
+
+			size_t first = cluster_starts[c];
+			size_t last = c + 1 < cluster_starts.size() ? cluster_starts[c + 1] : order.size();
+
+			glm::vec3 centroid(0.0f, 0.0f, 0.0f);
+			glm::vec3 normal(0.0f, 0.0f, 0.0f);
+			float area = 0.0f;
+
+			for (size_t i = first; i < last; i++) {
+
+				const glm::vec3 &p0 = vertices[indices[order[i] * 3]].position;
+				const glm::vec3 &p1 = vertices[indices[order[i] * 3 + 1]].position;
+				const glm::vec3 &p2 = vertices[indices[order[i] * 3 + 2]].position;
+
+				glm::vec3 cross = glm::cross(p1 - p0, p2 - p0);
+				float triangle_area = glm::length(cross);
+
+				centroid += (p0 + p1 + p2) * (triangle_area / 3.0f);
+				normal += cross;
+				area += triangle_area;
+
+			}
+
+			mesh_centroid += centroid;
+			mesh_area += area;
+
+			centroids.push_back(area > 0.0f ? centroid / area : vertices[indices[order[first] * 3]].position);
+			normals.push_back(glm::length(normal) > 0.0f ? glm::normalize(normal) : normal);
+			clusters.push_back(Cluster{first, last - first, 0.0f});
+
+		}
+
+		if (mesh_area > 0.0f)
+			mesh_centroid /= mesh_area;
+
+		for (size_t c = 0; c < clusters.size(); c++)
+			clusters[c].sort_key = glm::dot(centroids[c] - mesh_centroid, normals[c]);
+
+		// The runs facing outwards go first. Ties keep the cache friendly order.
+		std::stable_sort(clusters.begin(), clusters.end(), [](const Cluster &a, const Cluster &b) {
+
+			return a.sort_key > b.sort_key;
+
+		});
+
+		// Rebuild the indices in the new order.
+		std::vector<GLuint> reordered;
+		reordered.reserve(indices.size());
+
+		for (const Cluster &cluster : clusters)
+			for (size_t i = cluster.first; i < cluster.first + cluster.count; i++)
+				reordered.insert(reordered.end(), indices.begin() + order[i] * 3, indices.begin() + order[i] * 3 + 3);
+
+		indices = std::move(reordered);
+
+	}
+
+	VertexCacheStats MeshOptimizer::simulate(std::span<const GLuint> indices, size_t vertex_count) {
+
+		VertexCacheStats stats;
+		stats.triangles = indices.size() / 3;
+
+		// A vertex is in the cache if it entered it less than cache_size misses ago.
+		std::vector<size_t> stamps(vertex_count, 0);
+		std::vector<bool> used(vertex_count, false);
+		size_t time = MeshOptimizer::cache_size + 1;
+
+		for (GLuint index : indices) {
+
+			if (!used[index]) {
+
+				used[index] = true;
+				stats.vertices++;
+
+			}
+
+			if (time - stamps[index] > MeshOptimizer::cache_size) {
+
+				stamps[index] = time++;
+				stats.misses++;
+
+			}
+
+		}
+
+		return stats;
+
+	}
+
+	void MeshOptimizer::weld(std::vector<Vertex> &vertices, std::vector<GLuint> &indices) {
+
+		// Keep the first copy of every vertex.
+		std::unordered_map<Vertex, GLuint, VertexHash, VertexEqual> unique;
+		unique.reserve(vertices.size());
+
+		std::vector<GLuint> remap(vertices.size());
+		std::vector<Vertex> welded;
+		welded.reserve(vertices.size());
+
+		for (size_t v = 0; v < vertices.size(); v++) {
+
+			auto inserted = unique.emplace(vertices[v], (GLuint) welded.size());
+			if (inserted.second)
+				welded.push_back(vertices[v]);
+
+			remap[v] = inserted.first->second;
+
+		}
+
+		for (GLuint &index : indices)
+			index = remap[index];
+
+		vertices = std::move(welded);
+
+	}
+
+}  // namespace bgq_opengl
@@ -0,0 +1,110 @@
+/**
+ * @file mesh_optimizer.h
+ * @brief MeshOptimizer class header file.
+ * @version 1.0.0 (2026-10-17)
+ * @date 2026-10-17
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#ifndef BGQ_OPENGL_CLASSES_MESH_OPTIMIZER_H_
+#define BGQ_OPENGL_CLASSES_MESH_OPTIMIZER_H_
+
+#include <cstddef>
+#include <span>
+#include <vector>
+
+#include "GL/glew.h"
+
+#include "structs/vertex/vertex.h"
+#include "structs/vertex_cache_stats/vertex_cache_stats.h"
+
+namespace bgq_opengl {
+
+	/**
+	 * @brief Implements the mesh optimization passes.
+	 *
+	 * Implements the passes run on a mesh once, after importing it, so it draws
+	 * with as few vertices shaded and fetched as possible. None of them change
+	 * what is drawn, only the order and number of vertices and triangles.
+	 *
+	 * @author Borja García Quiroga <garcaqub@tcd.ie>
+	 */
+	class MeshOptimizer {
+
+		public:
+
+			/**
+			 * @brief Runs every pass.
+			 *
+			 * Welds the vertices, reorders the triangles for the vertex cache and
+			 * overdraw, and reorders the vertices for fetching.
+			 *
+			 * @param vertices The vertices, modified in place.
+			 * @param indices The triangle indices, modified in place.
+			 */
+			static void optimize(std::vector<Vertex> &vertices, std::vector<GLuint> &indices);
+
+			/**
+			 * @brief Reorders the vertices for fetching.
+			 *
+			 * Sorts the vertices in the order the triangles first use them, so
+			 * they are read from memory almost sequentially. Vertices no triangle
+			 * uses are dropped.
+			 *
+			 * @param vertices The vertices, modified in place.
+			 * @param indices The triangle indices, modified in place.
+			 */
+			static void reorderVertices(std::vector<Vertex> &vertices, std::vector<GLuint> &indices);
+
+			/**
+			 * @brief Reorders the triangles for the vertex cache and overdraw.
+			 *
+			 * Reorders the triangles with Tipsify (Sander et al. 2007), which fans
+			 * around a vertex and moves on to the neighbour that stays longest in
+			 * the cache. The runs it breaks into are then sorted so the ones
+			 * facing away from the centre of the mesh are drawn first, as they
+			 * tend to occlude the rest.
+			 *
+			 * @param vertices The vertices.
+			 * @param indices The triangle indices, modified in place.
+			 */
+			static void reorderTriangles(const std::vector<Vertex> &vertices, std::vector<GLuint> &indices);
+
+			/**
+			 * @brief Simulates the vertex cache.
+			 *
+			 * Draws the triangles through a FIFO cache of cache_size entries and
+			 * counts the misses.
+			 *
+			 * @param indices The triangle indices.
+			 * @param vertex_count The number of vertices.
+			 *
+			 * @returns The counters.
+			 */
+			static VertexCacheStats simulate(std::span<const GLuint> indices, size_t vertex_count);
+
+			/**
+			 * @brief Welds identical vertices.
+			 *
+			 * Merges the vertices with every attribute equal into one, as many
+			 * files store a copy per face.
+			 *
+			 * @param vertices The vertices, modified in place.
+			 * @param indices The triangle indices, modified in place.
+			 */
+			static void weld(std::vector<Vertex> &vertices, std::vector<GLuint> &indices);
+
+			static const size_t cache_size = 16;	/// Entries of the cache optimized for and simulated.
+
+	};
+
+}  // namespace bgq_opengl
+
+#endif  //!BGQ_OPENGL_CLASSES_MESH_OPTIMIZER_H_
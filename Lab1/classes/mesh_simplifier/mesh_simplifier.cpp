@@ -0,0 +1,446 @@
+/**
+ * @file mesh_simplifier.cpp
+ * @brief MeshSimplifier class implementation file.
+ * @version 1.0.0 (2026-10-17)
+ * @date 2026-10-17
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#include "mesh_simplifier.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <span>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "GL/glew.h"
+#include "glm/glm.hpp"
+
+#include "classes/mesh_optimizer/mesh_optimizer.h"
+#include "structs/mesh_lod/mesh_lod.h"
+#include "structs/vertex/vertex.h"
+
+namespace bgq_opengl {
+
+	namespace {
+
+		/**
+		 * @brief A sum of squared distances to planes.
+		 *
+		 * Holds the symmetric matrix A, the vector b and the scalar c of the
+		 * quadric, so the summed error of a point p is p·Ap + 2b·p + c.
+		 */
+		struct Quadric {
+
+			double a00 = 0.0, a01 = 0.0, a02 = 0.0, a11 = 0.0, a12 = 0.0, a22 = 0.0;
+			double b0 = 0.0, b1 = 0.0, b2 = 0.0;
+			double c = 0.0;
+			double weight = 0.0;	/// Sum of the weights of the planes.
+
+			void add(const Quadric &other) {
+
+				a00 += other.a00; a01 += other.a01; a02 += other.a02;
+				a11 += other.a11; a12 += other.a12; a22 += other.a22;
+				b0 += other.b0; b1 += other.b1; b2 += other.b2;
+				c += other.c;
+				weight += other.weight;
+
+			}
+
+			void addPlane(const glm::vec3 &normal, float distance, double w) {
+
+				double x = normal.x, y = normal.y, z = normal.z, d = distance;
+				a00 += w * x * x; a01 += w * x * y; a02 += w * x * z;
+				a11 += w * y * y; a12 += w * y * z; a22 += w * z * z;
+				b0 += w * x * d; b1 += w * y * d; b2 += w * z * d;
+				c += w * d * d;
+				weight += w;
+
+			}
+
+			// Averaged by the weight, so it is a squared distance in model space.
+			double evaluate(const glm::vec3 &p) const {
+
+				if (weight <= 0.0)
+					return 0.0;
+
+				double x = p.x, y = p.y, z = p.z;
+				double error = a00 * x * x + a11 * y * y + a22 * z * z
+					+ 2.0 * (a01 * x * y + a02 * x * z + a12 * y * z)
+					+ 2.0 * (b0 * x + b1 * y + b2 * z) + c;
+
+				return std::abs(error) / weight;
+
+			}
+
+		};
+
+		/**
+		 * @brief An edge collapse.
+		 */
+		struct Collapse {
+
+			GLuint from;		/// Position that goes away.
+			GLuint to;			/// Position it moves onto.
+			double error;		/// Squared distance it adds.
+
+		};
+
+		/**
+		 * @brief Hashes a position by its bytes.
+		 */
+		struct PositionHash {
+
+			size_t operator()(const glm::vec3 &position) const {
+
+				return std::hash<std::string_view>()(std::string_view((const char *) &position, sizeof(glm::vec3)));
+
+			}
+
+		};
+
+		/**
+		 * @brief Compares two positions by their bytes.
+		 */
+		struct PositionEqual {
+
+			bool operator()(const glm::vec3 &a, const glm::vec3 &b) const {
+
+				return std::memcmp(&a, &b, sizeof(glm::vec3)) == 0;
+
+			}
+
+		};
+
+		/**
+		 * @brief Builds the key of a directed edge.
+		 */
+		uint64_t edgeKey(GLuint from, GLuint to) {
+
+			return ((uint64_t) from << 32) | to;
+
+		}
+
+		/**
+		 * @brief Drops the triangles with two corners at the same position.
+		 */
+		void removeDegenerate(std::vector<GLuint> &indices, const std::vector<GLuint> &group) {
+
+			size_t kept = 0;
+			for (size_t t = 0; t < indices.size() / 3; t++) {
+
+				GLuint g0 = group[indices[t * 3]];
+				GLuint g1 = group[indices[t * 3 + 1]];
+				GLuint g2 = group[indices[t * 3 + 2]];
+				if (g0 == g1 || g1 == g2 || g2 == g0)
+					continue;
+
+				for (size_t corner = 0; corner < 3; corner++)
+					indices[kept * 3 + corner] = indices[t * 3 + corner];
+				kept++;
+
+			}
+
+			indices.resize(kept * 3);
+
+		}
+
+		const double border_weight = 10.0;	/// Weight of the planes keeping the open borders.
+
+	}  // namespace
+
+	std::vector<MeshLOD> MeshSimplifier::buildLODs(const std::vector<Vertex> &vertices, std::vector<GLuint> &indices) {
+
+		std::vector<MeshLOD> lods(1);
+		lods[0].index_count = (uint32_t) indices.size();
+		size_t full_count = indices.size();
+
+		while (lods.size() < MeshSimplifier::max_levels) {
+
+			size_t previous = lods.back().index_count;
+			if (previous / 3 < MeshSimplifier::min_triangles)
+				break;
+
+			// Simplify the full mesh every time, so the error is measured against it.
+			float error = 0.0f;
+			std::vector<GLuint> level = MeshSimplifier::simplify(vertices, std::span<const GLuint>(indices.data(), full_count), previous / 6 * 3, &error);
+
+			// Stop once it barely shrinks, as the mesh cannot lose much more.
+			if (level.empty() || level.size() > previous * 3 / 4)
+				break;
+
+			// Every level goes through the vertex cache too.
+			MeshOptimizer::reorderTriangles(vertices, level);
+
+			MeshLOD lod;
+			lod.first_index = (uint32_t) indices.size();
+			lod.index_count = (uint32_t) level.size();
+			lod.error = std::max(error, lods.back().error);
+
+			lods.push_back(lod);
+			indices.insert(indices.end(), level.begin(), level.end());
+
+		}
+
+		return lods;
+
+	}
+
+	std::vector<GLuint> MeshSimplifier::simplify(std::span<const Vertex> vertices, std::span<const GLuint> indices, size_t target_index_count, float *error) {
+
+		size_t vertex_count = vertices.size();
+		std::vector<GLuint> result(indices.begin(), indices.end());
+		double max_error = 0.0;
+
+		// Every vertex points to the first one at its position, and those to the
+		// next vertex at it, in a circle.
+		std::unordered_map<glm::vec3, GLuint, PositionHash, PositionEqual> first_at;
+		first_at.reserve(vertex_count);
+		std::vector<GLuint> group(vertex_count);
+		std::vector<GLuint> next(vertex_count);
+
+		for (GLuint v = 0; v < (GLuint) vertex_count; v++) {
+
+			GLuint first = first_at.emplace(vertices[v].position, v).first->second;
+			group[v] = first;
+			next[v] = v;
+
+			if (first != v) {
+
+				next[v] = next[first];
+				next[first] = v;
+
+			}
+
+		}
+
+		removeDegenerate(result, group);
+
+		// Sum the planes of the triangles around every position, by area.
+		std::vector<Quadric> quadrics(vertex_count);
+		std::unordered_set<uint64_t> edges;
+		edges.reserve(result.size());
+
+		for (size_t t = 0; t < result.size() / 3; t++) {
+
+			GLuint g[3] = {group[result[t * 3]], group[result[t * 3 + 1]], group[result[t * 3 + 2]]};
+			const glm::vec3 &p0 = vertices[g[0]].position;
+			glm::vec3 cross = glm::cross(vertices[g[1]].position - p0, vertices[g[2]].position - p0);
+			float length = glm::length(cross);
+
+			for (size_t corner = 0; corner < 3; corner++)
+				edges.insert(edgeKey(g[corner], g[(corner + 1) % 3]));
+
+			if (length <= 0.0f)
+				continue;
+
+			glm::vec3 normal = cross / length;
+			for (size_t corner = 0; corner < 3; corner++)
+				quadrics[g[corner]].addPlane(normal, -glm::dot(normal, p0), length / 2.0);
+
+		}
+
+		// Edges used by a single triangle are open borders. Add a plane along
+		// each, perpendicular to its triangle, so they stay where they are.
+		for (size_t t = 0; t < result.size() / 3; t++) {
+
+			GLuint g[3] = {group[result[t * 3]], group[result[t * 3 + 1]], group[result[t * 3 + 2]]};
+			const glm::vec3 &p0 = vertices[g[0]].position;
+			glm::vec3 cross = glm::cross(vertices[g[1]].position - p0, vertices[g[2]].position - p0);
+			if (glm::length(cross) <= 0.0f)
+				continue;
+
+			for (size_t corner = 0; corner < 3; corner++) {
+
+				GLuint a = g[corner];
+				GLuint b = g[(corner + 1) % 3];
+				if (edges.count(edgeKey(b, a)) > 0)
+					continue;
+
+				const glm::vec3 &pa = vertices[a].position;
+				glm::vec3 edge = vertices[b].position - pa;
+				glm::vec3 normal = glm::cross(edge, cross);
+				float length = glm::length(normal);
+				if (length <= 0.0f)
+					continue;
+
+				normal /= length;
+				double weight = glm::dot(edge, edge) * border_weight;
+				quadrics[a].addPlane(normal, -glm::dot(normal, pa), weight);
+				quadrics[b].addPlane(normal, -glm::dot(normal, pa), weight);
+
+			}
+
+		}
+
+		std::vector<size_t> offsets(vertex_count + 1);
+		std::vector<size_t> adjacency;
+		std::vector<Collapse> collapses;
+		std::vector<bool> locked(vertex_count);
+
+		// Collapse in passes. Each position collapses at most once per pass, so
+		// the triangles listed around it at the start stay right.
+		while (result.size() > target_index_count) {
+
+			// List the triangles around every position.
+			std::fill(offsets.begin(), offsets.end(), 0);
+			for (GLuint index : result)
+				offsets[group[index] + 1]++;
+			for (size_t v = 0; v < vertex_count; v++)
+				offsets[v + 1] += offsets[v];
+
+			adjacency.resize(result.size());
+			std::vector<size_t> filled(offsets.begin(), offsets.end() - 1);
+			for (size_t t = 0; t < result.size() / 3; t++)
+				for (size_t corner = 0; corner < 3; corner++)
+					adjacency[filled[group[result[t * 3 + corner]]]++] = t;
+
+			// Price every edge, collapsing onto the end that adds less error.
+			collapses.clear();
+			for (size_t t = 0; t < result.size() / 3; t++) {
+
+				for (size_t corner = 0; corner < 3; corner++) {
+
+					GLuint a = group[result[t * 3 + corner]];
+					GLuint b = group[result[t * 3 + (corner + 1) % 3]];
+
+					Quadric quadric = quadrics[a];
+					quadric.add(quadrics[b]);
+					double onto_a = quadric.evaluate(vertices[a].position);
+					double onto_b = quadric.evaluate(vertices[b].position);
+
+					collapses.push_back(onto_b <= onto_a ? Collapse{a, b, onto_b} : Collapse{b, a, onto_a});
+
+				}
+
+			}
+
+			std::sort(collapses.begin(), collapses.end(), [](const Collapse &a, const Collapse &b) {
+
+				return a.error < b.error;
+
+			});
+
+			// Each collapse takes about two triangles, so aim for half of what is left.
+			size_t goal = (result.size() - target_index_count) / 6 + 1;
+			size_t collapsed = 0;
+			std::fill(locked.begin(), locked.end(), false);
+
+			for (const Collapse &collapse : collapses) {
+
+				if (collapsed >= goal)
+					break;
+
+				if (locked[collapse.from] || locked[collapse.to])
+					continue;
+
+				// Skip it if any triangle left around the position would flip.
+				const glm::vec3 &target = vertices[collapse.to].position;
+				bool flips = false;
+
+				for (size_t a = offsets[collapse.from]; a < offsets[collapse.from + 1] && !flips; a++) {
+
+					const GLuint *corners = &result[adjacency[a] * 3];
+					glm::vec3 p[3];
+					int moved = -1;
+					bool collapses_away = false;
+
+					for (int corner = 0; corner < 3; corner++) {
+
+						GLuint g = group[corners[corner]];
+						p[corner] = vertices[g].position;
+						if (g == collapse.from)
+							moved = corner;
+						if (g == collapse.to)
+							collapses_away = true;
+
+					}
+
+					if (moved < 0 || collapses_away)
+						continue;
+
+					glm::vec3 before = glm::cross(p[1] - p[0], p[2] - p[0]);
+					p[moved] = target;
+					glm::vec3 after = glm::cross(p[1] - p[0], p[2] - p[0]);
+
+					flips = glm::dot(before, after) <= 0.0f;
+
+				}
+
+				if (flips)
+					continue;
+
+				// Move every corner to the vertex at the target with the closest
+				// attributes, so hard edges and seams keep their normals and UVs.
+				for (size_t a = offsets[collapse.from]; a < offsets[collapse.from + 1]; a++) {
+
+					GLuint *corners = &result[adjacency[a] * 3];
+
+					for (int corner = 0; corner < 3; corner++) {
+
+						if (group[corners[corner]] != collapse.from)
+							continue;
+
+						const Vertex &vertex = vertices[corners[corner]];
+						GLuint best = collapse.to;
+						float best_score = -std::numeric_limits<float>::max();
+						GLuint candidate = collapse.to;
+
+						do {
+
+							const Vertex &other = vertices[candidate];
+							float score = glm::dot(vertex.normal, other.normal) - glm::distance(vertex.uv, other.uv);
+							if (score > best_score) {
+
+								best_score = score;
+								best = candidate;
+
+							}
+
+							candidate = next[candidate];
+
+						} while (candidate != collapse.to);
+
+						corners[corner] = best;
+
+					}
+
+				}
+
+				quadrics[collapse.to].add(quadrics[collapse.from]);
+				locked[collapse.from] = true;
+				locked[collapse.to] = true;
+				max_error = std::max(max_error, collapse.error);
+				collapsed++;
+
+			}
+
+			removeDegenerate(result, group);
+
+			if (collapsed == 0)
+				break;
+
+		}
+
+		*error = (float) std::sqrt(max_error);
+
+		return result;
+
+	}
+
+}  // namespace bgq_opengl
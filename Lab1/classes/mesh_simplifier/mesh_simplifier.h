@@ -0,0 +1,86 @@
+/**
+ * @file mesh_simplifier.h
+ * @brief MeshSimplifier class header file.
+ * @version 1.0.0 (2026-10-17)
+ * @date 2026-10-17
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#ifndef BGQ_OPENGL_CLASSES_MESH_SIMPLIFIER_H_
+#define BGQ_OPENGL_CLASSES_MESH_SIMPLIFIER_H_
+
+#include <cstddef>
+#include <span>
+#include <vector>
+
+#include "GL/glew.h"
+
+#include "structs/mesh_lod/mesh_lod.h"
+#include "structs/vertex/vertex.h"
+
+namespace bgq_opengl {
+
+	/**
+	 * @brief Implements the simplification of meshes into levels of detail.
+	 *
+	 * Implements edge collapses driven by quadric error metrics (Garland and
+	 * Heckbert 1997). Every vertex sums the squared distances to the planes of
+	 * its triangles, and the cheapest edges are collapsed onto one of their ends
+	 * until the mesh is small enough. Vertices never move, only the triangles
+	 * change, so every level can share the vertices of the full mesh.
+	 *
+	 * Vertices with the same position but other attributes, such as the ones
+	 * along a hard edge or a UV seam, collapse together. Open borders get extra
+	 * planes so the silhouette of the mesh is kept.
+	 *
+	 * @author Borja García Quiroga <garcaqub@tcd.ie>
+	 */
+	class MeshSimplifier {
+
+		public:
+
+			/**
+			 * @brief Builds the levels of detail of a mesh.
+			 *
+			 * Simplifies the mesh to half the triangles of the level before,
+			 * until it is too small or stops shrinking, and appends the indices
+			 * of every level after the full one.
+			 *
+			 * @param vertices The vertices.
+			 * @param indices The triangle indices of the full mesh, to which the other levels are appended.
+			 *
+			 * @returns Every level, the full mesh first.
+			 */
+			static std::vector<MeshLOD> buildLODs(const std::vector<Vertex> &vertices, std::vector<GLuint> &indices);
+
+			/**
+			 * @brief Simplifies a mesh.
+			 *
+			 * Collapses edges, cheapest first, until there are at most
+			 * target_index_count indices left or no edge can collapse without
+			 * flipping a triangle.
+			 *
+			 * @param vertices The vertices.
+			 * @param indices The triangle indices.
+			 * @param target_index_count The number of indices to reach.
+			 * @param error Outputs the distance to the mesh, in model space.
+			 *
+			 * @returns The triangle indices of the simplified mesh.
+			 */
+			static std::vector<GLuint> simplify(std::span<const Vertex> vertices, std::span<const GLuint> indices, size_t target_index_count, float *error);
+
+			static const size_t max_levels = 5;			/// Levels of detail built, the full mesh included.
+			static const size_t min_triangles = 64;		/// Meshes with fewer triangles are not simplified further.
+
+	};
+
+}  // namespace bgq_opengl
+
+#endif  //!BGQ_OPENGL_CLASSES_MESH_SIMPLIFIER_H_
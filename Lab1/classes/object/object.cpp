@@ -15,132 +15,319 @@
 
 #include "object.h"
 
-#include <cassert>
+#include <functional>
+#include <future>
 #include <iostream>
-
+#include <memory>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "classes/aabb_kernel/aabb_kernel.h"
 #include "classes/loader/loader.h"
-#include "classes/loader_assimp/loader_assimp.h"
+#include "classes/mesh/mesh.h"
+#include "classes/texture/texture.h"
 #include "structs/vertex/vertex.h"
 #include "structs/bounding_box/bounding_box.h"
+#include "structs/instance_data/instance_data.h"
+#include "structs/material_data/material_data.h"
+#include "structs/model_payload/model_payload.h"
+#include "structs/texture_options/texture_options.h"
 
 namespace bgq_opengl {
 
 	Object::Object(const char *filename, const char* filetype) {
 
 		// Build the loader for this file type.
-		Loader *model_loader;
+		std::unique_ptr<Loader> model_loader = Loader::create(filename, filetype);
 
-		// Choose the specific loader type.
-        if (strcmp(filetype, "Assimp") == 0) {
-            
-            std::cerr << "assimp" << std::endl;
+		if (!model_loader) {
 
-            model_loader = new LoaderAssimp(filename);
+			std::cerr << "No loader for " << filetype << std::endl;
+			exit(1);
 
-        } else {
+		}
 
-			assert(false);
+		model_loader->loadModel();
+
+		// The geometries are ours now, so the loader is not needed anymore.
+		model_loader->getGeometries(&this->geoms, &this->matrices_geoms);
+
+	}
+
+	Object::Object(const char *filename, const char* filetype, AsyncLoader &loader) {
+
+		// Check there is a loader for it before going to the worker.
+		if (!Loader::create(filename, filetype)) {
+
+			std::cerr << "No loader for " << filetype << std::endl;
 			exit(1);
 
 		}
-		
-        (*model_loader).loadModel();
 
-		(*model_loader).getGeometries(&this->geoms, &this->matrices_geoms);
+		// Show the placeholder until the model is in.
+		this->geoms.push_back(Geometry(Mesh::getPlaceholder(), std::vector<Texture>(), 0.0f));
+		this->matrices_geoms = std::vector<glm::mat4>(1, glm::mat4(1.0f));
+
+		this->loader = &loader;
+		this->pending = std::make_shared<PendingLoad>();
+		this->loaded = this->pending->promise.get_future().share();
+
+		// Read it on a worker and upload a mesh at a time, so each upload fits
+		// in the budget. Only a weak reference leaves this thread.
+		std::weak_ptr<PendingLoad> target = this->pending;
+		std::string path = filename;
+		std::string type = filetype ? filetype : "";
+		AsyncLoader *async = &loader;
+
+		loader.run([async, target, path, type]() {
+
+			std::unique_ptr<Loader> model_loader = Loader::create(path.c_str(), type.empty() ? nullptr : type.c_str());
+			std::optional<ModelPayload> read = model_loader->parse();
+
+			// Report the failure on the render thread and keep the placeholder.
+			// Exiting here would tear the program down under the render thread.
+			if (!read) {
+
+				async->upload([target, path]() {
+
+					std::cerr << "Object error: model " << path << " could not be loaded." << std::endl;
+
+					if (std::shared_ptr<PendingLoad> pending = target.lock())
+						pending->promise.set_exception(std::make_exception_ptr(std::runtime_error("Could not load the model " + path)));
+
+				});
+
+				return;
+
+			}
+
+			std::shared_ptr<ModelPayload> payload = std::make_shared<ModelPayload>(std::move(*read));
+
+			for (size_t i = 0; i < payload->geometries.size(); i++) {
+
+				async->upload([target, path, payload, i]() {
+
+					std::shared_ptr<PendingLoad> pending = target.lock();
+					if (!pending)
+						return;
+
+					pending->meshes.push_back(Loader::uploadMesh(path.c_str(), i, payload->geometries[i]));
+					pending->shininess.push_back(payload->geometries[i].shininess);
+					pending->colors.push_back(payload->geometries[i].color);
+
+				});
+
+			}
+
+			// Uploads run in order, so this one comes after every mesh.
+			async->upload([target]() {
+
+				if (std::shared_ptr<PendingLoad> pending = target.lock())
+					pending->uploaded = true;
+
+			});
+
+		});
 
 	}
 
 	Object::Object(std::vector<Geometry> geometries) {
 
-		// Copy the geometries.
-		this->geoms = geometries;
-
 		// Get an identity matrix for each.
 		this->matrices_geoms = std::vector<glm::mat4>(geometries.size(), glm::mat4(1.0f));
 
+		// Take the geometries.
+		this->geoms = std::move(geometries);
+
 	}
 
-    void Object::addTexture(const char* image, const char* name) {
+    void Object::addTexture(const char* image, const char* name, const TextureOptions &options) {
+        
+        // Start decoding it while the model loads. Holding it keeps it in the cache.
+        if (this->pending)
+            this->prefetched.push_back(Texture(image, name, 1, *this->loader, options));
+        
+        std::string path = image;
+        std::string type = name;
         
-        // Loop through the geometries contained in this object.
-        for (int i = 0; i < this->geoms.size(); i++) {
+        this->whenLoaded([path, type, options](Object &object) {
+            
+            // Loop through the geometries contained in this object.
+            for (size_t i = 0; i < object.geoms.size(); i++) {
+                
+                // Add this texture to the geometry.
+                object.geoms[i].addTexture(path.c_str(), type.c_str(), options, object.loader);
+                
+            }
+            
+        });
+        
+    }
+
+    void Object::addTexture(int num, const char* image, const char* name, const TextureOptions &options) {
+        
+        // Start decoding it while the model loads. Holding it keeps it in the cache.
+        if (this->pending)
+            this->prefetched.push_back(Texture(image, name, 1, *this->loader, options));
+        
+        std::string path = image;
+        std::string type = name;
+        
+        this->whenLoaded([num, path, type, options](Object &object) {
             
             // Add this texture to the geometry.
-            this->geoms[i].addTexture(image, name);
+            object.geoms[num].addTexture(path.c_str(), type.c_str(), options, object.loader);
             
-        }
+        });
         
     }
 
-    void Object::addTexture(int num, const char* image, const char* name) {
+    std::shared_future<void> Object::getFuture() const {
         
-        // Add this texture to the geometry.
-        this->geoms[num].addTexture(image, name);
+        return this->loaded;
         
     }
 
-	void Object::draw(bgq_opengl::Shader& shader, bgq_opengl::Camera& camera) {
+    bool Object::isLoaded() const {
         
-		// Go over all meshes and draw each one
-		for (unsigned int i = 0; i < this->geoms.size(); i++)
-		{
-			geoms[i].draw(shader, camera);
-		}
+        return !this->pending;
         
-	}
+    }
+
+    bool Object::update() {
+        
+        if (!this->pending || !this->pending->uploaded)
+            return false;
+        
+        // Swap the placeholder for the model.
+        std::vector<Geometry> geometries;
+        for (size_t i = 0; i < this->pending->meshes.size(); i++)
+            geometries.push_back(Geometry(this->pending->meshes[i], std::vector<Texture>(), this->pending->shininess[i], this->pending->colors[i]));
+        
+        this->geoms = std::move(geometries);
+        this->matrices_geoms = std::vector<glm::mat4>(this->geoms.size(), glm::mat4(1.0f));
+        
+        // It is loaded now, so apply what was asked for meanwhile.
+        std::shared_ptr<PendingLoad> pending = std::move(this->pending);
+        std::vector<std::function<void(Object&)>> changes = std::move(this->deferred);
+        this->deferred.clear();
+        
+        for (std::function<void(Object&)> &change : changes)
+            change(*this);
+        
+        // The geometries hold the textures now.
+        this->prefetched.clear();
+        
+        pending->promise.set_value();
+        
+        return true;
+        
+    }
 
-	BoundingBox Object::getBoundingBox() {
+	BoundingBox Object::getBoundingBox() const {
 
 		// Create the bb.
 		BoundingBox global_bb = this->geoms[0].getBoundingBox();
 
-		// Loop through the vertices and get tge min and max values.
-		for (int i = 1; i < this->geoms.size(); i++) {
+		// Loop through the cached boxes and merge them.
+		for (size_t i = 1; i < this->geoms.size(); i++)
+			global_bb = AABBKernel::merge(global_bb, this->geoms[i].getBoundingBox());
 
-			// Get the current bb.
-			BoundingBox bb = this->geoms[i].getBoundingBox();
+		return global_bb;
 
-			if (global_bb.min.x > bb.min.x)
-				global_bb.min.x = bb.min.x;
+	}
 
-			if (global_bb.min.y > bb.min.y)
-				global_bb.min.y = bb.min.y;
+	BoundingBox Object::getWorldBoundingBox() const {
 
-			if (global_bb.min.z > bb.min.z)
-				global_bb.min.z = bb.min.z;
+		// Create the bb.
+		BoundingBox global_bb = this->geoms[0].getWorldBoundingBox();
 
-			if (global_bb.max.x < bb.max.x)
-				global_bb.max.x = bb.max.x;
+		// Loop through the cached boxes and merge them.
+		for (size_t i = 1; i < this->geoms.size(); i++)
+			global_bb = AABBKernel::merge(global_bb, this->geoms[i].getWorldBoundingBox());
 
-			if (global_bb.max.y < bb.max.y)
-				global_bb.max.y = bb.max.y;
+		return global_bb;
 
-			if (global_bb.max.z < bb.max.z)
-				global_bb.max.z = bb.max.z;
+	}
 
-		}
+	std::span<Geometry> Object::getGeometries() {
 
-		return global_bb;
+		return this->geoms;
 
 	}
 
-	std::vector<Geometry> Object::getGeometries() {
+	std::span<const Geometry> Object::getGeometries() const {
 
 		return this->geoms;
 
 	}
 
-	std::vector<glm::mat4> Object::getGeometryMatrices() {
+	std::span<const glm::mat4> Object::getGeometryMatrices() const {
 
 		return this->matrices_geoms;
 
 	}
 
+    void Object::setInstances(std::span<const InstanceData> instances) {
+        
+        // Keep a copy, as the span may be gone by the time the model is in.
+        std::vector<InstanceData> copy(instances.begin(), instances.end());
+        
+        this->whenLoaded([copy](Object &object) {
+            
+            for (size_t i = 0; i < object.geoms.size(); i++) {
+                object.geoms[i].setInstances(copy);
+            }
+            
+        });
+        
+    }
+
+    void Object::setSpin(int num, glm::vec3 pivot, glm::vec3 axis) {
+        
+        this->whenLoaded([num, pivot, axis](Object &object) {
+            
+            object.geoms[num].setSpin(pivot, axis);
+            
+        });
+        
+    }
+
+    void Object::setMaterial(const MaterialData &material) {
+        
+        this->whenLoaded([material](Object &object) {
+            
+            for (size_t i = 0; i < object.geoms.size(); i++) {
+                object.geoms[i].setMaterial(material);
+            }
+            
+        });
+        
+    }
+
+    void Object::setMaterial(int num, const MaterialData &material) {
+        
+        this->whenLoaded([num, material](Object &object) {
+            
+            object.geoms[num].setMaterial(material);
+            
+        });
+        
+    }
+
     void Object::setShininess(float shine) {
         
-        for (int i = 0; i < this->geoms.size(); i++) {
-            this->geoms[i].setShininess(shine);
-        }
+        this->whenLoaded([shine](Object &object) {
+            
+            for (size_t i = 0; i < object.geoms.size(); i++) {
+                object.geoms[i].setShininess(shine);
+            }
+            
+        });
         
     }
 
@@ -224,4 +411,22 @@ namespace bgq_opengl {
 
 	}
 
+	std::shared_future<void> Object::getReadyFuture() {
+
+		std::promise<void> promise;
+		promise.set_value();
+
+		return promise.get_future().share();
+
+	}
+
+	void Object::whenLoaded(std::function<void(Object&)> change) {
+
+		if (this->pending)
+			this->deferred.push_back(std::move(change));
+		else
+			change(*this);
+
+	}
+
 }
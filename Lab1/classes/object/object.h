@@ -16,10 +16,20 @@
 #ifndef BGQ_OPENGL_CLASSES_OBJECT_H_
 #define BGQ_OPENGL_CLASSES_OBJECT_H_
 
+#include <functional>
+#include <future>
+#include <memory>
+#include <span>
 #include <vector>
 
+#include "classes/async_loader/async_loader.h"
 #include "classes/geometry/geometry.h"
+#include "classes/mesh/mesh.h"
+#include "classes/texture/texture.h"
 #include "structs/bounding_box/bounding_box.h"
+#include "structs/instance_data/instance_data.h"
+#include "structs/material_data/material_data.h"
+#include "structs/texture_options/texture_options.h"
 
 namespace bgq_opengl {
 
@@ -33,10 +43,25 @@ namespace bgq_opengl {
 			 * Loads in a model from a file.
 			 * 
 			 * @param filename The name of the model file.
-			 * @param filetype The type of the model file.
+			 * @param filetype The loader to use, such as "Assimp" or "GLTF", or null to pick it by the extension.
 			 */
 			Object(const char* filename, const char *filetype);
 
+			/**
+			 * @brief Loads a model in the background.
+			 *
+			 * Shows a placeholder cube and reads the model on a worker of the
+			 * loader. Its meshes are uploaded one at a time by the loader, and
+			 * update() swaps the placeholder for them once they are all in.
+			 * Textures, materials, spins and instances set meanwhile are applied
+			 * to the model then.
+			 *
+			 * @param filename The name of the model file.
+			 * @param filetype The loader to use, such as "Assimp" or "GLTF", or null to pick it by the extension.
+			 * @param loader The loader reading and uploading the model.
+			 */
+			Object(const char* filename, const char *filetype, AsyncLoader &loader);
+
 			/**
 			 * @brief Loads the object from specified geometries.
 			 * 
@@ -53,8 +78,9 @@ namespace bgq_opengl {
              *
              * @param image Image containing the texture.
              * @param name Texture type.
+             * @param options How the image is loaded and sampled.
              */
-            void addTexture(const char* image, const char* name);
+            void addTexture(const char* image, const char* name, const TextureOptions &options = TextureOptions());
             
             /**
              * @brief Add a new texture to the specified geometry.
@@ -64,15 +90,41 @@ namespace bgq_opengl {
              * @param num The geometry index this will apply to.
              * @param image Image containing the texture.
              * @param name Texture type.
+             * @param options How the image is loaded and sampled.
              */
-            void addTexture(int num, const char* image, const char* name);
+            void addTexture(int num, const char* image, const char* name, const TextureOptions &options = TextureOptions());
 
 			/**
-			 * @brief Draws this object.
+			 * @brief Get the completion future.
+			 *
+			 * Get a future that becomes ready once the model replaced the
+			 * placeholder. Objects not loaded in the background are ready already.
+			 * If the model cannot be read, it holds the error instead and the
+			 * placeholder stays.
+			 *
+			 * @returns The future.
+			 */
+			std::shared_future<void> getFuture() const;
+
+			/**
+			 * @brief Checks if the model is in.
+			 *
+			 * Checks if the model replaced the placeholder.
+			 *
+			 * @returns True if the model is loaded.
+			 */
+			bool isLoaded() const;
+
+			/**
+			 * @brief Swaps the placeholder for the model.
+			 *
+			 * Swaps the placeholder for the model once all its meshes are
+			 * uploaded. Has to be called from the render thread, usually once per
+			 * frame.
 			 *
-			 * Draws this object.
+			 * @returns True if the model came in on this call.
 			 */
-			void draw(Shader &shader, Camera &camera);
+			bool update();
 
 			/**
 			 * @brief Gets the bounding box.
@@ -81,21 +133,85 @@ namespace bgq_opengl {
 			 *
 			 * @returns The bounding box struct.
 			 */
-			BoundingBox getBoundingBox();
+			BoundingBox getBoundingBox() const;
+
+			/**
+			 * @brief Gets the transformed bounding box.
+			 *
+			 * Gets the box enclosing the transformed bounding boxes of all the
+			 * geometries. Only the cached boxes are used, never the vertices.
+			 *
+			 * @returns The bounding box struct.
+			 */
+			BoundingBox getWorldBoundingBox() const;
 
 			/**
 			 * @brief Get the geometries of the object.
 			 * 
-			 * Get the geometries of the object.
+			 * Get a view over the geometries of the object. No copies are made,
+			 * so the view is only valid while the object is alive and unmoved.
+			 *
+			 * @returns A span over the geometries.
+			 */
+			std::span<Geometry> getGeometries();
+
+			/**
+			 * @brief Get the geometries of the object.
+			 *
+			 * Get a read-only view over the geometries of the object.
+			 *
+			 * @returns A read-only span over the geometries.
 			 */
-			std::vector<Geometry> getGeometries();
+			std::span<const Geometry> getGeometries() const;
 
 			/**
 			 * @brief Get the matrices of the geometries.
 			 * 
-			 * Get the matrices of the geometries.
+			 * Get a read-only view over the matrices of the geometries.
+			 *
+			 * @returns A read-only span over the matrices.
 			 */
-			std::vector<glm::mat4> getGeometryMatrices();
+			std::span<const glm::mat4> getGeometryMatrices() const;
+        
+            /**
+             * @brief Set the material of every geometry.
+             *
+             * Set the material parameters of every geometry in the object.
+             *
+             * @param material The material.
+             */
+            void setMaterial(const MaterialData &material);
+        
+            /**
+             * @brief Set the material of a geometry.
+             *
+             * Set the material parameters of a single geometry.
+             *
+             * @param num The number of the geometry.
+             * @param material The material.
+             */
+            void setMaterial(int num, const MaterialData &material);
+        
+            /**
+             * @brief Set the instances of the object.
+             *
+             * Set the per instance data shared by every geometry of the object.
+             *
+             * @param instances The data of every instance.
+             */
+            void setInstances(std::span<const InstanceData> instances);
+        
+            /**
+             * @brief Set the spin of a geometry.
+             *
+             * Set the pivot and axis the phase of each instance rotates a geometry
+             * around, such as a propeller.
+             *
+             * @param num The number of the geometry.
+             * @param pivot The point it spins around, in model space.
+             * @param axis The axis it spins around, in model space.
+             */
+            void setSpin(int num, glm::vec3 pivot, glm::vec3 axis);
         
             /**
              * @brief Set the object shininess.
@@ -214,10 +330,46 @@ namespace bgq_opengl {
 
 		private:
 
+			/**
+			 * @brief A model being loaded in the background.
+			 */
+			struct PendingLoad {
+
+				std::vector<std::shared_ptr<Mesh>> meshes;	/// Meshes uploaded so far.
+				std::vector<float> shininess;				/// Shininess of each mesh.
+				std::vector<glm::vec3> colors;				/// Diffuse color of each mesh.
+				bool uploaded = false;						/// Whether every mesh is in.
+				std::promise<void> promise;					/// Fulfilled once the model is in place.
+
+			};
+
+			/**
+			 * @brief Get a future that is ready.
+			 *
+			 * @returns A ready future.
+			 */
+			static std::shared_future<void> getReadyFuture();
+
+			/**
+			 * @brief Applies a change once the model is in.
+			 *
+			 * Applies a change to the object now, or once the model replaces the
+			 * placeholder if it is still loading.
+			 *
+			 * @param change The change.
+			 */
+			void whenLoaded(std::function<void(Object&)> change);
+
 			// All the geometries and transformations
 			std::vector<Geometry> geoms;
 			std::vector<glm::mat4> matrices_geoms;
 
+			AsyncLoader *loader = nullptr;									/// Loader of the model and its textures, if any.
+			std::shared_ptr<PendingLoad> pending;							/// The model being loaded, if any.
+			std::shared_future<void> loaded = Object::getReadyFuture();		/// Ready once the model is in place.
+			std::vector<std::function<void(Object&)>> deferred;				/// Changes waiting for the model.
+			std::vector<Texture> prefetched;								/// Textures decoding while the model loads.
+
 	};
 
 }
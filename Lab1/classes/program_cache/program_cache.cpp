@@ -0,0 +1,197 @@
+/**
+ * @file program_cache.cpp
+ * @brief ProgramCache class implementation file.
+ * @version 1.0.0 (2026-10-17)
+ * @date 2026-10-17
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#include "program_cache.h"
+
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include "GL/glew.h"
+
+namespace bgq_opengl {
+
+	namespace {
+
+		/**
+		 * @brief Hashes some bytes into a running FNV-1a hash.
+		 *
+		 * @param data The bytes.
+		 * @param size The number of bytes.
+		 * @param hash The hash, updated.
+		 */
+		void hashBytes(const void *data, size_t size, uint64_t *hash) {
+
+			const unsigned char *bytes = (const unsigned char *) data;
+
+			for (size_t i = 0; i < size; i++) {
+
+				*hash ^= bytes[i];
+				*hash *= 1099511628211ull;
+
+			}
+
+		}
+
+		/**
+		 * @brief Hashes a string, with its size so two strings cannot run into each other.
+		 *
+		 * @param string The string.
+		 * @param hash The hash, updated.
+		 */
+		void hashString(const std::string &string, uint64_t *hash) {
+
+			uint64_t size = string.size();
+			hashBytes(&size, sizeof(size), hash);
+			hashBytes(string.data(), string.size(), hash);
+
+		}
+
+	}
+
+	uint64_t ProgramCache::getKey(const std::string &vertex_source, const std::string &fragment_source) {
+
+		uint64_t key = 14695981039346656037ull;
+
+		hashString(vertex_source, &key);
+		hashString(fragment_source, &key);
+
+		// Binaries only work on the driver that made them.
+		for (GLenum name : {GL_VENDOR, GL_RENDERER, GL_VERSION}) {
+
+			const GLubyte *value = glGetString(name);
+			hashString(value ? std::string((const char *) value) : std::string(), &key);
+
+		}
+
+		return key;
+
+	}
+
+	std::string ProgramCache::getPath(const char* vertex_filename, const char* fragment_filename, unsigned int features) {
+
+		return std::string(vertex_filename) + "." + std::filesystem::path(fragment_filename).filename().string() + "." + std::to_string(features) + ".bgqprog";
+
+	}
+
+	bool ProgramCache::isSupported() {
+
+		// Without OpenGL 4.1 or the extension, the entry points are not even there.
+		if (!GLEW_VERSION_4_1 && !GLEW_ARB_get_program_binary)
+			return false;
+
+		GLint format_count = 0;
+		glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &format_count);
+
+		return format_count > 0;
+
+	}
+
+	GLuint ProgramCache::read(const char* path, uint64_t key) {
+
+		if (!ProgramCache::isSupported())
+			return 0;
+
+		std::ifstream file(path, std::ios::binary);
+		if (!file)
+			return 0;
+
+		// It has to have a header of this version, for this program.
+		Header header;
+		if (!file.read((char *) &header, sizeof(Header)) || std::memcmp(header.magic, "BGQP", 4) != 0
+			|| header.version != ProgramCache::version || header.key != key || header.binary_size == 0
+			|| header.binary_size > INT32_MAX)
+			return 0;
+
+		std::vector<char> binary(header.binary_size);
+		if (!file.read(binary.data(), (std::streamsize) binary.size()))
+			return 0;
+
+		// The driver may refuse it anyway, for instance after an update.
+		GLuint program = glCreateProgram();
+		glProgramBinary(program, (GLenum) header.format, binary.data(), (GLsizei) binary.size());
+
+		GLint success = GL_FALSE;
+		glGetProgramiv(program, GL_LINK_STATUS, &success);
+
+		if (!success) {
+
+			glDeleteProgram(program);
+			return 0;
+
+		}
+
+		return program;
+
+	}
+
+	bool ProgramCache::write(const char* path, uint64_t key, GLuint program) {
+
+		if (!ProgramCache::isSupported())
+			return false;
+
+		GLint binary_size = 0;
+		glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &binary_size);
+		if (binary_size <= 0)
+			return false;
+
+		// Get the binary from the driver.
+		Header header;
+		std::memcpy(header.magic, "BGQP", 4);
+		header.version = ProgramCache::version;
+		header.key = key;
+		header.padding = 0;
+
+		std::vector<char> binary((size_t) binary_size);
+		GLsizei written_size = 0;
+		GLenum format = 0;
+		glGetProgramBinary(program, binary_size, &written_size, &format, binary.data());
+
+		if (written_size <= 0)
+			return false;
+
+		header.format = format;
+		header.binary_size = (uint64_t) written_size;
+
+		// Write everything to a temporary file first.
+		std::string temporary_path = std::string(path) + ".tmp";
+		std::ofstream file(temporary_path, std::ios::binary | std::ios::trunc);
+		if (!file)
+			return false;
+
+		file.write((const char *) &header, sizeof(Header));
+		file.write(binary.data(), written_size);
+		file.close();
+
+		// Replace the old cache only if everything was written.
+		std::error_code error;
+		if (!file) {
+
+			std::filesystem::remove(temporary_path, error);
+			return false;
+
+		}
+
+		std::filesystem::rename(temporary_path, path, error);
+
+		return !error;
+
+	}
+
+}  // namespace bgq_opengl
@@ -0,0 +1,132 @@
+/**
+ * @file program_cache.h
+ * @brief ProgramCache class header file.
+ * @version 1.0.0 (2026-10-17)
+ * @date 2026-10-17
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#ifndef BGQ_OPENGL_CLASSES_PROGRAM_CACHE_H_
+#define BGQ_OPENGL_CLASSES_PROGRAM_CACHE_H_
+
+#include <cstdint>
+#include <string>
+
+#include "GL/glew.h"
+
+namespace bgq_opengl {
+
+	/**
+	 * @brief Implements a binary cache of a linked shader program.
+	 *
+	 * Implements a file holding a linked program as the driver returns it from
+	 * glGetProgramBinary, so later runs can give it back with glProgramBinary
+	 * instead of compiling and linking the sources again.
+	 *
+	 * The file stores a key hashing the sources and the vendor, renderer and
+	 * version of the driver, so it is ignored as soon as any of them changes.
+	 * The driver may still refuse a binary, in which case the program has to be
+	 * built from the sources. Drivers with no binary formats never use it.
+	 *
+	 * @author Borja García Quiroga <garcaqub@tcd.ie>
+	 */
+	class ProgramCache {
+
+		public:
+
+			/**
+			 * @brief Get the key of a program.
+			 *
+			 * Hashes the sources of a program with the strings identifying the
+			 * driver. Needs a current context.
+			 *
+			 * @param vertex_source The source of the vertex shader.
+			 * @param fragment_source The source of the fragment shader.
+			 *
+			 * @returns The key.
+			 */
+			static uint64_t getKey(const std::string &vertex_source, const std::string &fragment_source);
+
+			/**
+			 * @brief Get the cache file of a program.
+			 *
+			 * Get the path of the cache file of a permutation of a program, next
+			 * to its vertex shader.
+			 *
+			 * @param vertex_filename The vertex shader file.
+			 * @param fragment_filename The fragment shader file.
+			 * @param features The feature mask of the permutation.
+			 *
+			 * @returns The cache file.
+			 */
+			static std::string getPath(const char* vertex_filename, const char* fragment_filename, unsigned int features);
+
+			/**
+			 * @brief Checks if the driver can save programs.
+			 *
+			 * Checks if the driver has program binaries, from OpenGL 4.1 or
+			 * ARB_get_program_binary, and any format to save them in.
+			 *
+			 * @returns True if it has.
+			 */
+			static bool isSupported();
+
+			/**
+			 * @brief Reads a program from its cache.
+			 *
+			 * Creates a program from its cache file, if the key matches and the
+			 * driver takes the binary.
+			 *
+			 * @param path The cache file.
+			 * @param key The key of the program.
+			 *
+			 * @returns The linked program, or 0 if there is no valid cache.
+			 */
+			static GLuint read(const char* path, uint64_t key);
+
+			/**
+			 * @brief Writes a cache file.
+			 *
+			 * Writes the binary of a linked program to its cache file. It is
+			 * written to a temporary file first so a failed write never leaves a
+			 * broken cache behind. The program has to be linked with
+			 * GL_PROGRAM_BINARY_RETRIEVABLE_HINT set.
+			 *
+			 * @param path The cache file.
+			 * @param key The key of the program.
+			 * @param program The linked program.
+			 *
+			 * @returns True if it was written.
+			 */
+			static bool write(const char* path, uint64_t key, GLuint program);
+
+		private:
+
+			/**
+			 * @brief Header of a cache file.
+			 */
+			struct Header {
+
+				char magic[4];				/// Always "BGQP".
+				uint32_t version;			/// Format version.
+				uint64_t key;				/// Key of the program.
+				uint32_t format;			/// Binary format given by the driver.
+				uint32_t padding;			/// Unused.
+				uint64_t binary_size;		/// Size of the binary after the header.
+
+			};
+
+			static const uint32_t version = 1;		/// Current format version.
+
+	};
+
+}  // namespace bgq_opengl
+
+#endif  //!BGQ_OPENGL_CLASSES_PROGRAM_CACHE_H_
@@ -0,0 +1,246 @@
+/**
+ * @file render_queue.cpp
+ * @brief RenderQueue class implementation file.
+ * @version 1.0.0 (2026-10-17)
+ * @date 2026-10-17
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#include "render_queue.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+#include "GL/glew.h"
+#include "glm/glm.hpp"
+
+#include "classes/camera/camera.h"
+#include "classes/geometry/geometry.h"
+#include "classes/ring_buffer/ring_buffer.h"
+#include "classes/shader/shader.h"
+#include "classes/texture/texture.h"
+#include "structs/bounding_box/bounding_box.h"
+#include "structs/draw_data/draw_data.h"
+
+namespace bgq_opengl {
+
+	namespace {
+
+		/**
+		 * @brief Gets the bits of a field, cut to its size.
+		 */
+		uint64_t field(uint64_t value, int bits) {
+
+			return value & ((uint64_t(1) << bits) - 1);
+
+		}
+
+	}  // namespace
+
+	void RenderQueue::clear() {
+
+		this->items.clear();
+
+	}
+
+	uint64_t RenderQueue::getState(uint64_t key) {
+
+		// The depth is at the bottom of opaque keys and right under the pass of
+		// transparent ones. The state is below or above it.
+		int state_bits = RenderQueue::program_bits + RenderQueue::texture_bits + RenderQueue::vao_bits;
+		uint64_t pass = key >> (64 - RenderQueue::pass_bits);
+		uint64_t state = pass == RenderQueue::transparent_pass ? key : key >> RenderQueue::depth_bits;
+
+		return (pass << state_bits) | field(state, state_bits);
+
+	}
+
+	uint64_t RenderQueue::makeKey(unsigned int pass, GLuint program, GLuint textures, GLuint vao, float depth) {
+
+		// Positive floats sort like their bits, so the top ones keep the order.
+		if (!(depth > 0.0f))
+			depth = 0.0f;
+
+		uint32_t depth_bits;
+		std::memcpy(&depth_bits, &depth, sizeof(float));
+		uint64_t depth_key = depth_bits >> (31 - RenderQueue::depth_bits);
+
+		uint64_t state = field(program, RenderQueue::program_bits);
+		state = (state << RenderQueue::texture_bits) | field(textures, RenderQueue::texture_bits);
+		state = (state << RenderQueue::vao_bits) | field(vao, RenderQueue::vao_bits);
+
+		uint64_t key = field(pass, RenderQueue::pass_bits);
+
+		// Blended draws must go back to front whatever their state.
+		if (pass == RenderQueue::transparent_pass) {
+
+			uint64_t far_first = field(~depth_key, RenderQueue::depth_bits);
+			key = (key << RenderQueue::depth_bits) | far_first;
+			key = (key << (RenderQueue::program_bits + RenderQueue::texture_bits + RenderQueue::vao_bits)) | state;
+
+		} else {
+
+			key = (key << (RenderQueue::program_bits + RenderQueue::texture_bits + RenderQueue::vao_bits)) | state;
+			key = (key << RenderQueue::depth_bits) | depth_key;
+
+		}
+
+		return key;
+
+	}
+
+	void RenderQueue::push(Geometry &geometry, Shader &shader, Camera &camera) {
+
+		// Get the program of the permutation it will draw with.
+		shader.setFeatures(geometry.getFeatures());
+		GLuint program = shader.getProgramID();
+
+		// Tell the texture sets apart by their IDs.
+		GLuint textures = 0;
+		for (const Texture &texture : geometry.getTextures())
+			textures = textures * 31 + texture.getID();
+
+		// Take the depth from the centre of the box.
+		BoundingBox box = geometry.getWorldBoundingBox();
+		float depth = glm::distance(camera.getPosition(), (box.min + box.max) * 0.5f);
+
+		unsigned int pass = geometry.isTransparent() ? RenderQueue::transparent_pass : RenderQueue::opaque_pass;
+		this->items.push_back(Item{RenderQueue::makeKey(pass, program, textures, geometry.getVAO().getID(), depth), &geometry});
+
+	}
+
+	size_t RenderQueue::size() const {
+
+		return this->items.size();
+
+	}
+
+	void RenderQueue::sort() {
+
+		// Count every byte of every key in one go.
+		size_t counts[8][256] = {};
+		for (const Item &item : this->items) {
+
+			for (int digit = 0; digit < 8; digit++)
+				counts[digit][(item.key >> (digit * 8)) & 0xFF]++;
+
+		}
+
+		this->scratch.resize(this->items.size());
+
+		for (int digit = 0; digit < 8; digit++) {
+
+			// If every key has the same byte, this pass would not move anything.
+			size_t shift = digit * 8;
+			if (this->items.empty() || counts[digit][(this->items[0].key >> shift) & 0xFF] == this->items.size())
+				continue;
+
+			// Turn the counts into the first position of each byte.
+			size_t offset = 0;
+			for (size_t &count : counts[digit]) {
+
+				size_t next = offset + count;
+				count = offset;
+				offset = next;
+
+			}
+
+			for (const Item &item : this->items)
+				this->scratch[counts[digit][(item.key >> shift) & 0xFF]++] = item;
+
+			std::swap(this->items, this->scratch);
+
+		}
+
+	}
+
+	void RenderQueue::submit(Shader &shader, Camera &camera) {
+
+		if (this->items.empty())
+			return;
+
+		// Split the draws in runs that go in one call each. Neighbours with the
+		// same state can share one if they can be batched, which instanced ones
+		// never can.
+		this->runs.clear();
+		for (size_t i = 0; i < this->items.size(); i++) {
+
+			if (this->runs.empty() || RenderQueue::getState(this->items[i - 1].key) != RenderQueue::getState(this->items[i].key)
+				|| !this->items[this->runs.back()].geometry->canBatchWith(*this->items[i].geometry))
+				this->runs.push_back(i);
+
+		}
+
+		// Write the draw data of every run one after the other in a single block.
+		// The geometries of a run share their transforms, so the first one
+		// writes it for all of them.
+		RingBuffer &draw_buffer = Geometry::getDrawBuffer();
+		GLsizeiptr stride = draw_buffer.getStride(sizeof(DrawData));
+		GLintptr first_offset;
+		char *records = (char *) draw_buffer.map(stride * (GLsizeiptr) this->runs.size(), &first_offset);
+
+		for (size_t run = 0; run < this->runs.size(); run++) {
+
+			DrawData data = this->items[this->runs[run]].geometry->getDrawData();
+			std::memcpy(records + run * stride, &data, sizeof(DrawData));
+
+		}
+
+		draw_buffer.unmap();
+
+		bool blending = false;
+
+		for (size_t run = 0; run < this->runs.size(); run++) {
+
+			size_t first = this->runs[run];
+			size_t last = run + 1 < this->runs.size() ? this->runs[run + 1] : this->items.size();
+			const Item &item = this->items[first];
+			GLintptr draw_offset = first_offset + (GLintptr) run * stride;
+
+			// The transparent draws come last, so blend from the first one on.
+			if (!blending && (item.key >> (64 - RenderQueue::pass_bits)) == RenderQueue::transparent_pass) {
+
+				glEnable(GL_BLEND);
+				glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+				glDepthMask(GL_FALSE);
+				blending = true;
+
+			}
+
+			// Draw every instance at once, or the whole run at once.
+			if (item.geometry->getInstanceCount() > 0) {
+
+				item.geometry->drawInstanced(shader, camera, draw_offset);
+				continue;
+
+			}
+
+			this->batch.clear();
+			for (size_t i = first; i < last; i++)
+				this->batch.push_back(this->items[i].geometry);
+
+			Geometry::drawBatch(this->batch, shader, camera, draw_offset);
+
+		}
+
+		// Leave the state as it was for whatever comes next.
+		if (blending) {
+
+			glDepthMask(GL_TRUE);
+			glDisable(GL_BLEND);
+
+		}
+
+	}
+
+}  // namespace bgq_opengl
@@ -0,0 +1,158 @@
+/**
+ * @file render_queue.h
+ * @brief RenderQueue class header file.
+ * @version 1.0.0 (2026-10-17)
+ * @date 2026-10-17
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#ifndef BGQ_OPENGL_CLASSES_RENDER_QUEUE_H_
+#define BGQ_OPENGL_CLASSES_RENDER_QUEUE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "GL/glew.h"
+
+#include "classes/camera/camera.h"
+#include "classes/geometry/geometry.h"
+#include "classes/shader/shader.h"
+
+namespace bgq_opengl {
+
+	/**
+	 * @brief Implements a queue of draws sorted by state.
+	 *
+	 * Implements a list of the draws of a frame, each one recorded as a 64 bit
+	 * key and the geometry to draw. The keys are radix sorted and the draws
+	 * submitted in that order, so the draws that share a program, textures and
+	 * VAO go one after the other and the state changes are the fewest.
+	 *
+	 * Opaque draws go first, grouped by state and then front to back so the
+	 * depth test rejects the most. Transparent draws go after them, back to
+	 * front so they blend over what is behind them.
+	 *
+	 * @author Borja García Quiroga <garcaqub@tcd.ie>
+	 */
+	class RenderQueue {
+
+		public:
+
+			/**
+			 * @brief Empties the queue.
+			 *
+			 * Removes every draw but keeps the memory for the next frame.
+			 */
+			void clear();
+
+			/**
+			 * @brief Packs the sort key of a draw.
+			 *
+			 * Packs the pass in the top bits. Opaque draws follow with the
+			 * program, textures, VAO and depth, transparent draws with the depth,
+			 * inverted, and then the rest. Every field is cut to its bits.
+			 *
+			 * @param pass RenderQueue::opaque_pass or RenderQueue::transparent_pass.
+			 * @param program The program.
+			 * @param textures A number that tells the texture sets apart.
+			 * @param vao The VAO.
+			 * @param depth The distance to the camera.
+			 *
+			 * @returns The key.
+			 */
+			static uint64_t makeKey(unsigned int pass, GLuint program, GLuint textures, GLuint vao, float depth);
+
+			/**
+			 * @brief Adds the draw of a geometry.
+			 *
+			 * Builds the key of the geometry as it would be drawn by the shader
+			 * from the camera and adds it.
+			 *
+			 * @param geometry The geometry. It must outlive the submit.
+			 * @param shader The shader that will draw it.
+			 * @param camera The camera.
+			 */
+			void push(Geometry &geometry, Shader &shader, Camera &camera);
+
+			/**
+			 * @brief Gets the number of draws.
+			 *
+			 * @returns The number of draws in the queue.
+			 */
+			size_t size() const;
+
+			/**
+			 * @brief Sorts the draws.
+			 *
+			 * Sorts the draws by key with a least significant digit radix sort,
+			 * one byte per pass. Passes where every key has the same byte are
+			 * skipped. Draws with the same key keep their order.
+			 */
+			void sort();
+
+			/**
+			 * @brief Draws everything in the queue.
+			 *
+			 * Splits the queue in runs of neighbouring draws with the same state
+			 * that can be batched, writes the draw data of every run to the draw
+			 * buffer at once and then draws them in the order of the queue. Each
+			 * run is a single call reading its own block, and geometries with
+			 * instances draw all of them in one call. The transparent ones are
+			 * blended without writing their depth.
+			 *
+			 * @param shader The shader to draw with.
+			 * @param camera The camera.
+			 */
+			void submit(Shader &shader, Camera &camera);
+
+			static const unsigned int opaque_pass = 0;		/// Pass of the opaque draws.
+			static const unsigned int transparent_pass = 1;	/// Pass of the blended draws.
+
+		private:
+
+			/**
+			 * @brief A draw in the queue.
+			 */
+			struct Item {
+
+				uint64_t key;			/// Sort key.
+				Geometry *geometry;		/// Geometry to draw.
+
+			};
+
+			/**
+			 * @brief Gets the state of a key.
+			 *
+			 * Gets the pass, program, textures and VAO of a key, without the
+			 * depth, so draws with the same state compare equal.
+			 *
+			 * @param key The key.
+			 *
+			 * @returns The state.
+			 */
+			static uint64_t getState(uint64_t key);
+
+			static const int pass_bits = 2;			/// Bits of the pass.
+			static const int program_bits = 12;		/// Bits of the program.
+			static const int texture_bits = 14;		/// Bits of the texture set.
+			static const int vao_bits = 12;			/// Bits of the VAO.
+			static const int depth_bits = 24;		/// Bits of the depth.
+
+			std::vector<Item> items;	/// Draws of the frame.
+			std::vector<Item> scratch;	/// Second buffer of the radix sort.
+			std::vector<size_t> runs;			/// First draw of each run submitted in one call.
+			std::vector<Geometry*> batch;		/// Geometries of the run being submitted.
+
+	};
+
+}  // namespace bgq_opengl
+
+#endif  //!BGQ_OPENGL_CLASSES_RENDER_QUEUE_H_
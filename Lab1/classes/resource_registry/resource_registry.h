@@ -0,0 +1,146 @@
+/**
+ * @file resource_registry.h
+ * @brief ResourceRegistry class header file.
+ * @version 1.0.0 (2026-10-17)
+ * @date 2026-10-17
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#ifndef BGQ_OPENGL_CLASSES_RESOURCE_REGISTRY_H_
+#define BGQ_OPENGL_CLASSES_RESOURCE_REGISTRY_H_
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+#include "structs/cache_stats/cache_stats.h"
+
+namespace bgq_opengl {
+
+	/**
+	 * @brief Implements a registry of shared resources.
+	 *
+	 * Implements a registry that hands out shared references to resources by
+	 * key, usually the path they were loaded from. Asking twice for the same key
+	 * returns the same resource while someone still holds it. The registry only
+	 * keeps weak references, so a resource is freed as soon as its last user
+	 * drops it. Requests that find the resource alive count as hits, the rest
+	 * as misses.
+	 *
+	 * @author Borja García Quiroga <garcaqub@tcd.ie>
+	 */
+	template <typename T>
+	class ResourceRegistry {
+
+		public:
+
+			/**
+			 * @brief Gets a resource, creating it if needed.
+			 *
+			 * Gets the resource stored under a key. If there is none, or it was
+			 * already freed, it is created by calling the given function.
+			 *
+			 * @param key The key of the resource.
+			 * @param create Function returning a new resource as a std::shared_ptr<T>.
+			 *
+			 * @returns A shared reference to the resource.
+			 */
+			template <typename Factory>
+			std::shared_ptr<T> acquire(const std::string &key, Factory create) {
+
+				// Reuse it if it is still alive.
+				std::weak_ptr<T> &entry = this->resources[key];
+				std::shared_ptr<T> resource = entry.lock();
+				if (resource) {
+
+					this->stats.hits++;
+					return resource;
+
+				}
+
+				// Create it and remember it.
+				resource = create();
+				entry = resource;
+				this->stats.misses++;
+
+				return resource;
+
+			}
+
+			/**
+			 * @brief Forgets the freed resources.
+			 *
+			 * Removes the entries of the resources nobody holds anymore.
+			 */
+			void collect() {
+
+				for (auto it = this->resources.begin(); it != this->resources.end();) {
+
+					if (it->second.expired())
+						it = this->resources.erase(it);
+					else
+						it++;
+
+				}
+
+			}
+
+			/**
+			 * @brief Get the counters.
+			 *
+			 * Get the number of hits and misses since the last reset.
+			 *
+			 * @returns The counters.
+			 */
+			CacheStats getStats() const {
+
+				return this->stats;
+
+			}
+
+			/**
+			 * @brief Resets the counters.
+			 *
+			 * Resets the hit and miss counters.
+			 */
+			void resetStats() {
+
+				this->stats = CacheStats();
+
+			}
+
+			/**
+			 * @brief Counts the live resources.
+			 *
+			 * Counts the resources that are still held by someone.
+			 *
+			 * @returns The number of live resources.
+			 */
+			size_t size() const {
+
+				size_t count = 0;
+				for (const auto &entry : this->resources)
+					if (!entry.second.expired())
+						count++;
+
+				return count;
+
+			}
+
+		private:
+
+			std::unordered_map<std::string, std::weak_ptr<T>> resources;	/// Resources by key.
+			CacheStats stats;												/// Hits and misses since the last reset.
+
+	};
+
+}  // namespace bgq_opengl
+
+#endif  //!BGQ_OPENGL_CLASSES_RESOURCE_REGISTRY_H_
@@ -0,0 +1,210 @@
+/**
+ * @file ring_buffer.cpp
+ * @brief RingBuffer class implementation file.
+ * @version 1.0.0 (2026-10-17)
+ * @date 2026-10-17
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#include "ring_buffer.h"
+
+#include "GL/glew.h"
+
+#include "classes/gl_state/gl_state.h"
+
+namespace bgq_opengl {
+
+	RingBuffer::RingBuffer(GLuint binding, GLsizeiptr region_size) {
+
+		this->binding = binding;
+		this->region_size = region_size;
+
+	}
+
+	RingBuffer::~RingBuffer() {
+
+		this->remove();
+
+	}
+
+	void RingBuffer::bindRange(GLintptr offset, GLsizeiptr size) {
+
+		GLState::bindUniformBufferRange(this->binding, this->ID, offset, size);
+
+	}
+
+	void RingBuffer::endFrame() {
+
+		if (this->head == 0)
+			return;
+
+		// The draws reading this region are already issued, so the fence follows them.
+		this->fences[this->region] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+		this->region = (this->region + 1) % RingBuffer::num_regions;
+		this->head = 0;
+
+	}
+
+	GLuint RingBuffer::getID() const {
+
+		return this->ID;
+
+	}
+
+	GLsizeiptr RingBuffer::getStride(GLsizeiptr size) {
+
+		// Ask for the alignment only once.
+		if (this->alignment == 0) {
+
+			glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &this->alignment);
+			if (this->alignment < 1)
+				this->alignment = 1;
+
+		}
+
+		return (size + this->alignment - 1) / this->alignment * this->alignment;
+
+	}
+
+	bool RingBuffer::isPersistent() const {
+
+		return this->persistent != nullptr;
+
+	}
+
+	void* RingBuffer::map(GLsizeiptr size, GLintptr *offset) {
+
+		if (this->ID == 0)
+			this->create(this->region_size);
+
+		GLsizeiptr start = this->getStride(this->head);
+
+		// The frame does not fit, so orphan the buffer for a larger one. The GPU
+		// keeps the old one for as long as the draws already issued read it.
+		if (start + size > this->region_size) {
+
+			GLsizeiptr region_size = this->region_size * 2;
+			while (region_size < size)
+				region_size *= 2;
+
+			this->create(region_size);
+			start = 0;
+
+		}
+
+		// The GPU may still be reading this region from some frames ago.
+		if (start == 0)
+			this->wait(this->region);
+
+		*offset = this->region * this->region_size + start;
+		this->head = start + size;
+
+		if (this->persistent)
+			return this->persistent + *offset;
+
+		// Nothing in flight uses this block, so the driver does not need to check.
+		glBindBuffer(GL_COPY_WRITE_BUFFER, this->ID);
+		void *block = glMapBufferRange(GL_COPY_WRITE_BUFFER, *offset, size, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+		glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+		this->mapped = true;
+
+		return block;
+
+	}
+
+	void RingBuffer::remove() {
+
+		if (this->ID == 0)
+			return;
+
+		for (int i = 0; i < RingBuffer::num_regions; i++) {
+
+			if (this->fences[i]) {
+
+				glDeleteSync(this->fences[i]);
+				this->fences[i] = 0;
+
+			}
+
+		}
+
+		// Deleting the buffer unmaps it, and OpenGL unbinds it from every binding point.
+		glDeleteBuffers(1, &this->ID);
+		GLState::forgetUniformBuffer(this->ID);
+
+		this->ID = 0;
+		this->persistent = nullptr;
+		this->mapped = false;
+		this->head = 0;
+		this->region = 0;
+
+	}
+
+	void RingBuffer::unmap() {
+
+		if (!this->mapped)
+			return;
+
+		glBindBuffer(GL_COPY_WRITE_BUFFER, this->ID);
+		glUnmapBuffer(GL_COPY_WRITE_BUFFER);
+		glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+		this->mapped = false;
+
+	}
+
+	void RingBuffer::create(GLsizeiptr region_size) {
+
+		this->unmap();
+		this->remove();
+		this->region_size = region_size;
+
+		// Use the copy target, which no VAO records.
+		GLsizeiptr size = region_size * RingBuffer::num_regions;
+		glGenBuffers(1, &this->ID);
+		glBindBuffer(GL_COPY_WRITE_BUFFER, this->ID);
+
+		if (GLEW_ARB_buffer_storage) {
+
+			// Coherent, so the writes are seen without flushing them.
+			GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+			glBufferStorage(GL_COPY_WRITE_BUFFER, size, nullptr, flags);
+			this->persistent = (char *) glMapBufferRange(GL_COPY_WRITE_BUFFER, 0, size, flags);
+
+		} else {
+
+			glBufferData(GL_COPY_WRITE_BUFFER, size, nullptr, GL_STREAM_DRAW);
+
+		}
+
+		glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+	}
+
+	void RingBuffer::wait(int region) {
+
+		if (!this->fences[region])
+			return;
+
+		// Flush the first time, so the fence is sure to be signalled at some point.
+		GLbitfield flags = GL_SYNC_FLUSH_COMMANDS_BIT;
+		GLenum result = GL_TIMEOUT_EXPIRED;
+		while (result == GL_TIMEOUT_EXPIRED) {
+
+			result = glClientWaitSync(this->fences[region], flags, RingBuffer::wait_timeout);
+			flags = 0;
+
+		}
+
+		glDeleteSync(this->fences[region]);
+		this->fences[region] = 0;
+
+	}
+
+}  // namespace bgq_opengl
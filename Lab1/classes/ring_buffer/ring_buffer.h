@@ -0,0 +1,172 @@
+/**
+ * @file ring_buffer.h
+ * @brief RingBuffer class header file.
+ * @version 1.0.0 (2026-10-17)
+ * @date 2026-10-17
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#ifndef BGQ_OPENGL_CLASSES_RING_BUFFER_H_
+#define BGQ_OPENGL_CLASSES_RING_BUFFER_H_
+
+#include "GL/glew.h"
+
+namespace bgq_opengl {
+
+	/**
+	 * @brief Implements a ring buffer for data written every frame.
+	 *
+	 * Implements a uniform buffer split in three regions, one per frame in
+	 * flight. Each frame writes its data one block after the other in the next
+	 * region, and a fence marks when the GPU is done with it so it is not
+	 * written again before that.
+	 *
+	 * With ARB_buffer_storage the buffer is mapped once, persistently. Without
+	 * it, as in OpenGL 4.1, each block is mapped unsynchronized, which the
+	 * fences make safe. When a frame does not fit, the buffer is orphaned for
+	 * one twice as large.
+	 *
+	 * @author Borja García Quiroga <garcaqub@tcd.ie>
+	 */
+	class RingBuffer {
+
+		public:
+
+			/**
+			 * @brief Constructs an empty ring buffer.
+			 *
+			 * Nothing is called in OpenGL, so it can be used before there is a
+			 * context. The buffer is created the first time it is mapped.
+			 *
+			 * @param binding Binding point the ranges are bound to.
+			 * @param region_size Initial size of each region in bytes.
+			 */
+			RingBuffer(GLuint binding, GLsizeiptr region_size = RingBuffer::initial_region_size);
+
+			/**
+			 * @brief Destroys the ring buffer.
+			 *
+			 * Deletes the OpenGL objects, if it still has them.
+			 */
+			~RingBuffer();
+
+			// Copies would delete the same OpenGL objects twice.
+			RingBuffer(const RingBuffer&) = delete;
+			RingBuffer& operator=(const RingBuffer&) = delete;
+
+			/**
+			 * @brief Binds a range to the binding point.
+			 *
+			 * @param offset The offset returned by map.
+			 * @param size The size of the range in bytes.
+			 */
+			void bindRange(GLintptr offset, GLsizeiptr size);
+
+			/**
+			 * @brief Ends the frame.
+			 *
+			 * Fences the region written this frame, after the draws reading it,
+			 * and moves on to the next one.
+			 */
+			void endFrame();
+
+			/**
+			 * @brief Get the ID.
+			 *
+			 * Get the OpenGL ID of the buffer.
+			 *
+			 * @returns The ID. 0 if it has no buffer.
+			 */
+			GLuint getID() const;
+
+			/**
+			 * @brief Gets the space a block takes.
+			 *
+			 * Rounds a size up to the alignment uniform buffer ranges need, so
+			 * blocks can be written one after the other.
+			 *
+			 * @param size The size in bytes.
+			 *
+			 * @returns The aligned size in bytes.
+			 */
+			GLsizeiptr getStride(GLsizeiptr size);
+
+			/**
+			 * @brief Checks if the buffer is persistently mapped.
+			 *
+			 * @returns True if it is.
+			 */
+			bool isPersistent() const;
+
+			/**
+			 * @brief Maps the next block of the frame.
+			 *
+			 * Reserves the next aligned block in the region of this frame, waiting
+			 * for the GPU to finish with the region the first time, and maps it.
+			 *
+			 * @param size The size of the block in bytes.
+			 * @param offset Outputs the offset of the block in the buffer.
+			 *
+			 * @returns The pointer to write the block to, until unmap.
+			 */
+			void* map(GLsizeiptr size, GLintptr *offset);
+
+			/**
+			 * @brief Removes the ring buffer.
+			 *
+			 * Removes the buffer and the fences from OpenGL.
+			 */
+			void remove();
+
+			/**
+			 * @brief Unmaps the block.
+			 *
+			 * Unmaps the block from map so it can be drawn with.
+			 */
+			void unmap();
+
+			static const int num_regions = 3;							/// Frames in flight.
+			static const GLsizeiptr initial_region_size = 64 * 1024;	/// Bytes of each region at first.
+			static const GLuint64 wait_timeout = 1000000000;			/// Nanoseconds of each wait for a fence.
+
+		private:
+
+			/**
+			 * @brief Creates the buffer.
+			 *
+			 * Creates the buffer for the regions, deleting the old one, and maps it
+			 * if it can be persistent.
+			 *
+			 * @param region_size Size of each region in bytes.
+			 */
+			void create(GLsizeiptr region_size);
+
+			/**
+			 * @brief Waits for the GPU to finish with a region.
+			 *
+			 * @param region The region.
+			 */
+			void wait(int region);
+
+			GLuint ID = 0;							/// OpenGL buffer ID.
+			GLuint binding;							/// Binding point of the ranges.
+			GLsizeiptr region_size;					/// Bytes of each region.
+			GLsizeiptr head = 0;					/// Bytes written in the current region.
+			GLint alignment = 0;					/// Alignment of uniform buffer ranges, 0 until asked.
+			int region = 0;							/// Region of the current frame.
+			GLsync fences[num_regions] = {};		/// Fence of the last frame that wrote each region.
+			char *persistent = nullptr;				/// Persistent mapping of the whole buffer, if any.
+			bool mapped = false;					/// Whether a block is mapped now.
+
+	};
+
+}  // namespace bgq_opengl
+
+#endif  //!BGQ_OPENGL_CLASSES_RING_BUFFER_H_
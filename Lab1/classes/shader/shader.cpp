@@ -15,6 +15,8 @@
 
 #include "shader.h"
 
+#include <chrono>
+#include <cstdint>
 #include <string>
 #include <fstream>
 #include <sstream>
@@ -25,24 +27,25 @@
 #include "glm/glm.hpp"
 #include "glm/gtc/type_ptr.hpp"
 
-#include "classes/camera/camera.h"
-#include "classes/light/light.h"
+#include "classes/gl_state/gl_state.h"
+#include "classes/program_cache/program_cache.h"
 #include "classes/texture/texture.h"
+#include "structs/draw_data/draw_data.h"
+#include "structs/frame_data/frame_data.h"
+#include "structs/material_data/material_data.h"
 
 namespace bgq_opengl {
 
+    bool Shader::srgb_framebuffer = false;
+
     Shader::Shader() {
     
         this->programID = NULL;
-
-        this->light = new Light(glm::vec3(0.0f, 0.0f, 0.0f), glm::vec4(0.0f, 0.0f, 0.0f, 0.0f));
     
     }
     
     Shader::Shader(const char* vertex_filename, const char* fragment_filename) {
 
-        this->light = new Light(glm::vec3(0.0f, 0.0f, 0.0f), glm::vec4(0.0f, 0.0f, 0.0f, 0.0f));
-
         // Init the strings to store the source code in.
         std::string vertex_source_code = "";
         std::string fragment_source_code = "";
@@ -69,75 +72,134 @@ namespace bgq_opengl {
 
         }
 
-        // Convert it to char.
-        const char* vertex_code_char = vertex_source_code.c_str();
-        const char* fragment_code_char = fragment_source_code.c_str();
+        // Keep the sources to build the other permutations when asked.
+        this->permutations = std::make_shared<Permutations>();
+        this->permutations->vertex_filename = vertex_filename;
+        this->permutations->fragment_filename = fragment_filename;
+        this->permutations->vertex_source = vertex_source_code;
+        this->permutations->fragment_source = fragment_source_code;
 
-        // Create and compile the vertex shader.
-        GLuint vertex = glCreateShader(GL_VERTEX_SHADER);
-        glShaderSource(vertex, 1, &vertex_code_char, NULL);
-        glCompileShader(vertex);
+        // Start with every feature on, so shaders nobody picks features for draw everything.
+        this->setFeatures(Shader::all_features);
 
-        // Check for errors.
-        std::string error_msg = "";
-        if (!Shader::checkShader(vertex, "VERTEX", &error_msg)) {
+        /*
+        // Validate the program.
+        glValidateProgram(this->programID);
+        error_msg = "";
+        if (!Shader::checkShader(this->programID, "VALIDATE", &error_msg)) {
 
-            std::cerr << "Vertex shader error - Could not compile the shader: " << error_msg << std::endl;
+            std::cerr << "Shader program error - Could not validate the program: " << error_msg << std::endl;
             exit(1);
 
         }
+         */
 
-        // Create and compile the fragment shader.
-        GLuint fragment = glCreateShader(GL_FRAGMENT_SHADER);
-        glShaderSource(fragment, 1, &fragment_code_char, NULL);
-        glCompileShader(fragment);
+    }
 
-        // Check for errors.
-        error_msg = "";
-        if (!Shader::checkShader(fragment, "FRAGMENT", &error_msg)) {
+    unsigned int Shader::getFeatures() const {
 
-            std::cerr << "Fragment shader error - Could not compile the shader: " << error_msg << std::endl;
-            exit(1);
+        return this->features;
 
-        }
+    }
 
-        // Create the program and add the vertex and fragment shaders.
-        this->programID = glCreateProgram();
-        glAttachShader(this->programID, vertex);
-        glAttachShader(this->programID, fragment);
+    unsigned int Shader::getProgramID() {
 
-        // Link this program and check for program errors.
-        glLinkProgram(this->programID);
-        error_msg = "";
-        if (!Shader::checkShader(this->programID, "PROGRAM", &error_msg)) {
+        return this->programID;
 
-            std::cerr << "Shader program error - Could not link the shaders: " << error_msg << std::endl;
-            exit(1);
+    }
+
+    GLint Shader::getUniformLocation(const std::string& name) const {
+
+        if (this->uniform_locations == nullptr)
+            return -1;
+
+        // Look for it in the table.
+        auto location = this->uniform_locations->find(name);
+
+        // Uniforms that are not active behave as in OpenGL, where -1 is ignored.
+        if (location == this->uniform_locations->end())
+            return -1;
+
+        return location->second;
+
+    }
+
+    bool Shader::getSRGBFramebuffer() {
+
+        return Shader::srgb_framebuffer;
+
+    }
+
+    size_t Shader::getVariantCount() const {
+
+        return this->permutations ? this->permutations->variants.size() : 0;
+
+    }
+
+    unsigned int Shader::selectFeatures(const MaterialData &material, bool textured) {
+
+        unsigned int features = 0;
+
+        if (textured)
+            features |= Shader::feature_texture;
+
+        if (!Shader::srgb_framebuffer)
+            features |= Shader::feature_gamma;
+
+        // Without mixing, the skybox is never seen.
+        if (material.mix_color == 0.0f)
+            return features;
+
+        features |= Shader::feature_environment;
+
+        // Without a fresnel power the ratio is always 1, so there is only reflection.
+        if (material.fresnel_power == 0.0f)
+            return features;
+
+        features |= Shader::feature_refraction;
+
+        // One refraction does for all the channels if they have the same ratio.
+        if (material.eta_r != material.eta_g || material.eta_b != material.eta_g)
+            features |= Shader::feature_dispersion;
+
+        return features;
+
+    }
+
+    void Shader::setFeatures(unsigned int features) {
+
+        if (this->permutations == nullptr || (features == this->features && this->uniform_locations != nullptr))
+            return;
+
+        // Build it the first time it is asked for.
+        auto variant = this->permutations->variants.find(features);
+        if (variant == this->permutations->variants.end()) {
+
+            this->buildVariant(features);
+
+        } else {
+
+            this->programID = variant->second.program_id;
+            this->uniform_locations = &variant->second.uniform_locations;
 
         }
 
-        // Clean the shaders.
-        // They are in the compiled program now, so clean them.
-        glDeleteShader(vertex);
-        glDeleteShader(fragment);
+        this->features = features;
 
-        /*
-        // Validate the program.
-        glValidateProgram(this->programID);
-        error_msg = "";
-        if (!Shader::checkShader(this->programID, "VALIDATE", &error_msg)) {
+        // Samplers belong to each program, so pass this one the slots already passed.
+        if (!this->permutations->samplers.empty()) {
 
-            std::cerr << "Shader program error - Could not validate the program: " << error_msg << std::endl;
-            exit(1);
+            this->activate();
+            for (const auto &sampler : this->permutations->samplers)
+                this->passInt(this->getUniform<int>(sampler.first), sampler.second);
 
         }
-         */
 
     }
 
-    unsigned int Shader::getProgramID() {
+    void Shader::setSRGBFramebuffer(bool srgb) {
 
-        return this->programID;
+        Shader::srgb_framebuffer = srgb;
 
     }
 
@@ -146,45 +208,32 @@ namespace bgq_opengl {
         if (this->programID == -1)
             throw std::runtime_error("Shader was not initialized.");
 
-        glUseProgram(this->programID);
+        // Skip it if it is already in use.
+        GLState::useProgram(this->programID);
 
     }
 
     void Shader::passBool(const std::string& name, bool value) {
 
-        glUniform1i(glGetUniformLocation(this->programID, name.c_str()), (int)value);
+        this->passBool(this->getUniform<bool>(name), value);
 
     }
 
-    void Shader::passCamera(Camera camera) {
-
-        // Pass the View matrix to the shader.
-        glm::mat4 view_matrix = camera.getView();
-        GLint location = glGetUniformLocation(this->programID, "View");
-        glUniformMatrix4fv(location, 1, GL_FALSE, glm::value_ptr(view_matrix));
-
-        // Pass the Projection matrix to the shader.
-        glm::mat4 projection_matrix = camera.getProjection();
-        location = glGetUniformLocation(this->programID, "Projection");
-        glUniformMatrix4fv(location, 1, GL_FALSE, glm::value_ptr(projection_matrix));
+    void Shader::passBool(Uniform<bool> uniform, bool value) {
 
-        // Get the camera info and pass it to the shader.
-        glm::vec4 color = (*this->light).getColor();
-        glm::vec3 position = (*this->light).getPosition();
+        // Booleans are sent as ints.
+        int int_value = (int) value;
 
-        // Transform the camera position to view.
-        position = glm::vec3(view_matrix * glm::vec4(position, 1.0f));
-
-        // Pass it to the shader.
-        glUniform4f(glGetUniformLocation(this->programID, "lightColor"), color.x, color.y, color.z, color.w);
-        glUniform3f(glGetUniformLocation(this->programID, "lightPos"), position.x, position.y, position.z);
+        // Skip it if the program already has this value.
+        if (GLState::uniformChanged(this->programID, uniform.location, &int_value, sizeof(int_value)))
+            glUniform1i(uniform.location, int_value);
 
     }
 
-    void Shader::passCubemap(Cubemap cubemap) {
+    void Shader::passCubemap(const Cubemap &cubemap) {
         
         // Gets the location of the uniform.
-        GLuint location = glGetUniformLocation(this->programID, cubemap.getName().c_str());
+        Uniform<int> uniform = this->getUniform<int>(cubemap.getName());
 
         // Activate the shader.
         this->activate();
@@ -193,36 +242,47 @@ namespace bgq_opengl {
         int slot = cubemap.getSlot();
         
         // Activate this texture.
-        glActiveTexture(GL_TEXTURE0 + slot);
+        GLState::activeTexture(slot);
 
-        // Sets the value of the texture uniform.
-        glUniform1i(location, slot);
+        // Sets the value of the texture uniform, and of the other permutations when selected.
+        this->passInt(uniform, slot);
+        if (this->permutations)
+            this->permutations->samplers[cubemap.getName()] = slot;
         
     }
 
-    void Shader::passLight(Light lightParam) {
+    void Shader::passInt(const std::string& name, int value) {
 
-        // Store the light.
-        this->light = new Light(lightParam.getPosition(), lightParam.getColor());
+        this->passInt(this->getUniform<int>(name), value);
 
     }
 
-    void Shader::passInt(const std::string& name, int value) {
+    void Shader::passInt(Uniform<int> uniform, int value) {
 
-        glUniform1i(glGetUniformLocation(this->programID, name.c_str()), value);
+        // Skip it if the program already has this value.
+        if (GLState::uniformChanged(this->programID, uniform.location, &value, sizeof(value)))
+            glUniform1i(uniform.location, value);
 
     }
 
     void Shader::passFloat(const std::string& name, float value) {
 
-        glUniform1f(glGetUniformLocation(this->programID, name.c_str()), value);
+        this->passFloat(this->getUniform<float>(name), value);
 
     }
 
-    void Shader::passTexture(Texture texture) {
+    void Shader::passFloat(Uniform<float> uniform, float value) {
+
+        // Skip it if the program already has this value.
+        if (GLState::uniformChanged(this->programID, uniform.location, &value, sizeof(value)))
+            glUniform1f(uniform.location, value);
+
+    }
+
+    void Shader::passTexture(const Texture &texture) {
 
         // Gets the location of the uniform.
-        GLuint location = glGetUniformLocation(this->programID, texture.getName().c_str());
+        Uniform<int> uniform = this->getUniform<int>(texture.getName());
 
         // Activate the shader.
         this->activate();
@@ -231,73 +291,241 @@ namespace bgq_opengl {
         int slot = texture.getSlot();
         
         // Activate this texture.
-        glActiveTexture(GL_TEXTURE0 + slot);
+        GLState::activeTexture(slot);
 
-        // Sets the value of the texture uniform.
-        glUniform1i(location, slot);
+        // Sets the value of the texture uniform, and of the other permutations when selected.
+        this->passInt(uniform, slot);
+        if (this->permutations)
+            this->permutations->samplers[texture.getName()] = slot;
 
     }
 
     void Shader::passVec(const std::string& name, glm::vec2 value) {
         
-        // Gets the location of the uniform.
-        GLuint location = glGetUniformLocation(this->programID, name.c_str());
+        this->passVec(this->getUniform<glm::vec2>(name), value);
+
+    }
+
+    void Shader::passVec(Uniform<glm::vec2> uniform, glm::vec2 value) {
 
-        // Sets the value of the texture uniform.
-        glUniform2f(location, value.x, value.y);
+        // Skip it if the program already has this value.
+        if (GLState::uniformChanged(this->programID, uniform.location, &value, sizeof(value)))
+            glUniform2f(uniform.location, value.x, value.y);
 
     }
 
     void Shader::passVec(const std::string& name, glm::vec3 value) {
         
-        // Gets the location of the uniform.
-        GLuint location = glGetUniformLocation(this->programID, name.c_str());
+        this->passVec(this->getUniform<glm::vec3>(name), value);
 
-        // Sets the value of the texture uniform.
-        glUniform3f(location, value.x, value.y, value.z);
+    }
+
+    void Shader::passVec(Uniform<glm::vec3> uniform, glm::vec3 value) {
+
+        // Skip it if the program already has this value.
+        if (GLState::uniformChanged(this->programID, uniform.location, &value, sizeof(value)))
+            glUniform3f(uniform.location, value.x, value.y, value.z);
 
     }
 
     void Shader::passVec(const std::string& name, glm::vec4 value) {
         
-        // Gets the location of the uniform.
-        GLuint location = glGetUniformLocation(this->programID, name.c_str());
+        this->passVec(this->getUniform<glm::vec4>(name), value);
+
+    }
 
-        // Sets the value of the texture uniform.
-        glUniform4f(location, value.x, value.y, value.z, value.w);
+    void Shader::passVec(Uniform<glm::vec4> uniform, glm::vec4 value) {
+
+        // Skip it if the program already has this value.
+        if (GLState::uniformChanged(this->programID, uniform.location, &value, sizeof(value)))
+            glUniform4f(uniform.location, value.x, value.y, value.z, value.w);
 
     }
 
     void Shader::passMat(const std::string& name, glm::mat2 value) {
 
-        // Gets the location of the uniform.
-        GLuint location = glGetUniformLocation(this->programID, name.c_str());
+        this->passMat(this->getUniform<glm::mat2>(name), value);
+
+    }
 
-        glUniformMatrix2fv(location, 1, GL_FALSE, glm::value_ptr(value));
+    void Shader::passMat(Uniform<glm::mat2> uniform, glm::mat2 value) {
+
+        // Skip it if the program already has this value.
+        if (GLState::uniformChanged(this->programID, uniform.location, &value, sizeof(value)))
+            glUniformMatrix2fv(uniform.location, 1, GL_FALSE, glm::value_ptr(value));
 
     }
 
     void Shader::passMat(const std::string& name, glm::mat3 value) {
 
-        // Gets the location of the uniform.
-        GLuint location = glGetUniformLocation(this->programID, name.c_str());
+        this->passMat(this->getUniform<glm::mat3>(name), value);
 
-        glUniformMatrix3fv(location, 1, GL_FALSE, glm::value_ptr(value));
+    }
+
+    void Shader::passMat(Uniform<glm::mat3> uniform, glm::mat3 value) {
+
+        // Skip it if the program already has this value.
+        if (GLState::uniformChanged(this->programID, uniform.location, &value, sizeof(value)))
+            glUniformMatrix3fv(uniform.location, 1, GL_FALSE, glm::value_ptr(value));
 
     }
 
     void Shader::passMat(const std::string& name, glm::mat4 value) {
 
-        // Gets the location of the uniform.
-        GLuint location = glGetUniformLocation(this->programID, name.c_str());
+        this->passMat(this->getUniform<glm::mat4>(name), value);
+
+    }
+
+    void Shader::passMat(Uniform<glm::mat4> uniform, glm::mat4 value) {
 
-        glUniformMatrix4fv(location, 1, GL_FALSE, glm::value_ptr(value));
+        // Skip it if the program already has this value.
+        if (GLState::uniformChanged(this->programID, uniform.location, &value, sizeof(value)))
+            glUniformMatrix4fv(uniform.location, 1, GL_FALSE, glm::value_ptr(value));
 
     }
 
     void Shader::remove() {
 
-        glDeleteProgram(this->programID);
+        // Without sources there is only the one program.
+        if (this->permutations == nullptr) {
+
+            glDeleteProgram(this->programID);
+            GLState::forgetProgram(this->programID);
+            return;
+
+        }
+
+        for (const auto &variant : this->permutations->variants) {
+
+            glDeleteProgram(variant.second.program_id);
+            GLState::forgetProgram(variant.second.program_id);
+
+        }
+
+        this->permutations->variants.clear();
+        this->uniform_locations = nullptr;
+
+    }
+
+    std::string Shader::addDefines(const std::string& source, unsigned int features) {
+
+        std::string defines;
+        if (features & Shader::feature_environment)
+            defines += "#define USE_ENVIRONMENT\n";
+        if (features & Shader::feature_refraction)
+            defines += "#define USE_REFRACTION\n";
+        if (features & Shader::feature_dispersion)
+            defines += "#define USE_DISPERSION\n";
+        if (features & Shader::feature_texture)
+            defines += "#define USE_TEXTURE\n";
+        if (features & Shader::feature_gamma)
+            defines += "#define USE_GAMMA\n";
+
+        // The #version has to come first, so they go right after it.
+        size_t version = source.find("#version");
+        if (version == std::string::npos)
+            return defines + source;
+
+        size_t line_end = source.find('\n', version);
+        if (line_end == std::string::npos)
+            return source + "\n" + defines;
+
+        return source.substr(0, line_end + 1) + defines + source.substr(line_end + 1);
+
+    }
+
+    Shader::Variant& Shader::buildVariant(unsigned int features) {
+
+        auto start = std::chrono::steady_clock::now();
+
+        // Take the linked program from the cache if it is there.
+        const Permutations &permutations = *this->permutations;
+        std::string cache_path = ProgramCache::getPath(permutations.vertex_filename.c_str(), permutations.fragment_filename.c_str(), features);
+        bool from_cache = this->buildProgram(Shader::addDefines(permutations.vertex_source, features),
+            Shader::addDefines(permutations.fragment_source, features), cache_path);
+
+        Variant &variant = this->permutations->variants[features];
+        variant.program_id = this->programID;
+        this->uniform_locations = &variant.uniform_locations;
+
+        // Store the uniform locations now so the driver is never asked again.
+        this->loadUniforms();
+
+        std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+        std::cerr << "  " << permutations.vertex_filename << " + " << permutations.fragment_filename << " (features " << features << ")"
+            << (from_cache ? " loaded from the program cache in " : " compiled in ") << elapsed.count() << " ms" << std::endl;
+
+        return variant;
+
+    }
+
+    bool Shader::buildProgram(const std::string& vertex_source, const std::string& fragment_source, const std::string& cache_path) {
+
+        // A binary of the same sources on the same driver can be used as is.
+        uint64_t key = ProgramCache::getKey(vertex_source, fragment_source);
+        this->programID = ProgramCache::read(cache_path.c_str(), key);
+        if (this->programID != 0)
+            return true;
+
+        // Convert it to char.
+        const char* vertex_code_char = vertex_source.c_str();
+        const char* fragment_code_char = fragment_source.c_str();
+
+        // Create and compile both shaders. Their status is not asked for until
+        // the program is linked, so the driver never has to stop in between.
+        GLuint vertex = glCreateShader(GL_VERTEX_SHADER);
+        glShaderSource(vertex, 1, &vertex_code_char, NULL);
+        glCompileShader(vertex);
+
+        GLuint fragment = glCreateShader(GL_FRAGMENT_SHADER);
+        glShaderSource(fragment, 1, &fragment_code_char, NULL);
+        glCompileShader(fragment);
+
+        // Create the program and add the vertex and fragment shaders.
+        this->programID = glCreateProgram();
+        glAttachShader(this->programID, vertex);
+        glAttachShader(this->programID, fragment);
+
+        // Ask for a binary that can be saved, if the driver can, then link it.
+        bool cacheable = ProgramCache::isSupported();
+        if (cacheable)
+            glProgramParameteri(this->programID, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+        glLinkProgram(this->programID);
+
+        // Check for errors, blaming the shader that failed if any did.
+        std::string link_msg = "";
+        if (!Shader::checkShader(this->programID, "PROGRAM", &link_msg)) {
+
+            std::string error_msg = "";
+            if (!Shader::checkShader(vertex, "VERTEX", &error_msg)) {
+
+                std::cerr << "Vertex shader error - Could not compile the shader: " << error_msg << std::endl;
+                exit(1);
+
+            }
+
+            if (!Shader::checkShader(fragment, "FRAGMENT", &error_msg)) {
+
+                std::cerr << "Fragment shader error - Could not compile the shader: " << error_msg << std::endl;
+                exit(1);
+
+            }
+
+            std::cerr << "Shader program error - Could not link the shaders: " << link_msg << std::endl;
+            exit(1);
+
+        }
+
+        // Clean the shaders.
+        // They are in the compiled program now, so clean them.
+        glDeleteShader(vertex);
+        glDeleteShader(fragment);
+
+        // Save it for the next run. It is fine if it fails.
+        if (cacheable && !ProgramCache::write(cache_path.c_str(), key, this->programID))
+            std::cerr << "  Could not write the program cache " << cache_path << std::endl;
+
+        return false;
 
     }
 
@@ -337,6 +565,70 @@ namespace bgq_opengl {
 
     }
 
+    void Shader::bindUniformBlock(const std::string& name, GLuint binding) {
+
+        // Blocks that are not used are not active.
+        GLuint index = glGetUniformBlockIndex(this->programID, name.c_str());
+        if (index == GL_INVALID_INDEX)
+            return;
+
+        glUniformBlockBinding(this->programID, index, binding);
+
+    }
+
+    void Shader::loadUniforms() {
+
+        this->uniform_locations->clear();
+
+        // Get how many uniforms are active and the longest name.
+        GLint num_uniforms = 0;
+        GLint max_name_length = 0;
+        glGetProgramiv(this->programID, GL_ACTIVE_UNIFORMS, &num_uniforms);
+        glGetProgramiv(this->programID, GL_ACTIVE_UNIFORM_MAX_LENGTH, &max_name_length);
+
+        std::string name_buffer(max_name_length > 0 ? max_name_length : 1, '\0');
+
+        for (GLint i = 0; i < num_uniforms; i++) {
+
+            // Get the name and size of this uniform.
+            GLsizei name_length = 0;
+            GLint size = 0;
+            GLenum type = 0;
+            glGetActiveUniform(this->programID, (GLuint) i, (GLsizei) name_buffer.size(), &name_length, &size, &type, &name_buffer[0]);
+            std::string name(name_buffer.c_str(), name_length);
+
+            // Uniforms inside blocks have no location.
+            GLint location = glGetUniformLocation(this->programID, name.c_str());
+            if (location < 0)
+                continue;
+
+            (*this->uniform_locations)[name] = location;
+
+            // Arrays are reported as "name[0]". Store the bare name and every element too.
+            size_t bracket = name.find('[');
+            if (bracket != std::string::npos) {
+
+                std::string base_name = name.substr(0, bracket);
+                (*this->uniform_locations)[base_name] = location;
+
+                for (GLint element = 1; element < size; element++) {
+
+                    std::string element_name = base_name + "[" + std::to_string(element) + "]";
+                    (*this->uniform_locations)[element_name] = glGetUniformLocation(this->programID, element_name.c_str());
+
+                }
+
+            }
+
+        }
+
+        // Point the shared blocks to their buffers.
+        this->bindUniformBlock("Frame", FrameData::binding);
+        this->bindUniformBlock("Material", MaterialData::binding);
+        this->bindUniformBlock("Draw", DrawData::binding);
+
+    }
+
     void Shader::readFileContents(const char* filename, std::string *file_contents) {
 
         try {
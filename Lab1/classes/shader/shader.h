@@ -16,14 +16,17 @@
 #ifndef BGQ_OPENGL_SHADER_H_
 #define BGQ_OPENGL_SHADER_H_
 
+#include <memory>
 #include <string>
+#include <unordered_map>
 
+#include "GL/glew.h"
 #include "glm/glm.hpp"
 
-#include "classes/camera/camera.h"
 #include "classes/cubemap/cubemap.h"
-#include "classes/light/light.h"
 #include "classes/texture/texture.h"
+#include "structs/material_data/material_data.h"
+#include "structs/uniform/uniform.h"
 
 namespace bgq_opengl {
     
@@ -33,6 +36,11 @@ namespace bgq_opengl {
      * Implementation of a Shader class to handle loading, activation and
      * errors in vertex and fragment shaders.
      *
+     * The sources can be built in several permutations, each one with a set of
+     * features turned on through #defines. A permutation is compiled the first
+     * time it is asked for and kept by its feature mask. Copies of a shader
+     * share their permutations, but each one has its own selected.
+     *
      * @author Borja García Quiroga <garcaqub@tcd.ie>
      */
 	class Shader {
@@ -49,13 +57,23 @@ namespace bgq_opengl {
         /**
          * @brief Construct the shader instance.
          *
-         * Construct the shader instance by passing the shaders' files.
+         * Construct the shader instance by passing the shaders' files. The
+         * permutation with every feature is built and selected.
          *
          * @param vertex_filename Vertex shader filename.
          * @param fragment_filename Fragment shader filename.
          */
         Shader(const char* vertex_filename, const char* fragment_filename);
 
+        /**
+         * @brief Get the selected features.
+         *
+         * Get the feature mask of the selected permutation.
+         *
+         * @returns The features.
+         */
+        unsigned int getFeatures() const;
+
         /**
          *@brief Returns the program ID.
          *
@@ -65,6 +83,94 @@ namespace bgq_opengl {
          */
         unsigned int getProgramID();
 
+        /**
+         * @brief Get the location of a uniform.
+         *
+         * Get the location of a uniform from the table built after linking. The
+         * driver is not queried.
+         *
+         * @param name The name of the uniform within the shaders.
+         *
+         * @returns The location, or -1 if the uniform is not active.
+         */
+        GLint getUniformLocation(const std::string& name) const;
+
+        /**
+         * @brief Get a typed handle to a uniform.
+         *
+         * Get a typed handle to a uniform that can be stored and passed to the
+         * pass methods, so no name has to be looked up while drawing.
+         *
+         * @param name The name of the uniform within the shaders.
+         *
+         * @returns The handle. Its location is -1 if the uniform is not active.
+         */
+        template <typename T>
+        Uniform<T> getUniform(const std::string& name) const {
+
+            Uniform<T> uniform;
+            uniform.location = this->getUniformLocation(name);
+
+            return uniform;
+
+        }
+
+        /**
+         * @brief Checks if the framebuffer encodes to sRGB.
+         *
+         * Checks if the framebuffer encodes to sRGB, so the shaders leave the
+         * gamma correction to it.
+         *
+         * @returns True if it does.
+         */
+        static bool getSRGBFramebuffer();
+
+        /**
+         * @brief Gets the number of permutations built.
+         *
+         * Gets the number of permutations built so far.
+         *
+         * @returns The number of permutations.
+         */
+        size_t getVariantCount() const;
+
+        /**
+         * @brief Picks the cheapest features for a material.
+         *
+         * Picks the features a material needs, leaving out every effect its
+         * parameters make invisible. Without mix_color the skybox is never
+         * seen, and without fresnel_power the fresnel ratio is always 1, so
+         * only the reflection shows.
+         *
+         * @param material The material.
+         * @param textured Whether the geometry has a texture.
+         *
+         * @returns The features.
+         */
+        static unsigned int selectFeatures(const MaterialData &material, bool textured);
+
+        /**
+         * @brief Selects a permutation.
+         *
+         * Selects the permutation with some features, building it if it is the
+         * first time. The samplers already passed are passed to it too.
+         *
+         * @param features The feature mask.
+         */
+        void setFeatures(unsigned int features);
+
+        /**
+         * @brief Tells the shaders whether the framebuffer encodes to sRGB.
+         *
+         * Tells the shaders whether GL_FRAMEBUFFER_SRGB is enabled, so the
+         * permutations picked from then on leave the gamma correction to it.
+         * Textures and cubemaps uploaded from then on are stored as sRGB, so
+         * they are read linear.
+         *
+         * @param srgb Whether it encodes to sRGB.
+         */
+        static void setSRGBFramebuffer(bool srgb);
+
         /**
          * @brief Activate this shader program.
          * 
@@ -83,14 +189,15 @@ namespace bgq_opengl {
         void passBool(const std::string& name, bool value);
 
         /**
-         * @brief Pass the camera matrix and camera position to the shader.
+         * @brief Pass a bool to the shaders.
          *
-         * Pass the camera matrix and camera position to the shader.
+         * Pass a bool to the shader program through a uniform handle.
          *
-         * @param camera The camera.
+         * @param uniform The handle of the uniform.
+         * @param value The value to be passed to the program.
          */
-        void passCamera(Camera camera);
-        
+        void passBool(Uniform<bool> uniform, bool value);
+
         /**
          * @brief Pass a cubemap to the shader.
          *
@@ -98,16 +205,7 @@ namespace bgq_opengl {
          *
          * @param cubemap The cubemap that will be passed.
          */
-        void passCubemap(Cubemap cubemap);
-
-        /**
-         * @brief Pass a light to the shader.
-         * 
-         * Pass a light to the shader.
-         * 
-         * @param light the light that will be passed to tha shader.
-         */
-        void passLight(Light light);
+        void passCubemap(const Cubemap &cubemap);
 
         /**
          * @brief Pass a given integer to the shaders.
@@ -119,6 +217,16 @@ namespace bgq_opengl {
          */
         void passInt(const std::string& name, int value);
 
+        /**
+         * @brief Pass a integer to the shaders.
+         *
+         * Pass a integer to the shader program through a uniform handle.
+         *
+         * @param uniform The handle of the uniform.
+         * @param value The value to be passed to the program.
+         */
+        void passInt(Uniform<int> uniform, int value);
+
         /**
          * @brief Pass a given float to the shaders.
          *
@@ -129,6 +237,16 @@ namespace bgq_opengl {
          */
         void passFloat(const std::string& name, float value);
 
+        /**
+         * @brief Pass a float to the shaders.
+         *
+         * Pass a float to the shader program through a uniform handle.
+         *
+         * @param uniform The handle of the uniform.
+         * @param value The value to be passed to the program.
+         */
+        void passFloat(Uniform<float> uniform, float value);
+
         /**
          * @brief Pass a texture to the shader.
          * 
@@ -136,7 +254,7 @@ namespace bgq_opengl {
          * 
          * @param texture The texture itself.
          */
-        void passTexture(Texture texture);
+        void passTexture(const Texture &texture);
         
         /**
          * @brief Pass a vector of size 2 to the shader.
@@ -148,6 +266,16 @@ namespace bgq_opengl {
          */
         void passVec(const std::string& name, glm::vec2 value);
 
+        /**
+         * @brief Pass a vector of size 2 to the shaders.
+         *
+         * Pass a vector of size 2 to the shader program through a uniform handle.
+         *
+         * @param uniform The handle of the uniform.
+         * @param value The value to be passed to the program.
+         */
+        void passVec(Uniform<glm::vec2> uniform, glm::vec2 value);
+
         /**
          * @brief Pass a vector of size 3 to the shader.
          *
@@ -158,6 +286,16 @@ namespace bgq_opengl {
          */
         void passVec(const std::string& name, glm::vec3 value);
 
+        /**
+         * @brief Pass a vector of size 3 to the shaders.
+         *
+         * Pass a vector of size 3 to the shader program through a uniform handle.
+         *
+         * @param uniform The handle of the uniform.
+         * @param value The value to be passed to the program.
+         */
+        void passVec(Uniform<glm::vec3> uniform, glm::vec3 value);
+
         /**
          * @brief Pass a vector of size 4 to the shader.
          *
@@ -168,6 +306,16 @@ namespace bgq_opengl {
          */
         void passVec(const std::string& name, glm::vec4 value);
 
+        /**
+         * @brief Pass a vector of size 4 to the shaders.
+         *
+         * Pass a vector of size 4 to the shader program through a uniform handle.
+         *
+         * @param uniform The handle of the uniform.
+         * @param value The value to be passed to the program.
+         */
+        void passVec(Uniform<glm::vec4> uniform, glm::vec4 value);
+
         /**
          * @brief Pass a matrix of size 2 to the shader.
          *
@@ -178,6 +326,16 @@ namespace bgq_opengl {
          */
         void passMat(const std::string& name, glm::mat2 value);
 
+        /**
+         * @brief Pass a matrix of size 2 to the shaders.
+         *
+         * Pass a matrix of size 2 to the shader program through a uniform handle.
+         *
+         * @param uniform The handle of the uniform.
+         * @param value The value to be passed to the program.
+         */
+        void passMat(Uniform<glm::mat2> uniform, glm::mat2 value);
+
         /**
          * @brief Pass a matrix of size 3 to the shader.
          *
@@ -188,6 +346,16 @@ namespace bgq_opengl {
          */
         void passMat(const std::string& name, glm::mat3 value);
 
+        /**
+         * @brief Pass a matrix of size 3 to the shaders.
+         *
+         * Pass a matrix of size 3 to the shader program through a uniform handle.
+         *
+         * @param uniform The handle of the uniform.
+         * @param value The value to be passed to the program.
+         */
+        void passMat(Uniform<glm::mat3> uniform, glm::mat3 value);
+
         /**
          * @brief Pass a matrix of size 4 to the shader.
          *
@@ -198,6 +366,16 @@ namespace bgq_opengl {
          */
         void passMat(const std::string& name, glm::mat4 value);
 
+        /**
+         * @brief Pass a matrix of size 4 to the shaders.
+         *
+         * Pass a matrix of size 4 to the shader program through a uniform handle.
+         *
+         * @param uniform The handle of the uniform.
+         * @param value The value to be passed to the program.
+         */
+        void passMat(Uniform<glm::mat4> uniform, glm::mat4 value);
+
         /**
          * @brief Remove the shader from OpenGL.
          * 
@@ -205,8 +383,65 @@ namespace bgq_opengl {
          */
         void remove();
 
+        static const unsigned int feature_environment = 1 << 0;    /// Mixes the skybox reflection into the color.
+        static const unsigned int feature_refraction = 1 << 1;     /// Mixes the refraction in by the fresnel ratio.
+        static const unsigned int feature_dispersion = 1 << 2;     /// Refracts each channel with its own ratio.
+        static const unsigned int feature_texture = 1 << 3;        /// Samples the color texture.
+        static const unsigned int feature_gamma = 1 << 4;          /// Applies the gamma correction in the shader.
+        static const unsigned int all_features = (1 << 5) - 1;     /// Every feature.
+
     private:
 
+        /**
+         * @brief A built permutation.
+         */
+        struct Variant {
+
+            unsigned int program_id = 0;                                    /// OpenGL ID of its program.
+            std::unordered_map<std::string, GLint> uniform_locations;       /// Locations of its active uniforms by name.
+
+        };
+
+        /**
+         * @brief The sources and permutations shared by copies of a shader.
+         */
+        struct Permutations {
+
+            std::string vertex_filename;                                    /// Vertex shader filename.
+            std::string fragment_filename;                                  /// Fragment shader filename.
+            std::string vertex_source;                                      /// Source of the vertex shader.
+            std::string fragment_source;                                    /// Source of the fragment shader.
+            std::unordered_map<unsigned int, Variant> variants;             /// Permutations built, by feature mask.
+            std::unordered_map<std::string, int> samplers;                  /// Slots of the samplers passed, by name.
+
+        };
+
+        /**
+         * @brief Adds the defines of some features to a source.
+         *
+         * Adds a #define per feature right after the #version line.
+         *
+         * @param source The source.
+         * @param features The feature mask.
+         *
+         * @returns The source with the defines.
+         */
+        static std::string addDefines(const std::string& source, unsigned int features);
+
+        /**
+         * @brief Builds the program.
+         *
+         * Creates the program from its cache file if it is valid. Otherwise
+         * compiles and links the sources and writes the cache for the next run.
+         *
+         * @param vertex_source The source of the vertex shader.
+         * @param fragment_source The source of the fragment shader.
+         * @param cache_path The cache file of the program.
+         *
+         * @returns True if it was read from the cache.
+         */
+        bool buildProgram(const std::string& vertex_source, const std::string& fragment_source, const std::string& cache_path);
+
         /**
          * @brief Check for errors in the program or shader.
          * 
@@ -220,6 +455,38 @@ namespace bgq_opengl {
          */
         static bool checkShader(unsigned int shader, std::string type, std::string* log_str);
 
+        /**
+         * @brief Binds a uniform block to a binding point.
+         *
+         * Binds a uniform block of the program to a uniform buffer binding point.
+         * Does nothing if the program has no block with that name.
+         *
+         * @param name The name of the block within the shaders.
+         * @param binding The binding point.
+         */
+        void bindUniformBlock(const std::string& name, GLuint binding);
+
+        /**
+         * @brief Builds a permutation.
+         *
+         * Builds the program of a permutation and its uniform table, and
+         * selects it.
+         *
+         * @param features The feature mask.
+         *
+         * @returns The permutation.
+         */
+        Variant& buildVariant(unsigned int features);
+
+        /**
+         * @brief Builds the uniform table.
+         *
+         * Asks the linked program for all its active uniforms once and stores
+         * their locations, so they never have to be looked up in the driver again.
+         * The Frame and Material blocks are bound to their binding points too.
+         */
+        void loadUniforms();
+
         /**
          * @brief Gets the content of a file as a string.
          *
@@ -232,8 +499,12 @@ namespace bgq_opengl {
          */
         static void readFileContents(const char* filename, std::string *file_contents);
 
-        Light* light; /// The light that will be used in the shader.
-        unsigned int programID = -1; /// OpenGL ID for this shader program.
+        unsigned int programID = -1; /// OpenGL ID for the program of the selected permutation.
+        std::unordered_map<std::string, GLint> *uniform_locations = nullptr; /// Locations of the active uniforms of the selected permutation by name.
+        std::shared_ptr<Permutations> permutations; /// Sources and permutations, shared with the copies.
+        unsigned int features = 0; /// Features of the selected permutation.
+
+        static bool srgb_framebuffer; /// Whether the framebuffer encodes to sRGB.
 
     };
 
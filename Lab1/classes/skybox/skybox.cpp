@@ -25,6 +25,10 @@
 #include "classes/camera/camera.h"
 #include "classes/shader/shader.h"
 #include "classes/cubemap/cubemap.h"
+#include "classes/ebo/ebo.h"
+#include "classes/gl_state/gl_state.h"
+#include "classes/vao/vao.h"
+#include "classes/vbo/vbo.h"
 
 namespace bgq_opengl {
 
@@ -59,34 +63,23 @@ namespace bgq_opengl {
             6, 2, 3
         };
         
-        // Create VAO, VBO, and EBO for the skybox.
-        glGenVertexArrays(1, &this->vao);
-        glGenBuffers(1, &this->vbo);
-        glGenBuffers(1, &this->ebo);
+        // Bind the VAO so the EBO is attached to it.
+        this->vao.bind();
         
-        // Bind them.
-        glBindVertexArray(this->vao);
-        
-        // Fill the VBo with the vertices.
-        glBindBuffer(GL_ARRAY_BUFFER, this->vbo);
-        glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), &vertices, GL_STATIC_DRAW);
-        
-        // Fill the indices into the EBO.
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo);
-        glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(indices), &indices, GL_STATIC_DRAW);
+        // Fill the VBO with the vertices and the EBO with the indices.
+        this->vbo = VBO(vertices, sizeof(vertices), GL_STATIC_DRAW);
+        this->ebo = EBO(indices);
         
         // Pass the data to the layout.
-        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void*)0);
+        this->vao.link_attribute(this->vbo, 0, 3, GL_FLOAT, 3 * sizeof(float), (void*)0);
         
         // Unbind everything.
-        glEnableVertexAttribArray(0);
-        glBindBuffer(GL_ARRAY_BUFFER, 0);
-        glBindVertexArray(0);
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+        this->vao.unbind();
+        this->ebo.unbind();
 
     }
 
-    Cubemap Skybox::getCubemap() {
+    Cubemap& Skybox::getCubemap() {
         
         return this->cubemap;
         
@@ -98,29 +91,22 @@ namespace bgq_opengl {
         
     }
 
-    void Skybox::draw(Shader &shader, Camera &camera) {
+    void Skybox::draw(Shader &shader) {
         
         // We do this so that OpenGL does not discard the object.
         glDepthFunc(GL_LEQUAL);
 
         // Activate the shader.
+        // The View and Projection come from the Frame block, already filled for this frame.
         shader.activate();
-                
-        // Apply this tranformation to the view so that it won't move with the camera.
-        glm::mat4 view = glm::mat4(glm::mat3(camera.getView()));
-        glm::mat4 projection = camera.getProjection();
-
-        // Pass these matrices to the shaders.
-        glUniformMatrix4fv(glGetUniformLocation(shader.getProgramID(), "View"), 1, GL_FALSE, glm::value_ptr(view));
-        glUniformMatrix4fv(glGetUniformLocation(shader.getProgramID(), "Projection"), 1, GL_FALSE, glm::value_ptr(projection));
 
         // Draws the cubemap as the last object so we can save a bit of performance by discarding all fragments
         // where an object is present (a depth of 1.0f will always fail against any object's depth value)
-        glBindVertexArray(this->vao);
-        glActiveTexture(GL_TEXTURE0);
-        glBindTexture(GL_TEXTURE_CUBE_MAP, cubemap.getID());
+        this->vao.bind();
+        GLState::bindTexture(0, GL_TEXTURE_CUBE_MAP, cubemap.getID());
         glDrawElements(GL_TRIANGLES, 36, GL_UNSIGNED_INT, 0);
-        glBindVertexArray(0);
+        GLState::countDraw(12);
+        this->vao.unbind();
 
         // Switch back to the normal depth function
         glDepthFunc(GL_LESS);
@@ -58,9 +58,9 @@ namespace bgq_opengl {
 			 *
 			 * Get the textures.
              *
-             * @returns The cubemap.
+             * @returns A reference to the cubemap.
 			 */
-			Cubemap getCubemap();
+			Cubemap& getCubemap();
         
             /**
              * @brief Get the textures.
@@ -74,14 +74,19 @@ namespace bgq_opengl {
 			/**
 			 * @brief Draws the Geometry.
 			 *
-			 * Displays the Geometry in OpenGL.
+			 * Displays the Geometry in OpenGL. The camera is read from the Frame
+			 * block, so it has to be filled for this frame.
+			 *
+			 * @param shader The skybox shader.
 			 */
-			void draw(Shader &shader, Camera &camera);
+			void draw(Shader &shader);
 
 		private:
 
-            Cubemap cubemap = Cubemap(0, "", 0);    /// The cubemap texture that will color this skybox.
-            unsigned int vao, vbo, ebo;             /// The IDs of the buffers of OpenGL.
+            Cubemap cubemap;    /// The cubemap texture that will color this skybox.
+            VAO vao;            /// The VAO of the cube.
+            VBO vbo;            /// The corners of the cube.
+            EBO ebo;            /// The triangles of the cube.
 
 	};
 
@@ -19,72 +19,110 @@
 
 #include <assert.h>
 
+#include <algorithm>
+#include <iostream>
+#include <memory>
+#include <string>
+
 #include "GL/glew.h"
 #include "stb/stb_image.h"
 
+#include "classes/async_loader/async_loader.h"
+#include "classes/gl_state/gl_state.h"
+#include "classes/gl_texture/gl_texture.h"
+#include "classes/shader/shader.h"
+#include "classes/texture_cache/texture_cache.h"
+#include "structs/cache_stats/cache_stats.h"
+#include "structs/image_payload/image_payload.h"
+#include "structs/texture_options/texture_options.h"
+
 namespace bgq_opengl {
 
-	Texture::Texture(const char* image, const char* name, GLuint slot) {
+	Texture::Texture(const char* image, const char* name, GLuint slot, const TextureOptions &options) {
         
         // The slot has to be a positive number because OpenGL does weird stuff on macOS else.
         if (slot < 1) assert(false);
 
-		// Generate a texture in OpenGL and store the parameters in the attributes.
-		glGenTextures(1, &this->ID);
+		// Store the parameters in the attributes.
 		this->name = std::string(name);
 		this->slot = slot;
 
-		// This function has to be used because OpenGL loads texture the opposite way
-		// than this library, so images appear upside down.
-		stbi_set_flip_vertically_on_load(true);
+		// Reuse the image if it is already in OpenGL with these options, load it else.
+		this->texture = GLTexture::getRegistry().acquire(Texture::getKey(image, options), [&]() {
 
-		// Read the texture image and its information.
-		unsigned char* image_bytes = stbi_load(image, &this->texture_width,
-				&this->texture_height, &this->texture_channels, 0);
+			return Texture::load(image, slot, options);
 
-		// Set the slot for the texture.
-		glActiveTexture(GL_TEXTURE0 + slot);
-		glBindTexture(GL_TEXTURE_2D, this->ID);
+		});
 
-		// Configure the magnifying algorithm, minifying algorithm and repetition.
-		// This tells OpenGL how to apply intrpolation.
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST_MIPMAP_LINEAR);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+	}
 
-		// Get the color model for the image.
-		GLenum color_model = GL_RGBA;
+	Texture::Texture(const char* image, const char* name, GLuint slot, AsyncLoader &loader, const TextureOptions &options) {
 
-		if (this->texture_channels == 4)
-			color_model = GL_RGBA;
-		else if (this->texture_channels == 3)
-			color_model = GL_RGB;
-		else if (this->texture_channels == 1)
-			color_model = GL_RED;
-		else
-			assert(false);
+        // The slot has to be a positive number because OpenGL does weird stuff on macOS else.
+        if (slot < 1) assert(false);
 
-		// Load the image to OpenGL.
-		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, this->texture_width, this->texture_height,
-				0, color_model, GL_UNSIGNED_BYTE, image_bytes);
-		glGenerateMipmap(GL_TEXTURE_2D);
+		// Store the parameters in the attributes.
+		this->name = std::string(name);
+		this->slot = slot;
 
-		// Clean the memory.
-		stbi_image_free(image_bytes);
+		// Reuse the image if it is already in OpenGL or on its way, load it else.
+		this->texture = GLTexture::getRegistry().acquire(Texture::getKey(image, options), [&]() {
 
-		// Unbinds the OpenGL Texture.
-		glBindTexture(GL_TEXTURE_2D, 0);
+			// Start with a white pixel.
+			std::shared_ptr<GLTexture> texture = std::make_shared<GLTexture>(GL_TEXTURE_2D);
+			ImagePayload placeholder;
+			placeholder.pixels = std::shared_ptr<unsigned char>(new unsigned char[4] {255, 255, 255, 255}, std::default_delete<unsigned char[]>());
+			placeholder.width = 1;
+			placeholder.height = 1;
+			placeholder.channels = 4;
+			Texture::upload(*texture, placeholder, slot, options);
+
+			// Decode the image on a worker and upload it here. Only a weak
+			// reference leaves this thread, so it can never delete the texture.
+			std::weak_ptr<GLTexture> target = texture;
+			std::string path = image;
+			AsyncLoader *async = &loader;
+
+			loader.run([async, target, path, slot, options]() {
+
+				ImagePayload payload = Texture::decode(path.c_str(), options);
+
+				// Keep the placeholder if the image could not be read.
+				if (!payload.pixels) {
+
+					std::cerr << "Texture error: texture " << path << " could not be loaded." << std::endl;
+					return;
+
+				}
+
+				async->upload([target, payload, slot, options]() {
+
+					if (std::shared_ptr<GLTexture> texture = target.lock())
+						Texture::upload(*texture, payload, slot, options);
+
+				});
+
+			});
+
+			return texture;
+
+		});
 
 	}
 
-	GLuint Texture::getID() {
+	CacheStats Texture::getCacheStats() {
 
-		return this->ID;
+		return GLTexture::getRegistry().getStats();
 
 	}
 
-	GLuint Texture::getSlot() {
+	GLuint Texture::getID() const {
+
+		return this->texture ? this->texture->getID() : 0;
+
+	}
+
+	GLuint Texture::getSlot() const {
 
 		return this->slot;
 
@@ -92,23 +130,23 @@ namespace bgq_opengl {
 
 	int Texture::getWidth() {
 
-		return this->texture_width;
+		return this->texture ? this->texture->getWidth() : 0;
 
 	}
 
 	int Texture::getHeight() {
 
-		return this->texture_height;
+		return this->texture ? this->texture->getHeight() : 0;
 
 	}
 
 	int Texture::getChannels() {
 
-		return this->texture_channels;
+		return this->texture ? this->texture->getChannels() : 0;
 
 	}
 
-	std::string Texture::getName() {
+	const std::string& Texture::getName() const {
 
 		return this->name;
 
@@ -117,20 +155,136 @@ namespace bgq_opengl {
 	void Texture::bind() {
 
 		// Activate the texture and bind it.
-		glActiveTexture(GL_TEXTURE0 + this->slot);
-		glBindTexture(GL_TEXTURE_2D, this->ID);
+		GLState::bindTexture(this->slot, GL_TEXTURE_2D, this->getID());
 
 	}
 
 	void Texture::remove() {
 
-		glDeleteTextures(1, &this->ID);
+		// Drop this reference. OpenGL deletes it when the last one is dropped.
+		this->texture.reset();
 
 	}
 
 	void Texture::unbind() {
 
-		glBindTexture(GL_TEXTURE_2D, 0);
+		// Unbind the texture from its slot.
+		GLState::bindTexture(this->slot, GL_TEXTURE_2D, 0);
+
+	}
+
+	ImagePayload Texture::decode(const char* image, const TextureOptions &options) {
+
+		// Skip decoding if the image did not change since it was cached.
+		ImagePayload payload = TextureCache::read(image, options.flip);
+		if (payload.pixels)
+			return payload;
+
+		// OpenGL loads texture the opposite way than this library, so images appear
+		// upside down unless they are flipped. Set only for this thread.
+		stbi_set_flip_vertically_on_load_thread(options.flip);
+
+		// Read the texture image and its information, expanded to RGBA as OpenGL
+		// stores it.
+		int file_channels = 0;
+		unsigned char* image_bytes = stbi_load(image, &payload.width,
+				&payload.height, &file_channels, 4);
+		if (!image_bytes)
+			return payload;
+
+		payload.pixels = std::shared_ptr<unsigned char>(image_bytes, stbi_image_free);
+		payload.channels = 4;
+
+		// Build the mipmaps here and keep everything for the next run. It is fine if
+		// the cache cannot be written.
+		TextureCache::buildMipmaps(payload);
+		TextureCache::write(image, options.flip, payload);
+
+		return payload;
+
+	}
+
+	void Texture::upload(GLTexture &texture, const ImagePayload &payload, GLuint slot, const TextureOptions &options) {
+
+		texture.setSize(payload.width, payload.height, payload.channels);
+
+		// Set the slot for the texture.
+		GLState::bindTexture(slot, GL_TEXTURE_2D, texture.getID());
+
+		// Configure the magnifying algorithm, minifying algorithm and repetition.
+		// This tells OpenGL how to apply intrpolation.
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, options.min_filter);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, options.mag_filter);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, options.wrap);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, options.wrap);
+
+		// Get the color model for the image.
+		GLenum color_model = GL_RGBA;
+
+		if (payload.channels == 4)
+			color_model = GL_RGBA;
+		else if (payload.channels == 3)
+			color_model = GL_RGB;
+		else if (payload.channels == 1)
+			color_model = GL_RED;
+		else
+			assert(false);
+
+		// Store it as sRGB if the framebuffer encodes to it, so it is read linear.
+		GLint internal_format = Shader::getSRGBFramebuffer() ? GL_SRGB8_ALPHA8 : GL_RGBA;
+
+		// Load the image to OpenGL.
+		glTexImage2D(GL_TEXTURE_2D, 0, internal_format, payload.width, payload.height,
+				0, color_model, GL_UNSIGNED_BYTE, payload.pixels.get());
+
+		// Only fill the mipmaps if the filter reads them. Upload them if they were
+		// built already, or build them here else.
+		if (options.min_filter != GL_NEAREST && options.min_filter != GL_LINEAR) {
+
+			if (payload.mipmaps.size() + 1 == TextureCache::getLevelCount(payload.width, payload.height)) {
+
+				int width = payload.width;
+				int height = payload.height;
+
+				for (size_t i = 0; i < payload.mipmaps.size(); i++) {
+
+					width = std::max(1, width / 2);
+					height = std::max(1, height / 2);
+					glTexImage2D(GL_TEXTURE_2D, (GLint) i + 1, internal_format, width, height,
+							0, color_model, GL_UNSIGNED_BYTE, payload.mipmaps[i].get());
+
+				}
+
+			} else {
+
+				glGenerateMipmap(GL_TEXTURE_2D);
+
+			}
+
+		}
+
+		// Unbinds the OpenGL Texture.
+		GLState::bindTexture(slot, GL_TEXTURE_2D, 0);
+
+	}
+
+	std::shared_ptr<GLTexture> Texture::load(const char* image, GLuint slot, const TextureOptions &options) {
+
+		// Generate a texture in OpenGL and fill it.
+		std::shared_ptr<GLTexture> texture = std::make_shared<GLTexture>(GL_TEXTURE_2D);
+		Texture::upload(*texture, Texture::decode(image, options), slot, options);
+
+		return texture;
+
+	}
+
+	std::string Texture::getKey(const char* image, const TextureOptions &options) {
+
+		return std::string(image)
+			+ "|flip=" + std::to_string(options.flip)
+			+ "|min=" + std::to_string(options.min_filter)
+			+ "|mag=" + std::to_string(options.mag_filter)
+			+ "|wrap=" + std::to_string(options.wrap);
 
 	}
 
@@ -16,17 +16,26 @@
 #ifndef BGQ_OPENGL_CLASS_TEXTURE_H_
 #define BGQ_OPENGL_CLASS_TEXTURE_H_
 
+#include <memory>
 #include <string>
 
 #include "GL/glew.h"
 
+#include "classes/async_loader/async_loader.h"
+#include "classes/gl_texture/gl_texture.h"
+#include "structs/cache_stats/cache_stats.h"
+#include "structs/image_payload/image_payload.h"
+#include "structs/texture_options/texture_options.h"
+
 namespace bgq_opengl {
 
 	/**
 	 * @brief Implements a texture class to handle object textures.
 	 * 
 	 * Implements a texture object to handle textures and their content to use
-	 * with the objects.
+	 * with the objects. Textures are cheap to copy: the image in OpenGL is shared
+	 * with every other texture loaded from the same file with the same options,
+	 * and freed when the last one is removed or destroyed.
 	 * 
 	 * @author Borja García Quiroga <garcaqub@tcd.ie>
 	 */
@@ -42,8 +51,34 @@ namespace bgq_opengl {
 			 * @param image Image containing the texture.
 			 * @param type Texture type.
 			 * @param slot Texture slot.
+			 * @param options How the image is loaded and sampled.
+			 */
+			Texture(const char* image, const char* type, GLuint slot, const TextureOptions &options = TextureOptions());
+
+			/**
+			 * @brief Creates a texture from an image in the background.
+			 *
+			 * Creates a texture holding a single white pixel and decodes the
+			 * image on a worker of the loader. The pixel is replaced by the image
+			 * on a later upload, in every texture sharing it.
+			 *
+			 * @param image Image containing the texture.
+			 * @param type Texture type.
+			 * @param slot Texture slot.
+			 * @param loader The loader decoding and uploading the image.
+			 * @param options How the image is loaded and sampled.
+			 */
+			Texture(const char* image, const char* type, GLuint slot, AsyncLoader &loader, const TextureOptions &options = TextureOptions());
+
+			/**
+			 * @brief Get the cache counters.
+			 *
+			 * Get how many textures and cubemaps were reused from the cache and
+			 * how many had to be loaded.
+			 *
+			 * @returns The counters.
 			 */
-			Texture(const char* image, const char* type, GLuint slot);
+			static CacheStats getCacheStats();
 
 			/**
 			 * @brief Get the ID of the texture.
@@ -52,7 +87,7 @@ namespace bgq_opengl {
 			 * 
 			 * @returns The ID of the texture.
 			 */
-			GLuint getID();
+			GLuint getID() const;
 
 			/**
 			 * @brief Get the slot of the texture.
@@ -61,7 +96,7 @@ namespace bgq_opengl {
 			 * 
 			 * @returns The slot of the texture.
 			 */
-			GLuint getSlot();
+			GLuint getSlot() const;
 
 			/**
 			 * @brief Gets the width of the image.
@@ -95,9 +130,9 @@ namespace bgq_opengl {
 			 * 
 			 * Gets the texture name as a char array.
 			 * 
-			 * @returns A char string containing the name name of the texture.
+			 * @returns A read-only reference to the name of the texture.
 			 */
-			std::string getName();
+			const std::string& getName() const;
 
 			/**
 			 * @brief Binds the texture.
@@ -109,7 +144,8 @@ namespace bgq_opengl {
 			/**
 			 * @brief Removes the texture from OpenGL.
 			 *
-			 *  Removes the texture from OpenGL.
+			 * Drops this reference to the image. It is removed from OpenGL once no
+			 * other texture uses it.
 			 */
 			void remove();
 
@@ -120,14 +156,65 @@ namespace bgq_opengl {
 			 */
 			void unbind();
 
+			/**
+			 * @brief Decodes an image.
+			 *
+			 * Reads an image file into memory as RGBA, with its mipmaps. It is
+			 * read from its cache if the image did not change, and decoded and
+			 * cached else. It does not touch OpenGL, so it can run on any thread.
+			 *
+			 * @param image Image containing the texture.
+			 * @param options How the image is loaded and sampled.
+			 *
+			 * @returns The decoded image.
+			 */
+			static ImagePayload decode(const char* image, const TextureOptions &options);
+
+			/**
+			 * @brief Uploads a decoded image.
+			 *
+			 * Uploads a decoded image to a 2D texture, with mipmaps if the
+			 * minifying filter uses them.
+			 *
+			 * @param texture The texture to fill.
+			 * @param payload The decoded image.
+			 * @param slot Texture slot used while uploading.
+			 * @param options How the image is loaded and sampled.
+			 */
+			static void upload(GLTexture &texture, const ImagePayload &payload, GLuint slot, const TextureOptions &options);
+
 		private:
 
-			GLuint ID;					/// Texture OpenGL ID.
-			GLuint slot;				/// Stores the texture slot number.
-			int texture_width = 0;		/// Width of the texture in pixels.
-			int texture_height = 0;		/// Height of the texture in pixels.
-			int texture_channels = 0;	/// Number of channels of the texture.
-			std::string name;			/// Texture name.
+			/**
+			 * @brief Loads an image into OpenGL.
+			 *
+			 * Reads an image file and uploads it as a 2D texture, with mipmaps
+			 * if the minifying filter uses them.
+			 *
+			 * @param image Image containing the texture.
+			 * @param slot Texture slot used while uploading.
+			 * @param options How the image is loaded and sampled.
+			 *
+			 * @returns The new texture.
+			 */
+			static std::shared_ptr<GLTexture> load(const char* image, GLuint slot, const TextureOptions &options);
+
+			/**
+			 * @brief Builds the cache key of a texture.
+			 *
+			 * Builds a key from the path and every option, so the same image
+			 * with other options is a different texture.
+			 *
+			 * @param image Image containing the texture.
+			 * @param options How the image is loaded and sampled.
+			 *
+			 * @returns The key.
+			 */
+			static std::string getKey(const char* image, const TextureOptions &options);
+
+			std::shared_ptr<GLTexture> texture;	/// The image in OpenGL, shared.
+			GLuint slot;						/// Stores the texture slot number.
+			std::string name;					/// Texture name.
 
 	};
 
@@ -0,0 +1,222 @@
+/**
+ * @file texture_cache.cpp
+ * @brief TextureCache class implementation file.
+ * @version 1.0.0 (2026-10-17)
+ * @date 2026-10-17
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#include "texture_cache.h"
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "classes/mapped_file/mapped_file.h"
+#include "structs/image_payload/image_payload.h"
+
+namespace bgq_opengl {
+
+	TextureCache::TextureCache(const char* path) : file(path) {
+
+		// Start reading it in now, so the upload does not wait for the disk.
+		this->file.prefetch();
+
+	}
+
+	void TextureCache::buildMipmaps(ImagePayload &payload) {
+
+		payload.mipmaps.clear();
+
+		const unsigned char *source = payload.pixels.get();
+		int source_width = payload.width;
+		int source_height = payload.height;
+
+		for (size_t level = 1; level < TextureCache::getLevelCount(payload.width, payload.height); level++) {
+
+			int width = std::max(1, source_width / 2);
+			int height = std::max(1, source_height / 2);
+
+			std::shared_ptr<unsigned char> pixels(new unsigned char[(size_t) width * height * 4], std::default_delete<unsigned char[]>());
+			unsigned char *target = pixels.get();
+
+			// Average each block of two by two. Odd edges repeat their last row or column.
+			for (int y = 0; y < height; y++) {
+
+				const unsigned char *row0 = source + (size_t) std::min(2 * y, source_height - 1) * source_width * 4;
+				const unsigned char *row1 = source + (size_t) std::min(2 * y + 1, source_height - 1) * source_width * 4;
+
+				for (int x = 0; x < width; x++) {
+
+					int x0 = std::min(2 * x, source_width - 1) * 4;
+					int x1 = std::min(2 * x + 1, source_width - 1) * 4;
+
+					for (int channel = 0; channel < 4; channel++)
+						target[((size_t) y * width + x) * 4 + channel] = (unsigned char) ((row0[x0 + channel] + row0[x1 + channel]
+							+ row1[x0 + channel] + row1[x1 + channel] + 2) / 4);
+
+				}
+
+			}
+
+			payload.mipmaps.push_back(pixels);
+			source = target;
+			source_width = width;
+			source_height = height;
+
+		}
+
+	}
+
+	size_t TextureCache::getLevelCount(int width, int height) {
+
+		size_t levels = 1;
+		for (int largest = std::max(width, height); largest > 1; largest /= 2)
+			levels++;
+
+		return levels;
+
+	}
+
+	std::string TextureCache::getPath(const char* source) {
+
+		return std::string(source) + ".bgqtex";
+
+	}
+
+	ImagePayload TextureCache::read(const char* source, bool flip) {
+
+		ImagePayload payload;
+
+		std::string path = TextureCache::getPath(source);
+		std::shared_ptr<TextureCache> cache = std::make_shared<TextureCache>(path.c_str());
+		if (!cache->isValid(source, flip))
+			return payload;
+
+		const unsigned char *data = cache->file.getData().data();
+		const Header *header = (const Header *) data;
+		const Entry *entries = (const Entry *) (data + sizeof(Header));
+
+		// Every level shares ownership of the mapping. It is never written to.
+		payload.width = (int) header->width;
+		payload.height = (int) header->height;
+		payload.channels = 4;
+		payload.pixels = std::shared_ptr<unsigned char>(cache, (unsigned char *) data + entries[0].offset);
+
+		for (uint32_t level = 1; level < header->level_count; level++)
+			payload.mipmaps.push_back(std::shared_ptr<unsigned char>(cache, (unsigned char *) data + entries[level].offset));
+
+		return payload;
+
+	}
+
+	bool TextureCache::write(const char* source, bool flip, const ImagePayload &payload) {
+
+		// Build the header.
+		Header header;
+		std::memcpy(header.magic, "BGQT", 4);
+		header.version = TextureCache::version;
+		header.width = (uint32_t) payload.width;
+		header.height = (uint32_t) payload.height;
+		header.level_count = (uint32_t) (payload.mipmaps.size() + 1);
+		header.flip = flip ? 1 : 0;
+
+		if (payload.channels != 4 || header.level_count != TextureCache::getLevelCount(payload.width, payload.height))
+			return false;
+
+		if (!MappedFile::getStamp(source, &header.source_size, &header.source_time))
+			return false;
+
+		// Lay the levels out after the entries, every one aligned.
+		std::vector<Entry> entries(header.level_count);
+		std::vector<const unsigned char *> levels(header.level_count);
+		uint64_t offset = sizeof(Header) + entries.size() * sizeof(Entry);
+		int width = payload.width;
+		int height = payload.height;
+
+		for (size_t i = 0; i < entries.size(); i++) {
+
+			offset = (offset + TextureCache::alignment - 1) / TextureCache::alignment * TextureCache::alignment;
+			entries[i].offset = offset;
+			entries[i].size = (uint64_t) width * height * 4;
+			offset += entries[i].size;
+
+			levels[i] = i == 0 ? payload.pixels.get() : payload.mipmaps[i - 1].get();
+			width = std::max(1, width / 2);
+			height = std::max(1, height / 2);
+
+		}
+
+		// Write the header, the entries and every level.
+		std::vector<MappedFile::Block> blocks;
+		blocks.push_back({0, &header, sizeof(Header)});
+		blocks.push_back({sizeof(Header), entries.data(), entries.size() * sizeof(Entry)});
+
+		for (size_t i = 0; i < entries.size(); i++)
+			blocks.push_back({entries[i].offset, levels[i], entries[i].size});
+
+		return MappedFile::write(TextureCache::getPath(source).c_str(), blocks);
+
+	}
+
+	bool TextureCache::isValid(const char* source, bool flip) const {
+
+		// It has to have a header of this version.
+		const unsigned char *data = this->file.getData().data();
+		size_t size = this->file.getData().size();
+		if (data == nullptr || size < sizeof(Header))
+			return false;
+
+		const Header *header = (const Header *) data;
+		if (std::memcmp(header->magic, "BGQT", 4) != 0 || header->version != TextureCache::version
+			|| header->flip != (flip ? 1u : 0u))
+			return false;
+
+		// The image cannot have changed since.
+		uint64_t source_size;
+		int64_t source_time;
+		if (!MappedFile::getStamp(source, &source_size, &source_time)
+			|| header->source_size != source_size || header->source_time != source_time)
+			return false;
+
+		// It has to hold the whole chain, and every level has to be inside the file.
+		if (header->width == 0 || header->height == 0 || header->width > INT32_MAX || header->height > INT32_MAX
+			|| header->level_count != TextureCache::getLevelCount((int) header->width, (int) header->height))
+			return false;
+
+		if (header->level_count > (size - sizeof(Header)) / sizeof(Entry))
+			return false;
+
+		const Entry *entries = (const Entry *) (data + sizeof(Header));
+		uint64_t width = header->width;
+		uint64_t height = header->height;
+
+		for (uint32_t i = 0; i < header->level_count; i++) {
+
+			const Entry &entry = entries[i];
+
+			if (entry.offset % TextureCache::alignment != 0 || entry.size != width * height * 4)
+				return false;
+
+			if (entry.offset > size || entry.size > size - entry.offset)
+				return false;
+
+			width = std::max<uint64_t>(1, width / 2);
+			height = std::max<uint64_t>(1, height / 2);
+
+		}
+
+		return true;
+
+	}
+
+}  // namespace bgq_opengl
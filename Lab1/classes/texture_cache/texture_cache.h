@@ -0,0 +1,175 @@
+/**
+ * @file texture_cache.h
+ * @brief TextureCache class header file.
+ * @version 1.0.0 (2026-10-17)
+ * @date 2026-10-17
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#ifndef BGQ_OPENGL_CLASSES_TEXTURE_CACHE_H_
+#define BGQ_OPENGL_CLASSES_TEXTURE_CACHE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "classes/mapped_file/mapped_file.h"
+#include "structs/image_payload/image_payload.h"
+
+namespace bgq_opengl {
+
+	/**
+	 * @brief Implements a binary cache of a decoded image.
+	 *
+	 * Implements a binary file holding an image already decoded, flipped and
+	 * expanded to RGBA, as OpenGL stores it, with its whole chain of mipmaps, so
+	 * later runs can upload it level by level without decoding it or building
+	 * the mipmaps. The file is mapped to memory and the payloads read from it
+	 * point straight into the mapping, keeping it alive until they are freed.
+	 *
+	 * The file starts with a header, followed by one entry per level and the
+	 * pixels they point to. It stores the size and modification time of the
+	 * image it was built from, so it is ignored as soon as the image changes. It
+	 * is written in the byte order of the machine, so it is not meant to be
+	 * shared.
+	 *
+	 * @author Borja García Quiroga <garcaqub@tcd.ie>
+	 */
+	class TextureCache {
+
+		public:
+
+			/**
+			 * @brief Maps a cache file.
+			 *
+			 * Maps a cache file to memory. If it cannot be opened the cache is
+			 * empty and never valid.
+			 *
+			 * @param path The cache file.
+			 */
+			TextureCache(const char* path);
+
+			// The payloads point into the mapping, so it cannot be copied or moved.
+			TextureCache(const TextureCache&) = delete;
+			TextureCache& operator=(const TextureCache&) = delete;
+
+			/**
+			 * @brief Builds the mipmaps of an image.
+			 *
+			 * Fills the mipmaps of an RGBA image down to one pixel, each level
+			 * averaging blocks of two by two pixels of the one before.
+			 *
+			 * @param payload The image.
+			 */
+			static void buildMipmaps(ImagePayload &payload);
+
+			/**
+			 * @brief Get the number of levels of an image.
+			 *
+			 * Get the number of levels of a full chain of mipmaps, counting the
+			 * image itself.
+			 *
+			 * @param width The width of the image.
+			 * @param height The height of the image.
+			 *
+			 * @returns The number of levels.
+			 */
+			static size_t getLevelCount(int width, int height);
+
+			/**
+			 * @brief Get the cache file of an image.
+			 *
+			 * Get the path of the cache file of an image, next to it.
+			 *
+			 * @param source The image file.
+			 *
+			 * @returns The cache file.
+			 */
+			static std::string getPath(const char* source);
+
+			/**
+			 * @brief Reads an image from its cache.
+			 *
+			 * Reads an image and its mipmaps from its cache file, if it is valid.
+			 * The pixels point into the mapping, which stays alive while they do.
+			 *
+			 * @param source The image file.
+			 * @param flip Whether the image has to be flipped vertically.
+			 *
+			 * @returns The image, with null pixels if there is no valid cache.
+			 */
+			static ImagePayload read(const char* source, bool flip);
+
+			/**
+			 * @brief Writes a cache file.
+			 *
+			 * Writes an RGBA image and its mipmaps to its cache file. It is
+			 * written to a temporary file first so a failed write never leaves a
+			 * broken cache behind.
+			 *
+			 * @param source The image file the pixels come from.
+			 * @param flip Whether the pixels were flipped vertically.
+			 * @param payload The image, with all its mipmaps.
+			 *
+			 * @returns True if it was written.
+			 */
+			static bool write(const char* source, bool flip, const ImagePayload &payload);
+
+		private:
+
+			/**
+			 * @brief Header of a cache file.
+			 */
+			struct Header {
+
+				char magic[4];				/// Always "BGQT".
+				uint32_t version;			/// Format version.
+				uint32_t width;				/// Width of the image.
+				uint32_t height;			/// Height of the image.
+				uint32_t level_count;		/// Number of entries after the header.
+				uint32_t flip;				/// Whether the image is flipped vertically.
+				uint64_t source_size;		/// Size of the image file.
+				int64_t source_time;		/// Modification time of the image file.
+
+			};
+
+			/**
+			 * @brief Entry of a level in a cache file.
+			 */
+			struct Entry {
+
+				uint64_t offset;			/// Offset of the pixels from the start of the file.
+				uint64_t size;				/// Size of the pixels in bytes.
+
+			};
+
+			/**
+			 * @brief Checks if the cache can be used.
+			 *
+			 * Checks the format and version of the file, that every level lies
+			 * inside it and that the image has not changed since it was written.
+			 *
+			 * @param source The image file.
+			 * @param flip Whether the image has to be flipped vertically.
+			 *
+			 * @returns True if the cache is valid for the image.
+			 */
+			bool isValid(const char* source, bool flip) const;
+
+			static const uint32_t version = 1;		/// Current format version.
+			static const size_t alignment = 16;		/// Alignment of the levels.
+
+			MappedFile file;						/// The mapped cache file.
+
+	};
+
+}  // namespace bgq_opengl
+
+#endif  //!BGQ_OPENGL_CLASSES_TEXTURE_CACHE_H_
@@ -0,0 +1,114 @@
+/**
+ * @file ubo.cpp
+ * @brief UBO class implementation file.
+ * @version 1.0.0 (2026-10-17)
+ * @date 2026-10-17
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#include "ubo.h"
+
+#include <assert.h>
+
+#include <utility>
+
+#include "GL/glew.h"
+
+#include "classes/gl_state/gl_state.h"
+
+namespace bgq_opengl {
+
+	UBO::UBO() {}
+
+	UBO::UBO(GLsizeiptr size, GLuint binding) {
+
+		this->binding = binding;
+		this->size = size;
+
+		// Generate the buffer and allocate it.
+		glGenBuffers(1, &this->ID);
+		glBindBuffer(GL_UNIFORM_BUFFER, this->ID);
+		glBufferData(GL_UNIFORM_BUFFER, size, NULL, GL_DYNAMIC_DRAW);
+		glBindBuffer(GL_UNIFORM_BUFFER, 0);
+
+	}
+
+	UBO::UBO(UBO &&other) noexcept {
+
+		*this = std::move(other);
+
+	}
+
+	UBO::~UBO() {
+
+		this->remove();
+
+	}
+
+	UBO& UBO::operator=(UBO &&other) noexcept {
+
+		if (this != &other) {
+
+			// Free ours and take theirs.
+			this->remove();
+			this->ID = other.ID;
+			this->binding = other.binding;
+			this->size = other.size;
+			other.ID = 0;
+
+		}
+
+		return *this;
+
+	}
+
+	void UBO::bind() {
+
+		// Bind it to its binding point.
+		GLState::bindUniformBuffer(this->binding, this->ID);
+
+	}
+
+	GLuint UBO::getBinding() const {
+
+		return this->binding;
+
+	}
+
+	GLuint UBO::getID() const {
+
+		return this->ID;
+
+	}
+
+	void UBO::remove() {
+
+		// Delete the buffer in OpenGL, only once.
+		if (this->ID == 0)
+			return;
+
+		glDeleteBuffers(1, &this->ID);
+		GLState::forgetUniformBuffer(this->ID);
+		this->ID = 0;
+
+	}
+
+	void UBO::update(const void *data, GLsizeiptr size) {
+
+		assert(size == this->size);
+
+		// Replace the whole contents.
+		glBindBuffer(GL_UNIFORM_BUFFER, this->ID);
+		glBufferSubData(GL_UNIFORM_BUFFER, 0, size, data);
+		glBindBuffer(GL_UNIFORM_BUFFER, 0);
+
+	}
+
+}  // namespace bgq_opengl
@@ -0,0 +1,137 @@
+/**
+ * @file ubo.h
+ * @brief UBO class header file.
+ * @version 1.0.0 (2026-10-17)
+ * @date 2026-10-17
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#ifndef BGQ_OPENGL_CLASS_UBO_H_
+#define BGQ_OPENGL_CLASS_UBO_H_
+
+#include "GL/glew.h"
+
+namespace bgq_opengl {
+
+	/**
+	 * @brief Implementation of a UBO class.
+	 *
+	 * Implementation of a Uniform Buffer Object class that will allow us to fill
+	 * it, bind it to a binding point of the GL pipe or destroy it.
+	 *
+	 * @author Borja García Quiroga <garcaqub@tcd.ie>
+	 */
+	class UBO {
+
+	public:
+
+		/**
+		 * @brief Constructs an empty Uniform Buffer Object.
+		 *
+		 * Constructs a Uniform Buffer Object with no buffer in OpenGL. Nothing is
+		 * called in OpenGL, so it can be used before there is a context.
+		 */
+		UBO();
+
+		/**
+		 * @brief Constructs a Uniform Buffer Object.
+		 *
+		 * Constructs a Uniform Buffer Object and allocates its storage.
+		 *
+		 * @param size Size of the buffer in bytes.
+		 * @param binding Binding point the buffer will be bound to.
+		 */
+		UBO(GLsizeiptr size, GLuint binding);
+
+		/**
+		 * @brief Moves a Uniform Buffer Object.
+		 *
+		 * Takes the OpenGL object of another UBO, which is left empty.
+		 *
+		 * @param other The UBO to move from.
+		 */
+		UBO(UBO &&other) noexcept;
+
+		/**
+		 * @brief Destroys the Uniform Buffer Object.
+		 *
+		 * Deletes the OpenGL object, if it still has one.
+		 */
+		~UBO();
+
+		// Copies would delete the same OpenGL object twice.
+		UBO(const UBO&) = delete;
+		UBO& operator=(const UBO&) = delete;
+
+		/**
+		 * @brief Moves a Uniform Buffer Object.
+		 *
+		 * Deletes the OpenGL object of this UBO and takes the one of another,
+		 * which is left empty.
+		 *
+		 * @param other The UBO to move from.
+		 *
+		 * @returns This UBO.
+		 */
+		UBO& operator=(UBO &&other) noexcept;
+
+		/**
+		 * @brief Binds the UBO.
+		 *
+		 * Binds the UBO to its binding point.
+		 */
+		void bind();
+
+		/**
+		 * @brief Get the binding point.
+		 *
+		 * Get the binding point the buffer is bound to.
+		 *
+		 * @returns The binding point.
+		 */
+		GLuint getBinding() const;
+
+		/**
+		 * @brief Get the ID.
+		 *
+		 * Get the OpenGL ID of the buffer.
+		 *
+		 * @returns The ID. 0 if it has no buffer.
+		 */
+		GLuint getID() const;
+
+		/**
+		 * @brief Removes the UBO.
+		 *
+		 * Removes the UBO from OpenGL.
+		 */
+		void remove();
+
+		/**
+		 * @brief Updates the contents.
+		 *
+		 * Uploads new contents for the whole buffer.
+		 *
+		 * @param data Pointer to the data.
+		 * @param size Size of the data in bytes. Must match the size of the buffer.
+		 */
+		void update(const void *data, GLsizeiptr size);
+
+	private:
+
+		GLuint ID = 0;			// GL ID of the UBO.
+		GLuint binding = 0;		// Binding point of the UBO.
+		GLsizeiptr size = 0;	// Size of the UBO in bytes.
+
+	};
+
+}  // namespace bgq_opengl
+
+#endif //!BGQ_OPENGL_CLASS_UBO_H_
@@ -15,8 +15,11 @@
 
 #include "vao.h"
 
+#include <utility>
+
 #include "GL/glew.h"
 
+#include "classes/gl_state/gl_state.h"
 #include "classes/vbo/vbo.h"
 
 namespace bgq_opengl {
@@ -25,25 +28,57 @@ namespace bgq_opengl {
 
 		// Generate the buffer.
 		glGenVertexArrays(1, &this->ID);
-		glBindBuffer(GL_ARRAY_BUFFER, this->ID);
+
+	}
+
+	VAO::VAO(VAO &&other) noexcept {
+
+		*this = std::move(other);
+
+	}
+
+	VAO::~VAO() {
+
+		this->remove();
+
+	}
+
+	VAO& VAO::operator=(VAO &&other) noexcept {
+
+		if (this != &other) {
+
+			// Free ours and take theirs.
+			this->remove();
+			this->ID = other.ID;
+			other.ID = 0;
+
+		}
+
+		return *this;
 
 	}
 
 	void VAO::bind() {
 
 		// Bind the VAO.
-		glBindVertexArray(this->ID);
+		GLState::bindVertexArray(this->ID);
+
+	}
+
+	GLuint VAO::getID() const {
+
+		return this->ID;
 
 	}
 
 	void VAO::link_attribute(VBO& vbo, GLuint layout, GLuint num_components, GLenum type,
-		GLsizeiptr step, void* offset) {
+		GLsizeiptr step, void* offset, GLboolean normalized) {
 
 		// Bind the VBO.
 		vbo.bind();
 
 		// Tell OpenGL where the data in the VBO is located and activate the layout.
-		glVertexAttribPointer(layout, num_components, type, GL_FALSE, (GLsizei) step, offset);
+		glVertexAttribPointer(layout, num_components, type, normalized, (GLsizei) step, offset);
 		glEnableVertexAttribArray(layout);
 
 		// Unbind the vbo again.
@@ -51,17 +86,33 @@ namespace bgq_opengl {
 
 	}
 
+	void VAO::link_instance_attribute(VBO& vbo, GLuint layout, GLuint num_components, GLenum type,
+		GLsizeiptr step, void* offset) {
+
+		// Link it as any other attribute.
+		this->link_attribute(vbo, layout, num_components, type, step, offset);
+
+		// Advance it once per instance.
+		glVertexAttribDivisor(layout, 1);
+
+	}
+
 	void VAO::remove() {
 
-		// Deletes the VAO from the GL pipe.
+		// Deletes the VAO from the GL pipe, only once.
+		if (this->ID == 0)
+			return;
+
 		glDeleteVertexArrays(1, &this->ID);
+		GLState::forgetVertexArray(this->ID);
+		this->ID = 0;
 
 	}
 
 	void VAO::unbind() {
 
 		// Unbind the VAO by binding no VAO.
-		glBindVertexArray(0);
+		GLState::bindVertexArray(0);
 
 	}
 
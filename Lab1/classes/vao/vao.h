@@ -41,6 +41,38 @@ namespace bgq_opengl {
 		 */
 		VAO();
 
+		/**
+		 * @brief Moves a Vertex Array Object.
+		 *
+		 * Takes the OpenGL object of another VAO, which is left empty.
+		 *
+		 * @param other The VAO to move from.
+		 */
+		VAO(VAO &&other) noexcept;
+
+		/**
+		 * @brief Destroys the Vertex Array Object.
+		 *
+		 * Deletes the OpenGL object, if it still has one.
+		 */
+		~VAO();
+
+		// Copies would delete the same OpenGL object twice.
+		VAO(const VAO&) = delete;
+		VAO& operator=(const VAO&) = delete;
+
+		/**
+		 * @brief Moves a Vertex Array Object.
+		 *
+		 * Deletes the OpenGL object of this VAO and takes the one of another,
+		 * which is left empty.
+		 *
+		 * @param other The VAO to move from.
+		 *
+		 * @returns This VAO.
+		 */
+		VAO& operator=(VAO &&other) noexcept;
+
 		/**
 		 * @brief Binds the VBO.
 		 *
@@ -48,6 +80,15 @@ namespace bgq_opengl {
 		 */
 		void bind();
 
+		/**
+		 * @brief Returns the VAO ID.
+		 *
+		 * Returns the OpenGL ID of the VAO.
+		 *
+		 * @returns The ID, 0 if it was moved from or removed.
+		 */
+		GLuint getID() const;
+
 		/**
 		 * @brief Links a VBO attribute to the VAO.
 		 *
@@ -59,8 +100,25 @@ namespace bgq_opengl {
 		 * @param type The type of data that we will be passing.
 		 * @param step The amount of bytes we have to skip to find the next item.
 		 * @param offset The amount of data we have to skip to find the first item.
+		 * @param normalized Whether integer data is mapped to [-1, 1] or [0, 1].
 		 */
 		void link_attribute(VBO& vbo, GLuint layout, GLuint num_components, GLenum type,
+			GLsizeiptr step, void* offset, GLboolean normalized = GL_FALSE);
+
+		/**
+		 * @brief Links a per instance VBO attribute to the VAO.
+		 *
+		 * Links a VBO attribute that advances once per instance instead of once
+		 * per vertex. The VAO has to be bound.
+		 *
+		 * @param vbo The VBO to link the attribute to.
+		 * @param layout The layout identifier that will be used in the shader.
+		 * @param num_components The number of components that are in the list.
+		 * @param type The type of data that we will be passing.
+		 * @param step The amount of bytes we have to skip to find the next item.
+		 * @param offset The amount of data we have to skip to find the first item.
+		 */
+		void link_instance_attribute(VBO& vbo, GLuint layout, GLuint num_components, GLenum type,
 			GLsizeiptr step, void* offset);
 
 		/**
@@ -79,7 +137,7 @@ namespace bgq_opengl {
 
 	private:
 
-		GLuint ID; /// OpenGL VAO ID.
+		GLuint ID = 0; /// OpenGL VAO ID.
 	};
 
 }  // namespace bgq_opengl
@@ -15,6 +15,8 @@
 
 #include "vbo.h"
 
+#include <utility>
+#include <span>
 #include <vector>
 
 #include "GL/glew.h"
@@ -23,14 +25,54 @@
 
 namespace bgq_opengl {
 
-	VBO::VBO(const std::vector<Vertex> &vertices) {
+	VBO::VBO() {}
+
+	VBO::VBO(const void *data, GLsizeiptr size, GLenum usage) {
+
+		// Generate the buffer.
+		glGenBuffers(1, &this->ID);
+		glBindBuffer(GL_ARRAY_BUFFER, this->ID);
+
+		// Copy the data.
+		glBufferData(GL_ARRAY_BUFFER, size, data, usage);
+
+	}
+
+	VBO::VBO(std::span<const Vertex> vertices) {
 
 		// Generate the buffer.
 		glGenBuffers(1, &this->ID);
 		glBindBuffer(GL_ARRAY_BUFFER, this->ID);
 
 		// Link the vertices.
-		glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(Vertex), vertices.data(), GL_STATIC_DRAW);
+		glBufferData(GL_ARRAY_BUFFER, vertices.size_bytes(), vertices.data(), GL_STATIC_DRAW);
+
+	}
+
+	VBO::VBO(VBO &&other) noexcept {
+
+		*this = std::move(other);
+
+	}
+
+	VBO::~VBO() {
+
+		this->remove();
+
+	}
+
+	VBO& VBO::operator=(VBO &&other) noexcept {
+
+		if (this != &other) {
+
+			// Free ours and take theirs.
+			this->remove();
+			this->ID = other.ID;
+			other.ID = 0;
+
+		}
+
+		return *this;
 
 	}
 
@@ -41,10 +83,20 @@ namespace bgq_opengl {
 
 	}
 
+	GLuint VBO::getID() const {
+
+		return this->ID;
+
+	}
+
 	void VBO::remove() {
 
-		// Delete the buffer in OpenGL.
+		// Delete the buffer in OpenGL, only once.
+		if (this->ID == 0)
+			return;
+
 		glDeleteBuffers(1, &this->ID);
+		this->ID = 0;
 
 	}
 
@@ -56,4 +108,13 @@ namespace bgq_opengl {
 
 	}
 
+	void VBO::update(const void *data, GLsizeiptr size, GLenum usage) {
+
+		// Respecify the whole storage so the driver does not wait for draws still using the old one.
+		glBindBuffer(GL_ARRAY_BUFFER, this->ID);
+		glBufferData(GL_ARRAY_BUFFER, size, data, usage);
+		glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+	}
+
 }  // namespace bgq_opengl
@@ -16,6 +16,7 @@
 #ifndef BGQ_OPENGL_CLASS_VBO_H_
 #define BGQ_OPENGL_CLASS_VBO_H_
 
+#include <span>
 #include <vector>
 
 #include "GL/glew.h"
@@ -36,6 +37,24 @@ namespace bgq_opengl {
 
 	public:
 
+		/**
+		 * @brief Constructs an empty Vertex Buffer Object.
+		 *
+		 * Constructs a Vertex Buffer Object with no buffer in OpenGL.
+		 */
+		VBO();
+
+		/**
+		 * @brief Constructs a Vertex Buffer Object.
+		 *
+		 * Constructs a Vertex Buffer Object from raw data.
+		 *
+		 * @param data Pointer to the data.
+		 * @param size Size of the data in bytes.
+		 * @param usage OpenGL usage hint (GL_STATIC_DRAW, GL_DYNAMIC_DRAW...).
+		 */
+		VBO(const void *data, GLsizeiptr size, GLenum usage);
+
 		/**
 		 * @brief Constructs a Vertex Buffer Object.
 		 *
@@ -43,7 +62,39 @@ namespace bgq_opengl {
 		 *
 		 * @param vertices Vertices that will be linked.
 		 */
-		VBO(const std::vector<Vertex> &vertices);
+		VBO(std::span<const Vertex> vertices);
+
+		/**
+		 * @brief Moves a Vertex Buffer Object.
+		 *
+		 * Takes the OpenGL object of another VBO, which is left empty.
+		 *
+		 * @param other The VBO to move from.
+		 */
+		VBO(VBO &&other) noexcept;
+
+		/**
+		 * @brief Destroys the Vertex Buffer Object.
+		 *
+		 * Deletes the OpenGL object, if it still has one.
+		 */
+		~VBO();
+
+		// Copies would delete the same OpenGL object twice.
+		VBO(const VBO&) = delete;
+		VBO& operator=(const VBO&) = delete;
+
+		/**
+		 * @brief Moves a Vertex Buffer Object.
+		 *
+		 * Deletes the OpenGL object of this VBO and takes the one of another,
+		 * which is left empty.
+		 *
+		 * @param other The VBO to move from.
+		 *
+		 * @returns This VBO.
+		 */
+		VBO& operator=(VBO &&other) noexcept;
 
 		/**
 		 * @brief Binds the VBO.
@@ -52,6 +103,13 @@ namespace bgq_opengl {
 		 */
 		void bind();
 
+		/**
+		 * @brief Get the ID of the VBO.
+		 *
+		 * @returns The OpenGL ID, 0 if it is empty.
+		 */
+		GLuint getID() const;
+
 		/**
 		 * @brief Removes the VBO.
 		 *
@@ -66,9 +124,20 @@ namespace bgq_opengl {
 		 */
 		void unbind();
 
+		/**
+		 * @brief Replaces the contents.
+		 *
+		 * Replaces the whole contents of the buffer, which can change its size.
+		 *
+		 * @param data Pointer to the data.
+		 * @param size Size of the data in bytes.
+		 * @param usage OpenGL usage hint (GL_STATIC_DRAW, GL_DYNAMIC_DRAW...).
+		 */
+		void update(const void *data, GLsizeiptr size, GLenum usage);
+
 	private:
 
-		GLuint ID; // GL ID of the VBO.
+		GLuint ID = 0; // GL ID of the VBO.
 
 	};
 
@@ -21,8 +21,16 @@
 
 #include <algorithm>
 #include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
 #include <iostream>
 #include <random>
+#include <span>
+#include <string>
+#include <thread>
+#include <utility>
 #include <vector>
 
 #include "GL/glew.h"
@@ -30,18 +38,49 @@
 #include "imgui/imgui.h"
 #include "imgui/imgui_impl_glfw_gl3.h"
 #include "glm/glm.hpp"
+#include "glm/gtc/matrix_transform.hpp"
 #include "glm/gtc/quaternion.hpp"
 #include "glm/gtx/quaternion.hpp"
 #include "glm/common.hpp"
 #include "glm/gtx/string_cast.hpp"
 
+#include "classes/aabb_kernel/aabb_kernel.h"
 #include "classes/camera/camera.h"
 #include "classes/cubemap/cubemap.h"
+#include "classes/fbo/fbo.h"
+#include "classes/frustum/frustum.h"
+#include "classes/gl_state/gl_state.h"
 #include "classes/light/light.h"
 #include "classes/object/object.h"
 #include "classes/shader/shader.h"
 #include "classes/skybox/skybox.h"
+#include "classes/ubo/ubo.h"
 #include "structs/bounding_box/bounding_box.h"
+#include "structs/cache_stats/cache_stats.h"
+#include "structs/cull_stats/cull_stats.h"
+#include "structs/frame_data/frame_data.h"
+#include "structs/instance_data/instance_data.h"
+#include "structs/material_data/material_data.h"
+
+void captureFrame() {
+    
+    std::vector<unsigned char> pixels;
+    offscreen.readPixels(pixels);
+    
+    // Number the files so they sort in order.
+    char number[16];
+    snprintf(number, sizeof(number), "_%05d.ppm", frames_rendered);
+    std::string filename = capture_prefix + number;
+    
+    // A binary PPM is just a header and the RGB rows, so nothing else is needed to write it.
+    std::ofstream file(filename, std::ios::binary);
+    file << "P6\n" << offscreen.getWidth() << " " << offscreen.getHeight() << "\n255\n";
+    file.write((const char *) pixels.data(), (std::streamsize) pixels.size());
+    
+    if (!file)
+        std::cerr << "Could not write the frame " << filename << std::endl;
+    
+}
 
 void clean() {
 
@@ -49,6 +88,14 @@ void clean() {
 	for (size_t i = 0; i < shaders.size(); i++)
 		shaders[i].remove();
     
+    // Stop loading and delete the objects, skyboxes and per frame data while the context is alive.
+    async_loader.stop();
+    objects.clear();
+    skyboxes.clear();
+    frame_ubo.remove();
+    bgq_opengl::Geometry::getDrawBuffer().remove();
+    offscreen.remove();
+    
     // Terminate ImGUI.
     ImGui_ImplGlfwGL3_Shutdown();
     
@@ -62,21 +109,39 @@ void clear() {
     // Specify the color of the background
     glClearColor(background.x, background.y, background.z, background.w);
 
-    // Clean the back buffer and depth buffer
+    // Clean the back buffer and depth buffer. The background is already in
+    // display colors, so it skips the sRGB encoding.
+    if (bgq_opengl::Shader::getSRGBFramebuffer())
+        glDisable(GL_FRAMEBUFFER_SRGB);
+
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+    if (bgq_opengl::Shader::getSRGBFramebuffer())
+        glEnable(GL_FRAMEBUFFER_SRGB);
     
 }
 
 void displayElements() {
     
     // Get the program internal time.
-    auto current_time = std::chrono::system_clock::now();
-    double real_time = std::chrono::duration<double>(current_time.time_since_epoch()).count();
-    internal_time = real_time - time_start;
+    // Headless runs step it by frame instead, so the same frame always looks the same.
+    if (headless) {
+        
+        internal_time = frames_rendered / HEADLESS_FPS;
+        
+    } else {
+        
+        auto current_time = std::chrono::system_clock::now();
+        double real_time = std::chrono::duration<double>(current_time.time_since_epoch()).count();
+        internal_time = real_time - time_start;
+        
+    }
     
-    // Pass the parameters to the shaders.
-    shaders[current_shader].activate();
-    shaders[current_shader].passLight(scene_light);
+    // Keep the counters of the last frame and start again.
+    // ImGUI changes the bindings without telling, so they have to be forgotten too.
+    frame_gl_stats = bgq_opengl::GLState::getStats();
+    bgq_opengl::GLState::resetStats();
+    bgq_opengl::GLState::invalidate();
     
     // Choose the scene.
     if (current_scene == 0) {
@@ -84,6 +149,9 @@ void displayElements() {
         // Print all the objects.
         for (int i = 0; i < objects.size(); i++) {
             
+            // View the geometries in place instead of copying them.
+            std::span<bgq_opengl::Geometry> geometries = objects[i].getGeometries();
+            
             // Get info from the model.
             bgq_opengl::BoundingBox bb = objects[i].getBoundingBox();
             glm::vec3 centre = (bb.min + bb.max) / 2.0f;
@@ -118,7 +186,7 @@ void displayElements() {
             
             // Do the same but for the propeller.
             int propeller_ind = 0;
-            bgq_opengl::BoundingBox bb_propeller = objects[i].getGeometries()[propeller_ind].getBoundingBox();
+            bgq_opengl::BoundingBox bb_propeller = geometries[propeller_ind].getBoundingBox();
             glm::vec3 centre_propeller = (bb_propeller.min + bb_propeller.max) / 2.0f;
             
             // bring it back to its original position.
@@ -131,29 +199,6 @@ void displayElements() {
             // Center the object and get it in the right position.
             objects[i].translate(propeller_ind, -centre_propeller.x, -centre_propeller.y, -centre_propeller.z);
             
-            // Pass variables to the shaders.
-            shaders[current_shader].activate();
-            shaders[current_shader].passFloat("etaR", 1.0f);
-            shaders[current_shader].passFloat("etaG", 1.0f);
-            shaders[current_shader].passFloat("etaB", 1.0f);
-            shaders[current_shader].passFloat("fresnelPower", 0.0f);
-            shaders[current_shader].passFloat("mixColor", 0.2f);
-            shaders[current_shader].passFloat("lightPower", 10.0f);
-            shaders[current_shader].passFloat("minAmbientLight", 0.5f);
-            shaders[current_shader].passFloat("materialShininess", 0.5f);
-            
-            // Pass the textures.
-            bgq_opengl::Cubemap skycubemap = skyboxes[0].getCubemap();
-            skycubemap.bind();
-            shaders[current_shader].passCubemap(skycubemap);
-            
-            // Draw the object.
-            objects[i].getGeometries()[0].draw(shaders[current_shader], cameras[current_camera]);
-            objects[i].getGeometries()[1].draw(shaders[current_shader], cameras[current_camera]);
-            
-            shaders[current_shader].passFloat("mixColor", 0.6f);
-            objects[i].getGeometries()[2].draw(shaders[current_shader], cameras[current_camera]);
-
         }
         
     } else if (current_scene == 1) {
@@ -161,6 +206,9 @@ void displayElements() {
         // Print all the objects.
         for (int i = 0; i < objects.size(); i++) {
             
+            // View the geometries in place instead of copying them.
+            std::span<bgq_opengl::Geometry> geometries = objects[i].getGeometries();
+            
             // Get info from the model.
             bgq_opengl::BoundingBox bb = objects[i].getBoundingBox();
             glm::vec3 centre = (bb.min + bb.max) / 2.0f;
@@ -210,7 +258,7 @@ void displayElements() {
             
             // Do the same but for the propeller.
             int propeller_ind = 0;
-            bgq_opengl::BoundingBox bb_propeller = objects[i].getGeometries()[propeller_ind].getBoundingBox();
+            bgq_opengl::BoundingBox bb_propeller = geometries[propeller_ind].getBoundingBox();
             glm::vec3 centre_propeller = (bb_propeller.min + bb_propeller.max) / 2.0f;
             
             // bring it back to its original position.
@@ -223,29 +271,6 @@ void displayElements() {
             // Center the object and get it in the right position.
             objects[i].translate(propeller_ind, -centre_propeller.x, -centre_propeller.y, -centre_propeller.z);
             
-            // Pass variables to the shaders.
-            shaders[current_shader].activate();
-            shaders[current_shader].passFloat("etaR", 1.0f);
-            shaders[current_shader].passFloat("etaG", 1.0f);
-            shaders[current_shader].passFloat("etaB", 1.0f);
-            shaders[current_shader].passFloat("fresnelPower", 0.0f);
-            shaders[current_shader].passFloat("mixColor", 0.2f);
-            shaders[current_shader].passFloat("lightPower", 10.0f);
-            shaders[current_shader].passFloat("minAmbientLight", 0.5f);
-            shaders[current_shader].passFloat("materialShininess", 0.5f);
-            
-            // Pass the textures.
-            bgq_opengl::Cubemap skycubemap = skyboxes[0].getCubemap();
-            skycubemap.bind();
-            shaders[current_shader].passCubemap(skycubemap);
-            
-            // Draw the object.
-            objects[i].getGeometries()[0].draw(shaders[current_shader], cameras[current_camera]);
-            objects[i].getGeometries()[1].draw(shaders[current_shader], cameras[current_camera]);
-            
-            shaders[current_shader].passFloat("mixColor", 0.6f);
-            objects[i].getGeometries()[2].draw(shaders[current_shader], cameras[current_camera]);
-
         }
 
     } else if (current_scene == 2) {
@@ -253,6 +278,9 @@ void displayElements() {
         // Print all the objects.
         for (int i = 0; i < objects.size(); i++) {
             
+            // View the geometries in place instead of copying them.
+            std::span<bgq_opengl::Geometry> geometries = objects[i].getGeometries();
+            
             // Get info from the model.
             bgq_opengl::BoundingBox bb = objects[i].getBoundingBox();
             glm::vec3 centre = (bb.min + bb.max) / 2.0f;
@@ -292,7 +320,7 @@ void displayElements() {
             
             // Do the same but for the propeller.
             int propeller_ind = 0;
-            bgq_opengl::BoundingBox bb_propeller = objects[i].getGeometries()[propeller_ind].getBoundingBox();
+            bgq_opengl::BoundingBox bb_propeller = geometries[propeller_ind].getBoundingBox();
             glm::vec3 centre_propeller = (bb_propeller.min + bb_propeller.max) / 2.0f;
             
             // bring it back to its original position.
@@ -305,35 +333,29 @@ void displayElements() {
             // Center the object and get it in the right position.
             objects[i].translate(propeller_ind, -centre_propeller.x, -centre_propeller.y, -centre_propeller.z);
             
-            // Pass variables to the shaders.
-            shaders[current_shader].activate();
-            shaders[current_shader].passFloat("etaR", 1.0f);
-            shaders[current_shader].passFloat("etaG", 1.0f);
-            shaders[current_shader].passFloat("etaB", 1.0f);
-            shaders[current_shader].passFloat("fresnelPower", 0.0f);
-            shaders[current_shader].passFloat("mixColor", 0.2f);
-            shaders[current_shader].passFloat("lightPower", 10.0f);
-            shaders[current_shader].passFloat("minAmbientLight", 0.5f);
-            shaders[current_shader].passFloat("materialShininess", 0.5f);
-            
-            // Pass the textures.
-            bgq_opengl::Cubemap skycubemap = skyboxes[0].getCubemap();
-            skycubemap.bind();
-            shaders[current_shader].passCubemap(skycubemap);
-            
-            // Draw the object.
-            objects[i].getGeometries()[0].draw(shaders[current_shader], cameras[current_camera]);
-            objects[i].getGeometries()[1].draw(shaders[current_shader], cameras[current_camera]);
-            
-            shaders[current_shader].passFloat("mixColor", 0.6f);
-            objects[i].getGeometries()[2].draw(shaders[current_shader], cameras[current_camera]);
-
         }
 
     }
     
-    // Print the skybox.
-    skyboxes[0].draw(shaders[1], cameras[current_camera]);
+    // Activate the shader. The materials are set in the geometries.
+    shaders[current_shader].activate();
+    
+    // The camera may have moved, so upload the frame data if it changed.
+    updateFrameData();
+    
+    // Pass the textures.
+    bgq_opengl::Cubemap &skycubemap = skyboxes[0].getCubemap();
+    skycubemap.bind();
+    shaders[current_shader].passCubemap(skycubemap);
+    
+    // Draw the geometries the camera can see, placeholders included.
+    drawVisible();
+    
+    // Print the skybox. The Frame block is still bound from above.
+    skyboxes[0].draw(shaders[1]);
+    
+    // Every draw reading the draw data of this frame is issued, so fence it.
+    bgq_opengl::Geometry::getDrawBuffer().endFrame();
         
 }
 
@@ -385,10 +407,92 @@ void displayGUI() {
     ImGui::Text("Other parameters");
     ImGui::SliderFloat("Propeller RPM", &propeller_rpm, 0.0, 20.0 * 60);
     
+    // Pick how coarse the distant models can get.
+    if (ImGui::SliderFloat("LOD error (px)", &lod_threshold, 0.0, 8.0))
+        bgq_opengl::Geometry::setLODThreshold(lod_threshold);
+    
+    // Show how many state changes reached OpenGL in the last frame.
+    ImGui::Text("GL calls issued: %u", frame_gl_stats.issued);
+    ImGui::Text("GL calls elided: %u", frame_gl_stats.elided);
+    ImGui::Text("Inactive uniforms skipped: %u", frame_gl_stats.inactive);
+    
+    // Show how much was drawn in the last frame.
+    ImGui::Text("Draw calls: %u", frame_gl_stats.draws);
+    ImGui::Text("Triangles: %u", frame_gl_stats.triangles);
+    ImGui::Text("Shader variants: %zu", shaders[0].getVariantCount());
+    
+    // Show what the frustum culling saved.
+    ImGui::Checkbox("Frustum culling", &frustum_culling);
+    ImGui::Text("Culling: %u tested, %u culled, %u drawn", frame_cull_stats.tested, frame_cull_stats.culled, frame_cull_stats.drawn);
+    
+    // Show what is still loading.
+    size_t loading = async_loader.getPendingCount();
+    if (loading > 0)
+        ImGui::Text("Loading: %zu tasks left", loading);
+    
+    // Show how many textures were reused instead of loaded again.
+    bgq_opengl::CacheStats texture_stats = bgq_opengl::Texture::getCacheStats();
+    ImGui::Text("Texture cache hits: %u", texture_stats.hits);
+    ImGui::Text("Texture cache misses: %u", texture_stats.misses);
+    
+    // Show how long the skybox took to load.
+    double skybox_time = bgq_opengl::Cubemap::getLastLoadTime();
+    if (skybox_time > 0.0)
+        ImGui::Text("Skybox load: %.1f ms", skybox_time);
+    
     ImGui::End();
     
-    // Render ImGUI.
+    // Render ImGUI. Its colors are already in display colors too.
+    if (bgq_opengl::Shader::getSRGBFramebuffer())
+        glDisable(GL_FRAMEBUFFER_SRGB);
+
     ImGui::Render();
+
+    if (bgq_opengl::Shader::getSRGBFramebuffer())
+        glEnable(GL_FRAMEBUFFER_SRGB);
+    
+}
+
+void drawVisible() {
+    
+    // Gather every geometry with its box in the world.
+    scene_geometries.clear();
+    scene_boxes.clear();
+    for (size_t i = 0; i < objects.size(); i++) {
+        
+        for (bgq_opengl::Geometry &geometry : objects[i].getGeometries()) {
+            
+            scene_geometries.push_back(&geometry);
+            scene_boxes.push_back(geometry.getWorldBoundingBox());
+            
+        }
+        
+    }
+    
+    // Keep the ones that are not fully outside the camera.
+    visible_geometries.clear();
+    frame_cull_stats = bgq_opengl::CullStats();
+    
+    if (frustum_culling) {
+        
+        scene_bvh.update(scene_boxes);
+        scene_bvh.cull(bgq_opengl::Frustum(cameras[current_camera].getCameraMatrix()), visible_geometries, &frame_cull_stats);
+        
+    } else {
+        
+        for (size_t i = 0; i < scene_geometries.size(); i++)
+            visible_geometries.push_back(i);
+        frame_cull_stats.drawn = (unsigned int) scene_geometries.size();
+        
+    }
+    
+    // Queue them and draw them sorted by state, the transparent ones last.
+    render_queue.clear();
+    for (size_t index : visible_geometries)
+        render_queue.push(*scene_geometries[index], shaders[current_shader], cameras[current_camera]);
+    
+    render_queue.sort();
+    render_queue.submit(shaders[current_shader], cameras[current_camera]);
     
 }
 
@@ -485,14 +589,17 @@ void initElements() {
 	// Create a white light in the center of the world.
     scene_light = bgq_opengl::Light(glm::vec3(2.0f, 8.0, 2.0f), glm::vec4(1.0f, 1.0f, 1.0f, 1.0f));
 
+    // Create the buffer for the per frame data shared by all the shaders.
+    frame_ubo = bgq_opengl::UBO(sizeof(bgq_opengl::FrameData), bgq_opengl::FrameData::binding);
+    
 	// Get the shaders.
 	bgq_opengl::Shader blinn_phong("blinnPhongFresnel.vert", "blinnPhongFresnel.frag");
     shaders.push_back(blinn_phong);
 
 	// Creates the first camera object
-    bgq_opengl::Camera camera(glm::vec3(1.0f, 0.5f, 1.0f), glm::vec3(-1.0f, -0.5f, -1.0f), 45.0f, 0.1f, 300.0f, WINDOW_WIDTH, WINDOW_HEIGHT);
+    bgq_opengl::Camera camera(glm::vec3(1.0f, 0.5f, 1.0f), glm::vec3(-1.0f, -0.5f, -1.0f), 45.0f, 0.1f, 300.0f, render_width, render_height);
 	cameras.push_back(camera);
-    bgq_opengl::Camera first_person(glm::vec3(0.0f, 0.0f, -1.5f), glm::vec3(0.0f, 0.0f, 1.0f), 45.0f, 0.1f, 300.0f, WINDOW_WIDTH, WINDOW_HEIGHT);
+    bgq_opengl::Camera first_person(glm::vec3(0.0f, 0.0f, -1.5f), glm::vec3(0.0f, 0.0f, 1.0f), 45.0f, 0.1f, 300.0f, render_width, render_height);
     cameras.push_back(first_person);
     
     // Load the skyboxes.
@@ -506,25 +613,69 @@ void initElements() {
     };
     
     // Load the textures.
-    bgq_opengl::Cubemap skycubemap(faces, "skybox", 1);
+    bgq_opengl::Cubemap skycubemap(faces, "skybox", 1, async_loader);
     bgq_opengl::Skybox skybox(skycubemap);
-    skyboxes.push_back(skybox);
+    skyboxes.push_back(std::move(skybox));
     
     bgq_opengl::Shader sky_shader("skybox.vert", "skybox.frag");
     shaders.push_back(sky_shader);
     
-    // Load the objects.
-    bgq_opengl::Object plane("Plane.dae", "Assimp");
+    // Load the objects in the background. They show a placeholder meanwhile.
+    bgq_opengl::Object plane("Plane.dae", "Assimp", async_loader);
     plane.addTexture(0, "Red.jpg", "baseColor");
     plane.addTexture(1, "Red.jpg", "baseColor");
     plane.addTexture(2, "Window.png", "baseColor");
-    plane.setShininess(200.0);
-    objects.push_back(plane);
+    
+    // A squadron flies with it. Every plane is an instance of the same
+    // model, so each geometry takes one call for all of them.
+    bgq_opengl::Object squadron("Plane.dae", "Assimp", async_loader);
+    squadron.addTexture(0, "Red.jpg", "baseColor");
+    squadron.addTexture(1, "Red.jpg", "baseColor");
+    squadron.addTexture(2, "Window.png", "baseColor");
+    
+    std::vector<bgq_opengl::InstanceData> wingmen(4);
+    wingmen[0].model = glm::translate(glm::mat4(1.0f), glm::vec3(-1.5f, 0.2f, -1.5f));
+    wingmen[1].model = glm::translate(glm::mat4(1.0f), glm::vec3(1.5f, 0.2f, -1.5f));
+    wingmen[2].model = glm::translate(glm::mat4(1.0f), glm::vec3(-3.0f, 0.4f, -3.0f));
+    wingmen[3].model = glm::translate(glm::mat4(1.0f), glm::vec3(3.0f, 0.4f, -3.0f));
+    squadron.setInstances(wingmen);
+    
+    // Set the materials. The window mixes more of the fresnel color and lets
+    // some of what is behind it through.
+    bgq_opengl::MaterialData plane_material;
+    plane_material.mix_color = 0.2f;
+    plane_material.shininess = 200.0f;
+    plane.setMaterial(plane_material);
+    squadron.setMaterial(plane_material);
+    plane_material.mix_color = 0.6f;
+    plane_material.color.a = 0.7f;
+    plane.setMaterial(2, plane_material);
+    squadron.setMaterial(2, plane_material);
+    objects.push_back(std::move(plane));
+    objects.push_back(std::move(squadron));
     
 }
 
 void initEnvironment(int argc, char** argv) {
     
+    // Read the options first, as they change how the window is made.
+    parseArguments(argc, argv);
+    
+    // The kernel benchmark needs no window, so run it and leave.
+    if (bench_aabb) {
+        
+        bgq_opengl::AABBKernel::benchmark();
+        exit(0);
+        
+    }
+    
+#if defined(__linux__) && defined(GLFW_PLATFORM_NULL)
+    // Without a display, use no window system at all and render through OSMesa.
+    bool surfaceless = headless && !getenv("DISPLAY") && !getenv("WAYLAND_DISPLAY");
+    if (surfaceless)
+        glfwInitHint(GLFW_PLATFORM, GLFW_PLATFORM_NULL);
+#endif
+    
     // start GL context and O/S window using the GLFW helper library
     if (!glfwInit()) {
         
@@ -539,8 +690,20 @@ void initEnvironment(int argc, char** argv) {
     glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
     glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
     
+    // Ask for a window that can encode to sRGB, so the shaders do not have to.
+    glfwWindowHint(GLFW_SRGB_CAPABLE, GL_TRUE);
+    
+    // Headless runs keep the window hidden, as they draw to a framebuffer of their own.
+    if (headless)
+        glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+    
+#if defined(__linux__) && defined(GLFW_PLATFORM_NULL)
+    if (surfaceless)
+        glfwWindowHint(GLFW_CONTEXT_CREATION_API, GLFW_OSMESA_CONTEXT_API);
+#endif
+    
     // Create the window.
-    window = glfwCreateWindow(WINDOW_WIDTH, WINDOW_HEIGHT, GAME_NAME, NULL, NULL);
+    window = glfwCreateWindow(render_width, render_height, GAME_NAME, NULL, NULL);
     if (!window) {
         
         std::cerr << "Error 121-1001 - Failed to create the window." << std::endl;
@@ -552,6 +715,12 @@ void initEnvironment(int argc, char** argv) {
     
     // Initialize GLEW and OpenGL.
     GLenum res = glewInit();
+    
+#ifdef GLEW_ERROR_NO_GLX_DISPLAY
+    // Without an X display GLEW cannot load GLX, but the OpenGL functions are loaded by then.
+    if (headless && res == GLEW_ERROR_NO_GLX_DISPLAY)
+        res = GLEW_OK;
+#endif
 
     // Check for any errors.
     if (res != GLEW_OK) {
@@ -573,38 +742,240 @@ void initEnvironment(int argc, char** argv) {
     glEnable(GL_DEPTH_TEST); // enable depth-testing
     glDepthFunc(GL_LESS); // depth-testing interprets a smaller value as "closer"
     
+    // Draw to the offscreen framebuffer from now on. Nothing else binds one.
+    if (headless) {
+        
+        offscreen = bgq_opengl::FBO(render_width, render_height);
+        offscreen.bind();
+        
+    }
+    
+    // Let the framebuffer apply the gamma if it stores sRGB. The shaders do it otherwise.
+    GLint encoding = GL_LINEAR;
+    glGetFramebufferAttachmentParameteriv(GL_FRAMEBUFFER, headless ? GL_COLOR_ATTACHMENT0 : GL_BACK_LEFT,
+                                          GL_FRAMEBUFFER_ATTACHMENT_COLOR_ENCODING, &encoding);
+    if (encoding == GL_SRGB) {
+        
+        glEnable(GL_FRAMEBUFFER_SRGB);
+        bgq_opengl::Shader::setSRGBFramebuffer(true);
+        
+    }
+    
     // Init the initial time.
     auto current_time = std::chrono::system_clock::now();
     time_start = std::chrono::duration<double>(current_time.time_since_epoch()).count();
 
 }
 
+bool isRunOver() {
+    
+    if (glfwWindowShouldClose(window))
+        return true;
+    
+    if (max_frames > 0 && frames_rendered >= max_frames)
+        return true;
+    
+    // Check the time only if there is a limit.
+    if (max_seconds > 0.0) {
+        
+        auto current_time = std::chrono::system_clock::now();
+        double real_time = std::chrono::duration<double>(current_time.time_since_epoch()).count();
+        if (real_time - run_start >= max_seconds)
+            return true;
+        
+    }
+    
+    return false;
+    
+}
+
+void parseArguments(int argc, char** argv) {
+    
+    for (int i = 1; i < argc; i++) {
+        
+        // Every option but --headless and --bench-aabb takes a value.
+        bool has_value = i + 1 < argc;
+        
+        if (strcmp(argv[i], "--headless") == 0) {
+            
+            headless = true;
+            
+        } else if (strcmp(argv[i], "--bench-aabb") == 0) {
+            
+            bench_aabb = true;
+            
+        } else if (strcmp(argv[i], "--bench-cubemap") == 0 && has_value) {
+            
+            bench_cubemaps.push_back(argv[++i]);
+            
+        } else if (strcmp(argv[i], "--size") == 0 && has_value) {
+            
+            if (sscanf(argv[++i], "%dx%d", &render_width, &render_height) != 2 || render_width <= 0 || render_height <= 0) {
+                
+                std::cerr << "The size must be like 1920x1080, not " << argv[i] << std::endl;
+                exit(1);
+                
+            }
+            
+        } else if (strcmp(argv[i], "--frames") == 0 && has_value) {
+            
+            max_frames = atoi(argv[++i]);
+            
+        } else if (strcmp(argv[i], "--seconds") == 0 && has_value) {
+            
+            max_seconds = atof(argv[++i]);
+            
+        } else if (strcmp(argv[i], "--capture") == 0 && has_value) {
+            
+            capture_prefix = argv[++i];
+            
+        } else if (strcmp(argv[i], "--capture-every") == 0 && has_value) {
+            
+            capture_every = std::max(1, atoi(argv[++i]));
+            
+        } else {
+            
+            std::cerr << "Unknown option " << argv[i] << std::endl;
+            std::cerr << "Usage: " << argv[0] << " [--headless] [--size WxH] [--frames N] [--seconds S] [--capture PREFIX] [--capture-every N] [--bench-aabb] [--bench-cubemap DIR]..." << std::endl;
+            exit(1);
+            
+        }
+        
+    }
+    
+    // The cubemap benchmark draws nothing, so keep its window hidden.
+    if (!bench_cubemaps.empty())
+        headless = true;
+    
+    // A headless run with no limits would never end, so render a single frame.
+    if (headless && max_frames <= 0 && max_seconds <= 0.0)
+        max_frames = 1;
+    
+}
+
+void updateLoading() {
+    
+    // Upload what the workers finished, within the budget of this frame.
+    async_loader.processUploads(UPLOAD_BUDGET_MS);
+    
+    // Swap the placeholders for the models that are complete.
+    for (size_t i = 0; i < objects.size(); i++)
+        objects[i].update();
+    
+}
+
+void updateFrameData() {
+    
+    // Get the current camera.
+    bgq_opengl::Camera &camera = cameras[current_camera];
+    
+    // Skip it if neither the camera nor the light changed since the last upload.
+    glm::vec4 light_color = scene_light.getColor();
+    glm::vec3 light_position = scene_light.getPosition();
+    if (&camera == frame_camera && camera.getVersion() == frame_camera_version
+        && light_color == frame_light_color && light_position == frame_light_position) {
+        
+        frame_ubo.bind();
+        return;
+        
+    }
+    
+    // Remember what was uploaded.
+    frame_camera = &camera;
+    frame_camera_version = camera.getVersion();
+    frame_light_color = light_color;
+    frame_light_position = light_position;
+    
+    // Get the matrices of the camera.
+    bgq_opengl::FrameData frame_data;
+    frame_data.view = camera.getView();
+    frame_data.projection = camera.getProjection();
+    frame_data.view_projection = camera.getCameraMatrix();
+    
+    // The light goes in view space, as the lighting is computed there.
+    frame_data.light_color = light_color;
+    frame_data.light_position = glm::vec3(frame_data.view * glm::vec4(light_position, 1.0f));
+    frame_data.light_power = 10.0f;
+    frame_data.camera_position = camera.getPosition();
+    frame_data.min_ambient_light = 0.5f;
+    
+    // Upload it and bind it for every shader.
+    frame_ubo.update(&frame_data, sizeof(bgq_opengl::FrameData));
+    frame_ubo.bind();
+    
+}
+
 int main(int argc, char** argv) {
 
 	// Initialise the environment.
     initEnvironment(argc, argv);
     
+    // Time the skybox loads instead of running, if asked.
+    if (!bench_cubemaps.empty()) {
+        
+        bgq_opengl::Cubemap::benchmark(bench_cubemaps);
+        clean();
+        return 0;
+        
+    }
+    
 	// Initialise the objects and elements.
 	initElements();
+    
+    // Headless runs wait for every model and texture, so no frame shows a placeholder.
+    if (headless) {
+        
+        while (async_loader.getPendingCount() > 0) {
+            
+            updateLoading();
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            
+        }
+        updateLoading();
+        
+    }
+    
+    auto start_time = std::chrono::system_clock::now();
+    run_start = std::chrono::duration<double>(start_time.time_since_epoch()).count();
 
 	// Main loop.
-    while(!glfwWindowShouldClose(window)) {
+    while(!isRunOver()) {
         
         // Clear the scene.
         clear();
         
-        // Handle key events.
-        handleKeyEvents();
+        // Handle key events. There are none without a visible window.
+        if (!headless)
+            handleKeyEvents();
+        
+        // Bring in what finished loading.
+        updateLoading();
         
         // Display the scene.
         displayElements();
         
-        // Make the things to print everything.
-        displayGUI();
+        // Make the things to print everything, or keep the frame if asked.
+        if (!headless)
+            displayGUI();
+        else if (!capture_prefix.empty() && frames_rendered % capture_every == 0)
+            captureFrame();
+        
+        frames_rendered++;
         
         // Update other events like input handling.
         glfwPollEvents();
-        glfwSwapBuffers(window);
+        if (!headless)
+            glfwSwapBuffers(window);
+        
+    }
+    
+    // Report how long the frames took, once the GPU is done with them.
+    if (headless) {
+        
+        glFinish();
+        auto end_time = std::chrono::system_clock::now();
+        double elapsed = std::chrono::duration<double>(end_time.time_since_epoch()).count() - run_start;
+        std::cerr << "Rendered " << frames_rendered << " frames of " << render_width << "x" << render_height << " in " << elapsed << " s (" << (frames_rendered > 0 ? 1000.0 * elapsed / frames_rendered : 0.0) << " ms per frame)" << std::endl;
         
     }
 
@@ -20,20 +20,33 @@
 #define WINDOW_HEIGHT 800
 #define GAME_NAME "Real-time animation"
 #define NORM_SIZE 1.0
+#define UPLOAD_BUDGET_MS 4.0
+#define HEADLESS_FPS 60.0
 
 #include <vector>
 #include <string>
 #include <ctime>
+#include <cstdint>
 
 #include "GL/glew.h"
 #include "GLFW/glfw3.h"
 
+#include "classes/async_loader/async_loader.h"
+#include "classes/bvh/bvh.h"
 #include "classes/camera/camera.h"
+#include "classes/fbo/fbo.h"
+#include "classes/gl_state/gl_state.h"
+#include "classes/light/light.h"
 #include "classes/object/object.h"
+#include "classes/render_queue/render_queue.h"
 #include "classes/shader/shader.h"
 #include "classes/skybox/skybox.h"
 #include "classes/texture/texture.h"
 #include "classes/turbulence/turbulence.h"
+#include "classes/ubo/ubo.h"
+#include "structs/bounding_box/bounding_box.h"
+#include "structs/cull_stats/cull_stats.h"
+#include "structs/state_stats/state_stats.h"
 
 std::vector<bgq_opengl::Camera> cameras;	/// Holds all the existing cameras.
 std::vector<bgq_opengl::Object> objects;	/// Holds all the displayed objects.
@@ -50,11 +63,46 @@ float pitching = 0.0;
 float rolling = 0.0;
 float yawing = 0.0;
 float propeller_rpm = 5 * 60;
+float lod_threshold = 1.0;                  /// Largest error a level of detail may show, in pixels.
 bgq_opengl::Turbulence *turbulence_pitching;
 bgq_opengl::Turbulence *turbulence_rolling;
+bgq_opengl::UBO frame_ubo;                  /// Per frame camera and light data shared by the shaders.
+const bgq_opengl::Camera *frame_camera = nullptr; /// Camera the frame data was built from.
+uint64_t frame_camera_version = 0;          /// Version of that camera when it was built.
+glm::vec4 frame_light_color;                /// Light color when it was built.
+glm::vec3 frame_light_position;             /// Light position when it was built.
+bgq_opengl::StateStats frame_gl_stats;      /// GL state changes, draws and triangles of the last frame.
+bgq_opengl::AsyncLoader async_loader;       /// Reads models and images off the render thread.
+bgq_opengl::BVH scene_bvh;                  /// Tree over the world boxes of every geometry.
+std::vector<bgq_opengl::Geometry*> scene_geometries;    /// Geometries of every object, in the order of the tree items.
+std::vector<bgq_opengl::BoundingBox> scene_boxes;       /// World box of each of those geometries.
+std::vector<size_t> visible_geometries;     /// Indices of the geometries the camera sees.
+bgq_opengl::CullStats frame_cull_stats;     /// Boxes tested and geometries culled and drawn in the last frame.
+bool frustum_culling = true;                /// Skip the geometries outside the camera.
+bgq_opengl::RenderQueue render_queue;       /// Draws of the frame, sorted by state.
+bool headless = false;                      /// Render off the screen, with no visible window.
+int render_width = WINDOW_WIDTH;            /// Width of the window or the offscreen image.
+int render_height = WINDOW_HEIGHT;          /// Height of the window or the offscreen image.
+int max_frames = 0;                         /// Frames to render before quitting. 0 for no limit.
+double max_seconds = 0.0;                   /// Seconds to run before quitting. 0 for no limit.
+std::string capture_prefix;                 /// Prefix of the captured frames. Empty for none.
+int capture_every = 1;                      /// Capture one every this many frames.
+int frames_rendered = 0;                    /// Frames rendered so far.
+double run_start = 0.0;                     /// Time the main loop started.
+bgq_opengl::FBO offscreen;                  /// Framebuffer drawn to when headless.
+bool bench_aabb = false;                    /// Run the bounding box kernel benchmark and quit.
+std::vector<std::string> bench_cubemaps;    /// Face sets to time the loads of, then quit. Empty to run.
 
 const glm::vec4 background(82 / 255.0, 103 / 255.0, 125 / 255.0, 1.0);	/// This is just the fog color.
 
+/**
+ * @brief Capture the offscreen frame.
+ *
+ * Read the offscreen framebuffer back and write it as a binary PPM image named
+ * after the capture prefix and the frame number.
+ */
+void captureFrame();
+
 /**
  * @brief Clean everything to end the program.
  *
@@ -83,6 +131,15 @@ void displayElements();
  */
 void displayGUI();
 
+/**
+ * @brief Draw the visible geometries.
+ *
+ * Refit the tree to the world boxes of the geometries of every object, test it
+ * against the frustum of the current camera and draw what is not fully outside
+ * through the render queue.
+ */
+void drawVisible();
+
 /**
  * @brief Handles the key events.
  *
@@ -104,6 +161,48 @@ void initElements();
  */
 void initEnvironment(int argc, char** argv);
 
+/**
+ * @brief Check if the run is over.
+ *
+ * Check if the window was closed or the frame or time limits were reached.
+ *
+ * @returns True if the main loop has to stop.
+ */
+bool isRunOver();
+
+/**
+ * @brief Parse the command line.
+ *
+ * Read the options of the command line. Exits with the usage on a wrong one.
+ *
+ *   --headless         Render off the screen with a hidden window.
+ *   --size WxH         Size of the image. 1400x800 by default.
+ *   --frames N         Frames to render. 1 by default when headless.
+ *   --seconds S        Seconds to run.
+ *   --capture PREFIX   Write the frames as PREFIX_NNNNN.ppm when headless.
+ *   --capture-every N  Capture one every N frames.
+ *   --bench-aabb       Time the bounding box kernels and quit.
+ *   --bench-cubemap D  Time loading the six faces in the folder D and quit. Can be repeated.
+ */
+void parseArguments(int argc, char** argv);
+
+/**
+ * @brief Bring in what finished loading.
+ *
+ * Run the uploads of the background loader within the budget of a frame and
+ * swap the placeholders of the objects whose model is complete.
+ */
+void updateLoading();
+
+/**
+ * @brief Upload the per frame data.
+ *
+ * Fill the Frame block with the current camera and light and upload it. It
+ * does nothing but bind it if the camera version and the light are the same as
+ * in the last upload, so it can be called before every group of draws.
+ */
+void updateFrameData();
+
 /**
  * @brief Main function.
  * 
@@ -4,25 +4,44 @@ in vec3 vertexPosition;             // Position from the VS.
 in vec3 vertexNormal;               // Normal from the VS.
 in vec3 vertexColor;                // Color from the VS.
 in vec2 vertexUV;                   // UV coordinates from the VS.
+
+// The features are defined by the Shader class. Each one left out saves its
+// lookups and math for materials that would not show it.
+#ifdef USE_ENVIRONMENT
 in vec3 Reflect;                    // The reflect color.
-in vec3 RefractR;                   // The refracttion of the red channel.
+#endif
+#ifdef USE_REFRACTION
 in vec3 RefractG;                   // The refracttion of the green channel.
-in vec3 RefractB;                   // The refracttion of the blue channel.
 in float Ratio;                     // The reflection refraction ratio.
-
-uniform vec4 lightColor;            // Light color.
-uniform vec3 lightPos;              // Light position.
-uniform vec3 cameraPosition;        // Position of the camera.
-uniform float materialShininess;    // Extra shininess.
-uniform float etaR;                 // Fresnel red ratio.
-uniform float etaG;                 // Fresnel green ratio.
-uniform float etaB;                 // Fresnel blue ratio.
-uniform float fresnelPower;         // The fresnel interpolation step.
-uniform float mixColor;             // The color/fresnel ratio.
-uniform sampler2D baseColor;        // The color texture.
-uniform samplerCube skybox;         // The skybox.
-uniform float minAmbientLight;      // The minimum ambient that will control ambient light.
-uniform float lightPower;           // The power that light has to light up the scene.
+#endif
+#ifdef USE_DISPERSION
+in vec3 RefractR;                   // The refracttion of the red channel.
+in vec3 RefractB;                   // The refracttion of the blue channel.
+#endif
+
+layout (std140) uniform Frame {         // Data shared by every draw in the frame.
+    mat4 View;                          // The View matrix.
+    mat4 Projection;                    // The projection matrix.
+    mat4 viewProjection;                // Projection * View.
+    vec4 lightColor;                    // Light color.
+    vec3 lightPos;                      // Light position in view space.
+    float lightPower;                   // The power that light has to light up the scene.
+    vec3 cameraPosition;                // Position of the camera.
+    float minAmbientLight;              // The minimum ambient that will control ambient light.
+};
+
+layout (std140) uniform Material {      // Parameters of the material being drawn.
+    float etaR;                         // Fresnel red ratio.
+    float etaG;                         // Fresnel green ratio.
+    float etaB;                         // Fresnel blue ratio.
+    float fresnelPower;                 // The fresnel interpolation step.
+    float mixColor;                     // The color/fresnel ratio.
+    float materialShininess;            // Extra shininess.
+    vec4 diffuseColor;                  // Diffuse color, applied over the vertex colors.
+};
+
+uniform sampler2D baseColor;            // The color texture.
+uniform samplerCube skybox;             // The skybox.
 
 const float screenGamma = 2.2;      // Used for gamma corrections.
 
@@ -30,20 +49,38 @@ out vec4 outColor;                  // Outputs color in RGBA.
 
 void main() {
     
-    // Get the base color from the texture.
+    // Get the base color from the texture, or from the material without one.
+#ifdef USE_TEXTURE
     vec4 textureColor = texture(baseColor, vertexUV);
-        
+#else
+    vec4 textureColor = vec4(vertexColor, 1.0);
+#endif
+
+    // See-through materials blend with the alpha of the color and the texture.
+    float opacity = textureColor.a * diffuseColor.a;
+
+#ifdef USE_ENVIRONMENT
+    // Get the reflected colors.
+    vec3 reflectColor = vec3(texture(skybox, Reflect));
+
+#ifdef USE_REFRACTION
     // Get the colors for the refraction from the skybox.
+#ifdef USE_DISPERSION
     vec3 refractColor = vec3(0.0, 0.0, 0.0);
     refractColor.r = vec3(texture(skybox, RefractR)).r;
     refractColor.g = vec3(texture(skybox, RefractG)).g;
     refractColor.b = vec3(texture(skybox, RefractB)).b;
-    
-    // Get the reflected colors.
-    vec3 reflectColor = vec3(texture(skybox, Reflect));
-    
+#else
+    vec3 refractColor = vec3(texture(skybox, RefractG));
+#endif
+
     // Get the final fresnel color after mixing both reflection and refraction.
     vec3 fresnelColor = mix(refractColor, reflectColor, Ratio);
+#else
+    // Without a fresnel power the ratio is 1, so it is all reflection.
+    vec3 fresnelColor = reflectColor;
+#endif
+#endif
     
     // Get the normal ready to use.
     vec3 normal = normalize(vertexNormal);
@@ -62,7 +99,11 @@ void main() {
     float lambertian = max(dot(lightDir, normal), 0.0);
     
     // Get the surface color after joining the texture and the fresnel.
+#ifdef USE_ENVIRONMENT
     vec4 surfaceColor = vec4(mix(textureColor.xyz, fresnelColor, mixColor), 1.0);
+#else
+    vec4 surfaceColor = vec4(textureColor.xyz, 1.0);
+#endif
 
     // Calculate the specular component.
     float specular = 0.0;
@@ -82,18 +123,20 @@ void main() {
     vec3 ambientColor = vec3(surfaceColor) * minAmbientLight;
 
     // Get the diffuse final color.
-    vec3 diffuseColor = vec3(surfaceColor) * lambertian * vec3(lightColor) * lightPower / dist;
+    vec3 diffuseTerm = vec3(surfaceColor) * lambertian * vec3(lightColor) * lightPower / dist;
 
     // Get the specular final color.
     vec3 specularColor = vec3(surfaceColor) * specular * vec3(lightColor) * lightPower / dist;
 
     // Get the final color that would go in the fragment.
-    vec3 fragmentColor = ambientColor + diffuseColor + specularColor;
+    vec3 fragmentColor = ambientColor + diffuseTerm + specularColor;
 
-    // Apply gamma correction.
+    // Apply gamma correction, unless the framebuffer does it.
+#ifdef USE_GAMMA
     fragmentColor = pow(fragmentColor, vec3(1.0 / screenGamma));
+#endif
 
     // Final color.
-    outColor = vec4(fragmentColor, 1.0);
+    outColor = vec4(fragmentColor, opacity);
     
 }
@@ -4,60 +4,118 @@ layout (location = 0) in vec3 inVertex; // Vertex.
 layout (location = 1) in vec3 inNormal; // Normal (not necessarily normalized).
 layout (location = 2) in vec3 inColor;  // Color (not necessarily normalized).
 layout (location = 3) in vec2 inUV;     // UV coordinates.
+layout (location = 5) in mat4 instanceModel;    // Per instance model matrix (locations 5 to 8).
+layout (location = 9) in float instancePhase;   // Per instance spin angle in degrees.
 
-uniform mat4 Model;                     // Imports the model matrix.
-uniform mat4 View;                      // Imports the View matrix.
-uniform mat4 Projection;                // Imports the projection matrix.
-uniform mat4 modelView;                 // Imports the modelView already multiplied.
-uniform mat4 normalMatrix;              // Imports the normal matrix.
-uniform vec3 cameraPosition;            // Position of the camera.
-uniform float etaR;                     // Fresnel red ratio.
-uniform float etaG;                     // Fresnel green ratio.
-uniform float etaB;                     // Fresnel blue ratio.
-uniform float fresnelPower;             // The fresnel interpolation step.
+layout (std140) uniform Frame {         // Data shared by every draw in the frame.
+    mat4 View;                          // The View matrix.
+    mat4 Projection;                    // The projection matrix.
+    mat4 viewProjection;                // Projection * View.
+    vec4 lightColor;                    // Light color.
+    vec3 lightPos;                      // Light position in view space.
+    float lightPower;                   // The power that light has to light up the scene.
+    vec3 cameraPosition;                // Position of the camera.
+    float minAmbientLight;              // The minimum ambient that will control ambient light.
+};
+
+layout (std140) uniform Material {      // Parameters of the material being drawn.
+    float etaR;                         // Fresnel red ratio.
+    float etaG;                         // Fresnel green ratio.
+    float etaB;                         // Fresnel blue ratio.
+    float fresnelPower;                 // The fresnel interpolation step.
+    float mixColor;                     // The color/fresnel ratio.
+    float materialShininess;            // Extra shininess.
+    vec4 diffuseColor;                  // Diffuse color, applied over the vertex colors.
+};
+
+layout (std140) uniform Draw {          // Data of the geometry being drawn.
+    mat4 Model;                         // The model matrix.
+    mat4 normalMatrix;                  // The normal matrix in world space.
+    vec4 spinPivot;                     // Point the instance phase spins the geometry around.
+    vec4 spinAxis;                      // Axis the instance phase spins the geometry around.
+};
 
 out vec3 vertexNormal;                  // Passes the normal to the fragment shader.
 out vec3 vertexColor;                   // Passes the color to the fragment shader.
 out vec2 vertexUV;                      // Passes the UV coordinates to the fragment shader.
 out vec3 vertexPosition;                // Passes the current vertex to the fragment shader.
 
+// The features are defined by the Shader class, as in the fragment shader.
+#ifdef USE_ENVIRONMENT
 out vec3 Reflect;                       // Passes the reflection texture coordinates to the fragment shader.
-out vec3 RefractR;                      // Passes the red refraction texture coordinates to the fragment shader.
+#endif
+#ifdef USE_REFRACTION
 out vec3 RefractG;                      // Passes the green refraction texture coordinates to the fragment shader.
-out vec3 RefractB;                      // Passes the blue refraction texture coordinates to the fragment shader.
 out float Ratio;                        // Passes the fresnel ratio to the fragment shader.
+#endif
+#ifdef USE_DISPERSION
+out vec3 RefractR;                      // Passes the red refraction texture coordinates to the fragment shader.
+out vec3 RefractB;                      // Passes the blue refraction texture coordinates to the fragment shader.
+#endif
+
+// Rotates a vector around an axis (Rodrigues' formula).
+vec3 spin(vec3 v, vec3 axis, float angle) {
+    
+    float c = cos(angle);
+    float s = sin(angle);
+    
+    return v * c + cross(axis, v) * s + axis * dot(axis, v) * (1.0 - c);
+    
+}
 
 void main() {
     
+    // Spin the vertex with the phase of this instance.
+    vec3 position = inVertex;
+    vec3 normal = inNormal;
+    if (instancePhase != 0.0 && dot(spinAxis.xyz, spinAxis.xyz) > 0.0) {
+        
+        vec3 axis = normalize(spinAxis.xyz);
+        float angle = radians(instancePhase);
+        position = spinPivot.xyz + spin(position - spinPivot.xyz, axis, angle);
+        normal = spin(normal, axis, angle);
+        
+    }
+    
+    // Get the modelView from the per frame View and the instance.
+    mat4 modelView = View * instanceModel * Model;
+    
     // Assigns the direct passes.
-    vertexNormal = vec3(normalMatrix * vec4(inNormal, 0.0));
-    vertexColor = inColor;
+    // The View and the instance have no shearing, so they can be applied to normals directly.
+    vertexNormal = mat3(View) * mat3(instanceModel) * mat3(normalMatrix) * normal;
+    vertexColor = inColor * diffuseColor.rgb;
     vertexUV = mat2(0.0, -1.0, 1.0, 0.0) * inUV;
-    vertexPosition = vec3(modelView * vec4(inVertex, 1.0));
+    vertexPosition = vec3(modelView * vec4(position, 1.0));
     
-    // Get the F component of the fresnel.
-    float F = ((1.0 - etaG) * (1.0 - etaG)) / ((1.0 + etaG) * (1.0 + etaG));
-
+#ifdef USE_ENVIRONMENT
     // Get the transformed position and normalize it.
-    vec4 ecPosition  = modelView * vec4(inVertex, 1.0);
+    vec4 ecPosition  = modelView * vec4(position, 1.0);
     vec3 ecPosition3 = ecPosition.xyz / ecPosition.w;
     
     // Get the other components of the fresnel.
     vec3 i = normalize(ecPosition3);
     vec3 n = normalize(vertexNormal);
 
+#ifdef USE_REFRACTION
+    // Get the F component of the fresnel.
+    float F = ((1.0 - etaG) * (1.0 - etaG)) / ((1.0 + etaG) * (1.0 + etaG));
+
     // Compute the fresnet equation.
     Ratio = F + (1.0 - F) * pow((1.0 - dot(-i, n)), fresnelPower);
     
-    RefractR = refract(i, n, etaR);
-    //RefractR = vec3(TextureMatrix * vec4(RefractR, 1.0));
     RefractG = refract(i, n, etaG);
     //RefractG = vec3(TextureMatrix * vec4(RefractG, 1.0));
+#ifdef USE_DISPERSION
+    RefractR = refract(i, n, etaR);
+    //RefractR = vec3(TextureMatrix * vec4(RefractR, 1.0));
     RefractB = refract(i, n, etaB);
     //RefractB = vec3(TextureMatrix * vec4(RefractB, 1.0));
+#endif
+#endif
     
     Reflect = reflect(i, n);
     //Reflect = vec3(TextureMatrix * vec4(Reflect, 1.0));
+#endif
     
     // Sets the visualized position by applying the camera matrix.
     gl_Position = Projection * vec4(vertexPosition, 1.0);
@@ -2,8 +2,16 @@
 
 layout (location = 0) in vec3 inVertex;    // Vertex.
 
-uniform mat4 View;            // Imports the View matrix.
-uniform mat4 Projection;    // Imports the projection matrix.
+layout (std140) uniform Frame {    // Data shared by every draw in the frame.
+    mat4 View;                      // The View matrix.
+    mat4 Projection;                // The projection matrix.
+    mat4 viewProjection;            // Projection * View.
+    vec4 lightColor;                // Light color.
+    vec3 lightPos;                  // Light position in view space.
+    float lightPower;               // The power that light has to light up the scene.
+    vec3 cameraPosition;            // Position of the camera.
+    float minAmbientLight;          // The minimum ambient that will control ambient light.
+};
 
 out vec3 texCoords;
 
@@ -13,7 +21,8 @@ void main() {
     texCoords = vec3(inVertex.x, inVertex.y, -inVertex.z);
     
     // Apply the transformations so that it moves with the camera.
-    vec4 newPosition = Projection * View * vec4(inVertex, 1.0f);
+    // Only the rotation of the View is used, as the skybox has no position.
+    vec4 newPosition = Projection * mat4(mat3(View)) * vec4(inVertex, 1.0f);
     
     // We have to make Z == W so that it's always in the back.
     gl_Position = vec4(newPosition.x, newPosition.y, newPosition.w, newPosition.w);
@@ -0,0 +1,41 @@
+/**
+ * @file arena_range.h
+ * @brief ArenaRange struct header file.
+ * @version 1.0.0 (2026-10-17)
+ * @date 2026-10-17
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#ifndef BGQ_OPENGL_STRUCT_ARENARANGE_H_
+#define BGQ_OPENGL_STRUCT_ARENARANGE_H_
+
+#include <cstddef>
+
+namespace bgq_opengl {
+
+	/**
+	 * @brief The place of a mesh in a geometry arena.
+	 *
+	 * This Struct holds the vertices and indices a mesh takes in the shared
+	 * buffers of a GeometryArena, counted in elements. The indices are relative
+	 * to the first vertex, which is passed to OpenGL as the base vertex.
+	 */
+	struct ArenaRange {
+
+		size_t first_vertex = 0;	/// First vertex in the vertex buffer.
+		size_t vertex_count = 0;	/// Number of vertices.
+		size_t first_index = 0;		/// First index in the index buffer.
+		size_t index_count = 0;		/// Number of indices.
+
+	};
+
+} // namespace bgq_opengl
+
+#endif //!BGQ_OPENGL_STRUCT_ARENARANGE_H_
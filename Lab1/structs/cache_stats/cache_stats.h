@@ -0,0 +1,36 @@
+/**
+ * @file cache_stats.h
+ * @brief CacheStats struct header file.
+ * @version 1.0.0 (2026-10-17)
+ * @date 2026-10-17
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#ifndef BGQ_OPENGL_STRUCT_CACHESTATS_H_
+#define BGQ_OPENGL_STRUCT_CACHESTATS_H_
+
+namespace bgq_opengl {
+
+	/**
+	 * @brief Counters of a cache.
+	 *
+	 * This Struct counts the requests a cache could answer with a resource it
+	 * already had and the ones that had to create it.
+	 */
+	struct CacheStats {
+
+		unsigned int hits = 0;		/// Requests answered with a live resource.
+		unsigned int misses = 0;	/// Requests that created the resource.
+
+	};
+
+} // namespace bgq_opengl
+
+#endif //!BGQ_OPENGL_STRUCT_CACHESTATS_H_
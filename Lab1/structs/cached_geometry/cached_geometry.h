@@ -0,0 +1,49 @@
+/**
+ * @file cached_geometry.h
+ * @brief CachedGeometry struct header file.
+ * @version 1.0.0 (2026-10-17)
+ * @date 2026-10-17
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#ifndef BGQ_OPENGL_STRUCT_CACHEDGEOMETRY_H_
+#define BGQ_OPENGL_STRUCT_CACHEDGEOMETRY_H_
+
+#include <span>
+
+#include "GL/glew.h"
+#include "glm/glm.hpp"
+
+#include "structs/bounding_box/bounding_box.h"
+#include "structs/mesh_lod/mesh_lod.h"
+#include "structs/vertex/vertex.h"
+
+namespace bgq_opengl {
+
+	/**
+	 * @brief A geometry as stored in the mesh cache.
+	 *
+	 * This Struct points to the data of one geometry of a model, without owning
+	 * it. When read from a cache the spans point into the mapped file.
+	 */
+	struct CachedGeometry {
+
+		std::span<const Vertex> vertices;	/// Vertices of the geometry.
+		std::span<const GLuint> indices;	/// Indices of the vertices, every level of detail one after the other.
+		std::span<const MeshLOD> lods;		/// Levels of detail in the indices. Empty if they are all the full mesh.
+		BoundingBox bounding_box;			/// Bounding box of the vertices.
+		float shininess = 0.0f;				/// Shininess of the material.
+		glm::vec3 color = glm::vec3(1.0f);	/// Diffuse color of the material.
+
+	};
+
+} // namespace bgq_opengl
+
+#endif //!BGQ_OPENGL_STRUCT_CACHEDGEOMETRY_H_
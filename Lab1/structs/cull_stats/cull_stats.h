@@ -0,0 +1,38 @@
+/**
+ * @file cull_stats.h
+ * @brief CullStats struct header file.
+ * @version 1.0.0 (2026-10-17)
+ * @date 2026-10-17
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#ifndef BGQ_OPENGL_STRUCT_CULLSTATS_H_
+#define BGQ_OPENGL_STRUCT_CULLSTATS_H_
+
+namespace bgq_opengl {
+
+	/**
+	 * @brief Counters of a frustum culling pass.
+	 *
+	 * This Struct counts the boxes tested against the frustum, both the ones of
+	 * the tree nodes and the ones of the geometries, and what became of the
+	 * geometries.
+	 */
+	struct CullStats {
+
+		unsigned int tested = 0;	/// Boxes tested against the planes.
+		unsigned int culled = 0;	/// Geometries left out.
+		unsigned int drawn = 0;		/// Geometries found visible.
+
+	};
+
+} // namespace bgq_opengl
+
+#endif //!BGQ_OPENGL_STRUCT_CULLSTATS_H_
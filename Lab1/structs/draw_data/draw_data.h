@@ -0,0 +1,45 @@
+/**
+ * @file draw_data.h
+ * @brief DrawData struct header file.
+ * @version 1.0.0 (2026-10-17)
+ * @date 2026-10-17
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#ifndef BGQ_OPENGL_STRUCT_DRAWDATA_H_
+#define BGQ_OPENGL_STRUCT_DRAWDATA_H_
+
+#include "GL/glew.h"
+#include "glm/glm.hpp"
+
+namespace bgq_opengl {
+
+	/**
+	 * @brief The data of a single draw.
+	 *
+	 * This Struct mirrors the std140 "Draw" uniform block of the shaders. One is
+	 * written per draw into a ring buffer, and the block is bound to its range.
+	 */
+	struct DrawData {
+
+		static const GLuint binding = 2;	/// Uniform buffer binding point of the block.
+
+		glm::mat4 model;					/// Model matrix.
+		glm::mat4 normal_matrix;			/// Normal matrix in world space.
+		glm::vec4 spin_pivot;				/// Point the instances spin around. w is unused.
+		glm::vec4 spin_axis;				/// Axis the instances spin around. w is unused.
+
+	};
+
+	static_assert(sizeof(DrawData) == 2 * 64 + 2 * 16, "DrawData must match the std140 layout of the Draw block.");
+
+} // namespace bgq_opengl
+
+#endif //!BGQ_OPENGL_STRUCT_DRAWDATA_H_
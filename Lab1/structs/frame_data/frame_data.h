@@ -0,0 +1,50 @@
+/**
+ * @file frame_data.h
+ * @brief FrameData struct header file.
+ * @version 1.0.0 (2026-10-17)
+ * @date 2026-10-17
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#ifndef BGQ_OPENGL_STRUCT_FRAMEDATA_H_
+#define BGQ_OPENGL_STRUCT_FRAMEDATA_H_
+
+#include "GL/glew.h"
+#include "glm/glm.hpp"
+
+namespace bgq_opengl {
+
+	/**
+	 * @brief The data shared by every draw in a frame.
+	 *
+	 * This Struct mirrors the std140 "Frame" uniform block of the shaders. It is
+	 * filled and uploaded once per frame. Every vec3 is followed by a float so
+	 * the members line up with the std140 offsets without padding.
+	 */
+	struct FrameData {
+
+		static const GLuint binding = 0;	/// Uniform buffer binding point of the block.
+
+		glm::mat4 view;						/// View matrix.
+		glm::mat4 projection;				/// Projection matrix.
+		glm::mat4 view_projection;			/// Projection * View.
+		glm::vec4 light_color;				/// Light color.
+		glm::vec3 light_position;			/// Light position in view space.
+		float light_power;					/// Power of the light.
+		glm::vec3 camera_position;			/// Camera position in world space.
+		float min_ambient_light;			/// Minimum ambient light.
+
+	};
+
+	static_assert(sizeof(FrameData) == 3 * 64 + 3 * 16, "FrameData must match the std140 layout of the Frame block.");
+
+} // namespace bgq_opengl
+
+#endif //!BGQ_OPENGL_STRUCT_FRAMEDATA_H_
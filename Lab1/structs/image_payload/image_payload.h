@@ -0,0 +1,44 @@
+/**
+ * @file image_payload.h
+ * @brief ImagePayload struct header file.
+ * @version 1.0.0 (2026-10-17)
+ * @date 2026-10-17
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#ifndef BGQ_OPENGL_STRUCT_IMAGEPAYLOAD_H_
+#define BGQ_OPENGL_STRUCT_IMAGEPAYLOAD_H_
+
+#include <memory>
+#include <vector>
+
+namespace bgq_opengl {
+
+	/**
+	 * @brief A decoded image waiting to be uploaded.
+	 *
+	 * This Struct holds the pixels of an image decoded on any thread, so the
+	 * thread owning the OpenGL context only has to upload them. Null pixels
+	 * mean the image could not be read. Images read from their cache also carry
+	 * their mipmaps, each level half the size of the one before.
+	 */
+	struct ImagePayload {
+
+		std::shared_ptr<unsigned char> pixels;	/// Decoded pixels, freed with the last copy.
+		int width = 0;							/// Width in pixels.
+		int height = 0;							/// Height in pixels.
+		int channels = 0;						/// Number of channels.
+		std::vector<std::shared_ptr<unsigned char>> mipmaps;	/// Levels after the first, if built already.
+
+	};
+
+} // namespace bgq_opengl
+
+#endif //!BGQ_OPENGL_STRUCT_IMAGEPAYLOAD_H_
@@ -0,0 +1,39 @@
+/**
+ * @file instance_data.h
+ * @brief InstanceData struct header file.
+ * @version 1.0.0 (2026-10-17)
+ * @date 2026-10-17
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#ifndef BGQ_OPENGL_STRUCT_INSTANCEDATA_H_
+#define BGQ_OPENGL_STRUCT_INSTANCEDATA_H_
+
+#include "glm/glm.hpp"
+
+namespace bgq_opengl {
+
+	/**
+	 * @brief The data of a single instance.
+	 *
+	 * This Struct holds what changes between the instances of a geometry drawn
+	 * with a single instanced call. It is read by the vertex shader from the
+	 * instance buffer, one element per instance.
+	 */
+	struct InstanceData {
+
+		glm::mat4 model = glm::mat4(1.0f);	/// Model matrix applied on top of the geometry one.
+		float phase = 0.0f;					/// Angle in degrees added to the spin of the geometry.
+
+	};
+
+} // namespace bgq_opengl
+
+#endif //!BGQ_OPENGL_STRUCT_INSTANCEDATA_H_
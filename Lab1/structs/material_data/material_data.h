@@ -0,0 +1,50 @@
+/**
+ * @file material_data.h
+ * @brief MaterialData struct header file.
+ * @version 1.0.0 (2026-10-17)
+ * @date 2026-10-17
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#ifndef BGQ_OPENGL_STRUCT_MATERIALDATA_H_
+#define BGQ_OPENGL_STRUCT_MATERIALDATA_H_
+
+#include "GL/glew.h"
+#include "glm/glm.hpp"
+
+namespace bgq_opengl {
+
+	/**
+	 * @brief The parameters of a material.
+	 *
+	 * This Struct mirrors the std140 "Material" uniform block of the shaders.
+	 * Each geometry keeps its own copy in a uniform buffer that is only uploaded
+	 * when it changes.
+	 */
+	struct MaterialData {
+
+		static const GLuint binding = 1;	/// Uniform buffer binding point of the block.
+
+		float eta_r = 1.0f;					/// Fresnel red ratio.
+		float eta_g = 1.0f;					/// Fresnel green ratio.
+		float eta_b = 1.0f;					/// Fresnel blue ratio.
+		float fresnel_power = 0.0f;			/// The fresnel interpolation step.
+		float mix_color = 0.0f;				/// The color/fresnel ratio.
+		float shininess = 0.0f;				/// Extra shininess.
+		float padding[2] = {0.0f, 0.0f};	/// Aligns the color to 16 bytes.
+		glm::vec4 color = glm::vec4(1.0f);	/// Diffuse color, applied over the vertex colors.
+
+	};
+
+	static_assert(sizeof(MaterialData) == 48, "MaterialData must match the std140 layout of the Material block.");
+
+} // namespace bgq_opengl
+
+#endif //!BGQ_OPENGL_STRUCT_MATERIALDATA_H_
@@ -0,0 +1,40 @@
+/**
+ * @file mesh_lod.h
+ * @brief MeshLOD struct header file.
+ * @version 1.0.0 (2026-10-17)
+ * @date 2026-10-17
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#ifndef BGQ_OPENGL_STRUCT_MESHLOD_H_
+#define BGQ_OPENGL_STRUCT_MESHLOD_H_
+
+#include <cstdint>
+
+namespace bgq_opengl {
+
+	/**
+	 * @brief A level of detail of a mesh.
+	 *
+	 * This Struct points to the indices of one level of detail of a mesh. Every
+	 * level uses the same vertices, so the levels are stored one after the other
+	 * in the index list of the mesh. It is stored as is in the mesh cache.
+	 */
+	struct MeshLOD {
+
+		uint32_t first_index = 0;	/// First index of the level in the index list.
+		uint32_t index_count = 0;	/// Number of indices of the level.
+		float error = 0.0f;			/// Distance to the full mesh, in model space.
+
+	};
+
+} // namespace bgq_opengl
+
+#endif //!BGQ_OPENGL_STRUCT_MESHLOD_H_
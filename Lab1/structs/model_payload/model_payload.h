@@ -0,0 +1,51 @@
+/**
+ * @file model_payload.h
+ * @brief ModelPayload struct header file.
+ * @version 1.0.0 (2026-10-17)
+ * @date 2026-10-17
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#ifndef BGQ_OPENGL_STRUCT_MODELPAYLOAD_H_
+#define BGQ_OPENGL_STRUCT_MODELPAYLOAD_H_
+
+#include <memory>
+#include <vector>
+
+#include "GL/glew.h"
+
+#include "classes/mesh_cache/mesh_cache.h"
+#include "structs/cached_geometry/cached_geometry.h"
+#include "structs/mesh_lod/mesh_lod.h"
+#include "structs/vertex/vertex.h"
+
+namespace bgq_opengl {
+
+	/**
+	 * @brief A parsed model waiting to be uploaded.
+	 *
+	 * This Struct holds the geometries of a model read on any thread, so the
+	 * thread owning the OpenGL context only has to upload them. The geometries
+	 * point either to the vectors below, when the model was imported, or to the
+	 * mapped cache, which is kept alive with them.
+	 */
+	struct ModelPayload {
+
+		std::vector<CachedGeometry> geometries;		/// Every geometry of the model.
+		std::vector<std::vector<Vertex>> vertices;	/// Vertices of each imported geometry.
+		std::vector<std::vector<GLuint>> indices;	/// Indices of each imported geometry.
+		std::vector<std::vector<MeshLOD>> lods;		/// Levels of detail of each imported geometry.
+		std::shared_ptr<MeshCache> cache;			/// The cache the geometries were read from, if any.
+
+	};
+
+} // namespace bgq_opengl
+
+#endif //!BGQ_OPENGL_STRUCT_MODELPAYLOAD_H_
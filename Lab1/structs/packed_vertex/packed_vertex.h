@@ -0,0 +1,44 @@
+/**
+ * @file packed_vertex.h
+ * @brief PackedVertex struct header file.
+ * @version 1.0.0 (2026-10-17)
+ * @date 2026-10-17
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#ifndef BGQ_OPENGL_STRUCT_PACKEDVERTEX_H_
+#define BGQ_OPENGL_STRUCT_PACKEDVERTEX_H_
+
+#include <cstdint>
+
+#include "glm/glm.hpp"
+
+namespace bgq_opengl {
+
+	/**
+	 * @brief A geometry vertex in its compact form.
+	 *
+	 * This Struct holds the same vertex as Vertex in 20 bytes instead of 44. The
+	 * normal is packed in 10 bits per axis, the UV coordinates are half floats and
+	 * the color is left to the material, as it is the same for the whole geometry.
+	 */
+	struct PackedVertex {
+
+		glm::vec3 position;		/// 3D coordinates of the vertex.
+		uint32_t normal;		/// Normal vector as signed normalized 10-10-10-2.
+		uint16_t uv[2];			/// UV coordinates as half floats.
+
+	};
+
+	static_assert(sizeof(PackedVertex) == 20, "PackedVertex must match the attributes linked for packed meshes.");
+
+} // namespace bgq_opengl
+
+#endif //!BGQ_OPENGL_STRUCT_PACKEDVERTEX_H_
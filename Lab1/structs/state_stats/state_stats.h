@@ -0,0 +1,41 @@
+/**
+ * @file state_stats.h
+ * @brief StateStats struct header file.
+ * @version 1.0.0 (2026-10-17)
+ * @date 2026-10-17
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#ifndef BGQ_OPENGL_STRUCT_STATESTATS_H_
+#define BGQ_OPENGL_STRUCT_STATESTATS_H_
+
+namespace bgq_opengl {
+
+	/**
+	 * @brief Counters of the OpenGL state changes.
+	 *
+	 * This Struct counts the state changes that were sent to OpenGL and the ones
+	 * that were skipped because the value was already set, along with the draw
+	 * calls and the triangles they drew. Values for inactive uniforms are counted
+	 * on their own.
+	 */
+	struct StateStats {
+
+		unsigned int issued = 0;	/// Calls that reached OpenGL.
+		unsigned int elided = 0;	/// Calls skipped because nothing changed.
+		unsigned int inactive = 0;	/// Uniform values skipped because the uniform is inactive.
+		unsigned int draws = 0;		/// Draw calls.
+		unsigned int triangles = 0;	/// Triangles drawn, instances included.
+
+	};
+
+} // namespace bgq_opengl
+
+#endif //!BGQ_OPENGL_STRUCT_STATESTATS_H_
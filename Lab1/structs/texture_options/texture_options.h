@@ -0,0 +1,40 @@
+/**
+ * @file texture_options.h
+ * @brief TextureOptions struct header file.
+ * @version 1.0.0 (2026-10-17)
+ * @date 2026-10-17
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#ifndef BGQ_OPENGL_STRUCT_TEXTUREOPTIONS_H_
+#define BGQ_OPENGL_STRUCT_TEXTUREOPTIONS_H_
+
+#include "GL/glew.h"
+
+namespace bgq_opengl {
+
+	/**
+	 * @brief How an image is turned into a texture.
+	 *
+	 * This Struct holds the options used to load an image and sample it. The
+	 * same image loaded with different options is a different texture.
+	 */
+	struct TextureOptions {
+
+		bool flip = true;								/// Flip the image vertically, as OpenGL starts at the bottom.
+		GLint min_filter = GL_NEAREST_MIPMAP_LINEAR;	/// Minifying filter.
+		GLint mag_filter = GL_NEAREST;					/// Magnifying filter.
+		GLint wrap = GL_REPEAT;							/// Wrapping on both axes.
+
+	};
+
+} // namespace bgq_opengl
+
+#endif //!BGQ_OPENGL_STRUCT_TEXTUREOPTIONS_H_
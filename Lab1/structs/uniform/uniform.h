@@ -0,0 +1,55 @@
+/**
+ * @file uniform.h
+ * @brief Uniform struct header file.
+ * @version 1.0.0 (2026-10-17)
+ * @date 2026-10-17
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#ifndef BGQ_OPENGL_STRUCT_UNIFORM_H_
+#define BGQ_OPENGL_STRUCT_UNIFORM_H_
+
+#include <cstddef>
+
+#include "GL/glew.h"
+
+namespace bgq_opengl {
+
+	/**
+	 * @brief A handle to a shader uniform.
+	 *
+	 * This Struct holds the location of a uniform in a shader program. The type
+	 * parameter is the C++ type the uniform takes, so a handle can only be passed
+	 * a value of the right type. A location of -1 means the uniform is not active
+	 * and passing values to it does nothing.
+	 */
+	template <typename T>
+	struct Uniform {
+
+		GLint location = -1;	/// Location of the uniform in the program.
+
+	};
+
+	/**
+	 * @brief The last value sent to a uniform.
+	 *
+	 * This Struct stores the raw bytes of the last value sent to a uniform, so
+	 * sending the same value again can be skipped. A size of 0 means unknown.
+	 */
+	struct UniformValue {
+
+		unsigned char data[16 * sizeof(float)];	/// Raw bytes of the value (up to a mat4).
+		size_t size = 0;						/// Number of valid bytes in data.
+
+	};
+
+} // namespace bgq_opengl
+
+#endif //!BGQ_OPENGL_STRUCT_UNIFORM_H_
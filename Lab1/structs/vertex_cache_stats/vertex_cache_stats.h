@@ -0,0 +1,40 @@
+/**
+ * @file vertex_cache_stats.h
+ * @brief VertexCacheStats struct header file.
+ * @version 1.0.0 (2026-10-17)
+ * @date 2026-10-17
+ * @author Borja García Quiroga <garcaqub@tcd.ie>
+ *
+ *
+ * Copyright (c) Borja García Quiroga, All Rights Reserved.
+ *
+ * The information and material provided below was developed as partial
+ * requirements for the MSc in Computer Science at Trinity College Dublin,
+ * Ireland.
+ */
+
+#ifndef BGQ_OPENGL_STRUCT_VERTEXCACHESTATS_H_
+#define BGQ_OPENGL_STRUCT_VERTEXCACHESTATS_H_
+
+#include <cstddef>
+
+namespace bgq_opengl {
+
+	/**
+	 * @brief Counters of a simulated post-transform vertex cache.
+	 *
+	 * This Struct counts how many vertices a GPU would have to shade to draw some
+	 * triangles. The ACMR is misses per triangle, from 0.5 at best to 3, and the
+	 * ATVR is misses per vertex, 1 at best.
+	 */
+	struct VertexCacheStats {
+
+		size_t triangles = 0;	/// Triangles drawn.
+		size_t vertices = 0;	/// Distinct vertices referenced.
+		size_t misses = 0;		/// Vertices that were not in the cache.
+
+	};
+
+} // namespace bgq_opengl
+
+#endif //!BGQ_OPENGL_STRUCT_VERTEXCACHESTATS_H_